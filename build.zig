@@ -14,6 +14,11 @@ pub fn build(b: *std.Build) !void {
         .imgui_include = b.option([]const u8, "imgui_include", "Path to imgui (need for imgui bgfx backend)"),
         .multithread = b.option(bool, "multithread", "Compile with BGFX_CONFIG_MULTITHREADED") orelse true,
         .with_shaderc = b.option(bool, "with_shaderc", "Compile with shaderc executable") orelse true,
+        .with_framereplay = b.option(bool, "with_framereplay", "Compile with framereplay executable") orelse false,
+        .with_bimg_encode = b.option(bool, "with_bimg_encode", "Compile with bimg_encode library") orelse false,
+        .frame_capture = b.option(bool, "frame_capture", "Compile with BGFX_CONFIG_FRAME_CAPTURE") orelse false,
+        .noop_walk_frame = b.option(bool, "noop_walk_frame", "Compile with BGFX_CONFIG_NOOP_WALK_FRAME") orelse false,
+        .memory_pool = b.option(bool, "memory_pool", "Compile with BGFX_CONFIG_MEMORY_POOL") orelse true,
         .shaderc_optimize = b.option(std.builtin.OptimizeMode, "shaderc_optimize", "Shaderc optimize mode") orelse .ReleaseFast,
     };
 
@@ -83,6 +88,7 @@ pub fn build(b: *std.Build) !void {
         .root_module = b.createModule(.{
             .target = target,
             .optimize = optimize,
+            .pic = true, // Also linked to shaderc dynamic library.
         }),
         .use_llvm = true,
         .use_lld = use_lld,
@@ -124,6 +130,42 @@ pub fn build(b: *std.Build) !void {
     bimgInclude(b, bimg);
     bimg.linkLibCpp();
 
+    //
+    // Bimg encode
+    // Texture encoders (BC, ETC, PVRTC, ASTC), cubemap filtering and image quality metrics.
+    //
+    var bimg_encode_lib: ?*std.Build.Step.Compile = null;
+    if (options.with_bimg_encode) {
+        const bimg_encode = b.addLibrary(.{
+            .linkage = .static,
+            .name = "bimg_encode",
+            .root_module = b.createModule(.{
+                .target = target,
+                .optimize = optimize,
+            }),
+            .use_llvm = true,
+            .use_lld = use_lld,
+        });
+        b.installArtifact(bimg_encode);
+
+        bimg_encode.addCSourceFiles(.{
+            .flags = &cxx_options,
+            .files = &bimg_encode_files,
+        });
+        bimg_encode.addCSourceFiles(.{
+            .flags = &c_options,
+            .files = &bimg_encode_c_files,
+        });
+        bxInclude(b, bimg_encode, target, optimize);
+        bimgInclude(b, bimg_encode);
+        bimg_encode.addIncludePath(b.path("libs/bimg/3rdparty/nvtt"));
+        bimg_encode.addIncludePath(b.path("libs/bimg/3rdparty/iqa/include"));
+        bimg_encode.linkLibrary(bimg);
+        bimg_encode.linkLibCpp();
+
+        bimg_encode_lib = bimg_encode;
+    }
+
     //
     // Bgfx
     //
@@ -147,7 +189,7 @@ pub fn build(b: *std.Build) !void {
     bgfx.linkLibrary(bx);
     bgfx.linkLibrary(bimg);
 
-    bgfx.root_module.addCMacro("BGFX_CONFIG_MULTITHREADED", if (options.multithread) "1" else "0");
+    bgfxConfig(bgfx, options);
 
     bgfx.addIncludePath(b.path("includes"));
 
@@ -198,6 +240,8 @@ pub fn build(b: *std.Build) !void {
         });
     }
 
+    const bgfx_bindings_module = b.createModule(.{ .root_source_file = b.path("libs/bgfx/bindings/zig/bgfx.zig") });
+
     const zbgfx_module = b.addModule(
         "zbgfx",
         .{
@@ -205,7 +249,7 @@ pub fn build(b: *std.Build) !void {
             .imports = &.{
                 .{
                     .name = "bgfx",
-                    .module = b.createModule(.{ .root_source_file = b.path("libs/bgfx/bindings/zig/bgfx.zig") }),
+                    .module = bgfx_bindings_module,
                 },
 
                 // .{
@@ -225,6 +269,118 @@ pub fn build(b: *std.Build) !void {
     );
     _ = zbgfx_module; // autofix
 
+    //
+    // Tests
+    // Runs on Noop renderer, no GPU or window needed.
+    //
+    const zbgfx_tests = b.addTest(.{
+        .root_module = b.createModule(.{
+            .root_source_file = b.path("src/zbgfx.zig"),
+            .target = target,
+            .optimize = optimize,
+            .imports = &.{
+                .{
+                    .name = "bgfx",
+                    .module = bgfx_bindings_module,
+                },
+            },
+        }),
+        .use_llvm = true,
+        .use_lld = use_lld,
+    });
+    zbgfx_tests.linkLibrary(bgfx);
+
+    const test_step = b.step("test", "Run zbgfx tests");
+    test_step.dependOn(&b.addRunArtifact(zbgfx_tests).step);
+
+    // C++ tests of bgfx and bimg internals that are not reachable through bindings.
+    const cpp_tests = b.addExecutable(.{
+        .name = "zbgfx_cpp_tests",
+        .root_module = b.createModule(.{
+            .target = target,
+            .optimize = optimize,
+        }),
+        .use_llvm = true,
+        .use_lld = use_lld,
+    });
+    cpp_tests.addCSourceFiles(.{
+        .flags = &cxx_options,
+        .files = &cpp_test_files,
+    });
+    testInclude(b, cpp_tests, target, optimize, options);
+    cpp_tests.linkLibrary(bgfx);
+    cpp_tests.linkLibCpp();
+
+    if (bimg_encode_lib) |bimg_encode| {
+        cpp_tests.addCSourceFiles(.{
+            .flags = &cxx_options,
+            .files = &cpp_encode_test_files,
+        });
+        cpp_tests.linkLibrary(bimg_encode);
+    }
+
+    test_step.dependOn(&b.addRunArtifact(cpp_tests).step);
+
+    //
+    // Benchmarks
+    // Runs on Noop renderer, use with `-Doptimize=ReleaseFast`. Pass benchmark name prefix after `--`
+    // to run only some of them.
+    //
+    const bench = b.addExecutable(.{
+        .name = "zbgfx_bench",
+        .root_module = b.createModule(.{
+            .target = target,
+            .optimize = optimize,
+        }),
+        .use_llvm = true,
+        .use_lld = use_lld,
+    });
+    bench.addCSourceFiles(.{
+        .flags = &cxx_options,
+        .files = &bench_files,
+    });
+    testInclude(b, bench, target, optimize, options);
+    bench.linkLibrary(bgfx);
+    bench.linkLibCpp();
+
+    const bench_run = b.addRunArtifact(bench);
+    if (b.args) |args| {
+        bench_run.addArgs(args);
+    }
+
+    const bench_step = b.step("bench", "Run zbgfx benchmarks");
+    bench_step.dependOn(&bench_run.step);
+
+    //
+    // Framereplay
+    // Replays frame captured with `frame_capture` option on Noop renderer.
+    //
+    if (options.with_framereplay) {
+        const framereplay = b.addExecutable(.{
+            .name = "framereplay",
+            .root_module = b.createModule(.{
+                .target = target,
+                .optimize = optimize,
+            }),
+            .use_llvm = true,
+            .use_lld = use_lld,
+        });
+        b.installArtifact(framereplay);
+
+        framereplay.linkLibrary(bgfx);
+        framereplay.linkLibCpp();
+
+        bxInclude(b, framereplay, target, optimize);
+        bgfxInclude(b, framereplay, target);
+
+        framereplay.addCSourceFiles(.{
+            .files = &[_][]const u8{
+                bgfx_path ++ "tools/framereplay/framereplay.cpp",
+            },
+            .flags = &cxx_options,
+        });
+    }
+
     //
     // Shaderc
     // Base steal from https://github.com/Interrupt/zig-bgfx-example/blob/main/build_shader_compiler.zig
@@ -265,45 +421,50 @@ pub fn build(b: *std.Build) !void {
         shaderc.linkLibCpp();
 
         bxInclude(b, shaderc, target, options.shaderc_optimize);
-
-        shaderc.addIncludePath(b.path("libs/bimg/include"));
-        shaderc.addIncludePath(b.path(bgfx_path ++ "include"));
-        shaderc.addIncludePath(b.path(bgfx_path ++ "src"));
-        shaderc.addIncludePath(b.path(bgfx_path ++ "3rdparty/directx-headers/include/directx"));
-        shaderc.addIncludePath(b.path(bgfx_path ++ "3rdparty/fcpp"));
-        shaderc.addIncludePath(b.path(bgfx_path ++ "3rdparty/glslang/glslang/Public"));
-        shaderc.addIncludePath(b.path(bgfx_path ++ "3rdparty/glslang/glslang/Include"));
-        shaderc.addIncludePath(b.path(bgfx_path ++ "3rdparty/glslang"));
-        shaderc.addIncludePath(b.path(bgfx_path ++ "3rdparty/glsl-optimizer/include"));
-        shaderc.addIncludePath(b.path(bgfx_path ++ "3rdparty/glsl-optimizer/src/glsl"));
-        shaderc.addIncludePath(b.path(bgfx_path ++ "3rdparty/spirv-cross"));
-        shaderc.addIncludePath(b.path(bgfx_path ++ "3rdparty/spirv-tools/include"));
-        shaderc.addIncludePath(b.path(bgfx_path ++ "3rdparty/webgpu/include"));
-
-        if (target.result.os.tag == .linux or target.result.os.tag.isDarwin()) {
-            shaderc.addIncludePath(b.path(bgfx_path ++ "3rdparty/d3d4linux/include"));
-            shaderc.addIncludePath(b.path(bgfx_path ++ "3rdparty/directx-headers/include"));
-            shaderc.addIncludePath(b.path(bgfx_path ++ "3rdparty/directx-headers/include/wsl/stubs"));
-        }
+        shadercInclude(b, shaderc, target);
 
         shaderc.addCSourceFiles(.{
-            .files = &.{
-                bgfx_path ++ "src/shader.cpp",
-                bgfx_path ++ "src/shader_dxbc.cpp",
-                bgfx_path ++ "src/shader_spirv.cpp",
-                bgfx_path ++ "src/vertexlayout.cpp",
-                bgfx_path ++ "tools/shaderc/shaderc.cpp",
-                bgfx_path ++ "tools/shaderc/shaderc_glsl.cpp",
-                bgfx_path ++ "tools/shaderc/shaderc_dxil.cpp",
-                bgfx_path ++ "tools/shaderc/shaderc_hlsl.cpp",
-                bgfx_path ++ "tools/shaderc/shaderc_metal.cpp",
-                bgfx_path ++ "tools/shaderc/shaderc_pssl.cpp",
-                bgfx_path ++ "tools/shaderc/shaderc_spirv.cpp",
-                bgfx_path ++ "tools/shaderc/shaderc_wgsl.cpp",
-            },
+            .files = &shaderc_files,
             .flags = &cxx_options,
         });
 
+        //
+        // Shaderc library
+        // Same as executable but without `main` and with C api (src/shaderc_lib.cpp) for in-process compile.
+        // Dynamic with hidden visibility so shaderc copy of `bgfx::` symbols do not clash with bgfx library,
+        // so all static libs linked to it are build with `.pic = true`.
+        //
+        const shaderc_lib = b.addLibrary(.{
+            .linkage = .dynamic,
+            .name = "zbgfx_shaderc",
+            .root_module = b.createModule(.{
+                .target = target,
+                .optimize = options.shaderc_optimize,
+                .strip = options.shaderc_optimize != .Debug,
+                .pic = true,
+            }),
+            .use_llvm = true,
+            .use_lld = use_lld,
+        });
+        b.installArtifact(shaderc_lib);
+
+        if (target.result.os.tag.isDarwin()) {
+            shaderc_lib.linkFramework("CoreFoundation");
+            shaderc_lib.linkFramework("Foundation");
+        }
+        shaderc_lib.linkLibrary(bx);
+        shaderc_lib.linkLibCpp();
+
+        bxInclude(b, shaderc_lib, target, options.shaderc_optimize);
+        shadercInclude(b, shaderc_lib, target);
+        shaderc_lib.addIncludePath(b.path("libs/bgfx/tools/shaderc"));
+        shaderc_lib.root_module.addCMacro("SHADERC_CONFIG_LIBRARY", "1");
+
+        shaderc_lib.addCSourceFiles(.{
+            .files = &(shaderc_files ++ [_][]const u8{"src/shaderc_lib.cpp"}),
+            .flags = &(cxx_options ++ [_][]const u8{"-fvisibility=hidden"}),
+        });
+
         //
         // fcpp
         //
@@ -328,6 +489,7 @@ pub fn build(b: *std.Build) !void {
                 .target = target,
                 .optimize = options.shaderc_optimize,
                 .strip = options.shaderc_optimize != .Debug,
+                .pic = true,
             }),
             .use_llvm = true,
             .use_lld = use_lld,
@@ -365,6 +527,7 @@ pub fn build(b: *std.Build) !void {
                 .target = target,
                 .optimize = options.shaderc_optimize,
                 .strip = options.shaderc_optimize != .Debug,
+                .pic = true,
             }),
             .use_llvm = true,
             .use_lld = use_lld,
@@ -402,6 +565,7 @@ pub fn build(b: *std.Build) !void {
                 .target = target,
                 .optimize = options.shaderc_optimize,
                 .strip = options.shaderc_optimize != .Debug,
+                .pic = true,
             }),
             .use_llvm = true,
             .use_lld = use_lld,
@@ -443,6 +607,7 @@ pub fn build(b: *std.Build) !void {
                 .target = target,
                 .optimize = options.shaderc_optimize,
                 .strip = options.shaderc_optimize != .Debug,
+                .pic = true,
             }),
             .use_llvm = true,
             .use_lld = use_lld,
@@ -516,6 +681,7 @@ pub fn build(b: *std.Build) !void {
                 .target = target,
                 .optimize = options.shaderc_optimize,
                 .strip = options.shaderc_optimize != .Debug,
+                .pic = true,
             }),
             .use_llvm = true,
             .use_lld = use_lld,
@@ -556,6 +722,55 @@ pub fn build(b: *std.Build) !void {
         shaderc.linkLibrary(glsl_optimizer_lib);
         shaderc.linkLibrary(spirv_opt_lib);
         shaderc.linkLibrary(spirv_cross_lib);
+
+        shaderc_lib.linkLibrary(fcpp_lib);
+        shaderc_lib.linkLibrary(glslang_lib);
+        shaderc_lib.linkLibrary(glsl_optimizer_lib);
+        shaderc_lib.linkLibrary(spirv_opt_lib);
+        shaderc_lib.linkLibrary(spirv_cross_lib);
+
+        //
+        // Shaderc library tests
+        //
+        const shaderc_tests = b.addTest(.{
+            .root_module = b.createModule(.{
+                .root_source_file = b.path("src/shaderc.zig"),
+                .target = target,
+                .optimize = optimize,
+                .imports = &.{
+                    .{
+                        .name = "bgfx",
+                        .module = bgfx_bindings_module,
+                    },
+                },
+            }),
+            .use_llvm = true,
+            .use_lld = use_lld,
+        });
+        shaderc_tests.linkLibrary(shaderc_lib);
+        test_step.dependOn(&b.addRunArtifact(shaderc_tests).step);
+    }
+}
+
+fn shadercInclude(b: *std.Build, step: *std.Build.Step.Compile, target: std.Build.ResolvedTarget) void {
+    step.addIncludePath(b.path("libs/bimg/include"));
+    step.addIncludePath(b.path("libs/bgfx/include"));
+    step.addIncludePath(b.path("libs/bgfx/src"));
+    step.addIncludePath(b.path("libs/bgfx/3rdparty/directx-headers/include/directx"));
+    step.addIncludePath(b.path("libs/bgfx/3rdparty/fcpp"));
+    step.addIncludePath(b.path("libs/bgfx/3rdparty/glslang/glslang/Public"));
+    step.addIncludePath(b.path("libs/bgfx/3rdparty/glslang/glslang/Include"));
+    step.addIncludePath(b.path("libs/bgfx/3rdparty/glslang"));
+    step.addIncludePath(b.path("libs/bgfx/3rdparty/glsl-optimizer/include"));
+    step.addIncludePath(b.path("libs/bgfx/3rdparty/glsl-optimizer/src/glsl"));
+    step.addIncludePath(b.path("libs/bgfx/3rdparty/spirv-cross"));
+    step.addIncludePath(b.path("libs/bgfx/3rdparty/spirv-tools/include"));
+    step.addIncludePath(b.path("libs/bgfx/3rdparty/webgpu/include"));
+
+    if (target.result.os.tag == .linux or target.result.os.tag.isDarwin()) {
+        step.addIncludePath(b.path("libs/bgfx/3rdparty/d3d4linux/include"));
+        step.addIncludePath(b.path("libs/bgfx/3rdparty/directx-headers/include"));
+        step.addIncludePath(b.path("libs/bgfx/3rdparty/directx-headers/include/wsl/stubs"));
     }
 }
 
@@ -583,6 +798,25 @@ fn bxInclude(b: *std.Build, step: *std.Build.Step.Compile, target: std.Build.Res
     step.addIncludePath(b.path("libs/bx/3rdparty"));
 }
 
+// Tests include bgfx private headers, config must match bgfx library.
+fn bgfxConfig(step: *std.Build.Step.Compile, options: anytype) void {
+    step.root_module.addCMacro("BGFX_CONFIG_MULTITHREADED", if (options.multithread) "1" else "0");
+    step.root_module.addCMacro("BGFX_CONFIG_FRAME_CAPTURE", if (options.frame_capture) "1" else "0");
+    step.root_module.addCMacro("BGFX_CONFIG_NOOP_WALK_FRAME", if (options.noop_walk_frame) "1" else "0");
+    step.root_module.addCMacro("BGFX_CONFIG_MEMORY_POOL", if (options.memory_pool) "1" else "0");
+}
+
+fn testInclude(b: *std.Build, step: *std.Build.Step.Compile, target: std.Build.ResolvedTarget, optimize: std.builtin.OptimizeMode, options: anytype) void {
+    bxInclude(b, step, target, optimize);
+    bimgInclude(b, step);
+    bgfxInclude(b, step, target);
+    bgfxConfig(step, options);
+    step.addIncludePath(b.path("libs/bgfx/src"));
+    step.addIncludePath(b.path("libs/bimg/src"));
+    step.addIncludePath(b.path("libs/bgfx/examples/common"));
+    step.addIncludePath(b.path("tests"));
+}
+
 fn bimgInclude(b: *std.Build, step: *std.Build.Step.Compile) void {
     step.addIncludePath(b.path("libs/bimg/include"));
     step.addIncludePath(b.path("libs/bimg/3rdparty"));
@@ -617,9 +851,48 @@ const spirv_opt_path = "libs/bgfx/3rdparty/spirv-tools/";
 // Many files
 //
 
+const cpp_test_files = [_][]const u8{
+    "tests/test.cpp",
+    "tests/image_convert_test.cpp",
+    "tests/image_decode_test.cpp",
+    "tests/memory_pool_test.cpp",
+    "tests/non_local_allocator_test.cpp",
+    "tests/transient_buffer_test.cpp",
+};
+
+// Tests of bimg_encode, built with `-Dwith_bimg_encode=true`.
+const cpp_encode_test_files = [_][]const u8{
+    "tests/image_cubemap_filter_test.cpp",
+};
+
+const bench_files = [_][]const u8{
+    "tests/bench.cpp",
+    "tests/debugdraw_bench.cpp",
+    "tests/memory_pool_bench.cpp",
+    "tests/non_local_allocator_bench.cpp",
+};
+
+const shaderc_files = [_][]const u8{
+    "libs/bgfx/src/shader.cpp",
+    "libs/bgfx/src/shader_dxbc.cpp",
+    "libs/bgfx/src/shader_spirv.cpp",
+    "libs/bgfx/src/vertexlayout.cpp",
+    "libs/bgfx/tools/shaderc/shaderc.cpp",
+    "libs/bgfx/tools/shaderc/shaderc_cache.cpp",
+    "libs/bgfx/tools/shaderc/shaderc_server.cpp",
+    "libs/bgfx/tools/shaderc/shaderc_glsl.cpp",
+    "libs/bgfx/tools/shaderc/shaderc_dxil.cpp",
+    "libs/bgfx/tools/shaderc/shaderc_hlsl.cpp",
+    "libs/bgfx/tools/shaderc/shaderc_metal.cpp",
+    "libs/bgfx/tools/shaderc/shaderc_pssl.cpp",
+    "libs/bgfx/tools/shaderc/shaderc_spirv.cpp",
+    "libs/bgfx/tools/shaderc/shaderc_wgsl.cpp",
+};
+
 const bimg_files = .{
     "libs/bimg/src/image.cpp",
     "libs/bimg/src/image_gnf.cpp",
+    "libs/bimg/src/job.cpp",
     "libs/bimg/3rdparty/astc-encoder/source/astcenc_averages_and_directions.cpp",
     "libs/bimg/3rdparty/astc-encoder/source/astcenc_block_sizes.cpp",
     "libs/bimg/3rdparty/astc-encoder/source/astcenc_color_quantize.cpp",
@@ -644,6 +917,55 @@ const bimg_files = .{
     "libs/bimg/3rdparty/astc-encoder/source/astcenc_weight_quant_xfer_tables.cpp",
 };
 
+const bimg_encode_files = .{
+    "libs/bimg/src/image_encode.cpp",
+    "libs/bimg/src/image_cubemap_filter.cpp",
+    "libs/bimg/3rdparty/edtaa3/edtaa3func.cpp",
+    "libs/bimg/3rdparty/etc1/etc1.cpp",
+    "libs/bimg/3rdparty/etc2/ProcessRGB.cpp",
+    "libs/bimg/3rdparty/etc2/Tables.cpp",
+    "libs/bimg/3rdparty/libsquish/alpha.cpp",
+    "libs/bimg/3rdparty/libsquish/clusterfit.cpp",
+    "libs/bimg/3rdparty/libsquish/colourblock.cpp",
+    "libs/bimg/3rdparty/libsquish/colourfit.cpp",
+    "libs/bimg/3rdparty/libsquish/colourset.cpp",
+    "libs/bimg/3rdparty/libsquish/maths.cpp",
+    "libs/bimg/3rdparty/libsquish/rangefit.cpp",
+    "libs/bimg/3rdparty/libsquish/singlecolourfit.cpp",
+    "libs/bimg/3rdparty/libsquish/squish.cpp",
+    "libs/bimg/3rdparty/nvtt/bc6h/zoh.cpp",
+    "libs/bimg/3rdparty/nvtt/bc6h/zoh_utils.cpp",
+    "libs/bimg/3rdparty/nvtt/bc6h/zohone.cpp",
+    "libs/bimg/3rdparty/nvtt/bc6h/zohtwo.cpp",
+    "libs/bimg/3rdparty/nvtt/bc7/avpcl.cpp",
+    "libs/bimg/3rdparty/nvtt/bc7/avpcl_mode0.cpp",
+    "libs/bimg/3rdparty/nvtt/bc7/avpcl_mode1.cpp",
+    "libs/bimg/3rdparty/nvtt/bc7/avpcl_mode2.cpp",
+    "libs/bimg/3rdparty/nvtt/bc7/avpcl_mode3.cpp",
+    "libs/bimg/3rdparty/nvtt/bc7/avpcl_mode4.cpp",
+    "libs/bimg/3rdparty/nvtt/bc7/avpcl_mode5.cpp",
+    "libs/bimg/3rdparty/nvtt/bc7/avpcl_mode6.cpp",
+    "libs/bimg/3rdparty/nvtt/bc7/avpcl_mode7.cpp",
+    "libs/bimg/3rdparty/nvtt/bc7/avpcl_utils.cpp",
+    "libs/bimg/3rdparty/nvtt/nvmath/fitting.cpp",
+    "libs/bimg/3rdparty/nvtt/nvtt.cpp",
+    "libs/bimg/3rdparty/pvrtc/BitScale.cpp",
+    "libs/bimg/3rdparty/pvrtc/MortonTable.cpp",
+    "libs/bimg/3rdparty/pvrtc/PvrTcDecoder.cpp",
+    "libs/bimg/3rdparty/pvrtc/PvrTcEncoder.cpp",
+    "libs/bimg/3rdparty/pvrtc/PvrTcPacket.cpp",
+};
+
+const bimg_encode_c_files = .{
+    "libs/bimg/3rdparty/iqa/source/convolve.c",
+    "libs/bimg/3rdparty/iqa/source/decimate.c",
+    "libs/bimg/3rdparty/iqa/source/math_utils.c",
+    "libs/bimg/3rdparty/iqa/source/ms_ssim.c",
+    "libs/bimg/3rdparty/iqa/source/mse.c",
+    "libs/bimg/3rdparty/iqa/source/psnr.c",
+    "libs/bimg/3rdparty/iqa/source/ssim.c",
+};
+
 const glsl_optimizer_files = .{
     glsl_optimizer_path ++ "src/glsl/ast_array_index.cpp",
     glsl_optimizer_path ++ "src/glsl/ast_expr.cpp",
@@ -59,9 +59,9 @@ pub fn main() anyerror!u8 {
     bgfx_init.platformData.ndt = null;
     bgfx_init.debug = true;
 
-    // TODO: read note in zbgfx.callbacks.ZigAllocator
-    //bgfx_alloc = zbgfx.callbacks.ZigAllocator.init(&_allocator);
-    //bgfx_init.allocator = &bgfx_alloc;
+    // Route bgfx allocations through zig allocator.
+    //bgfx_alloc = zbgfx.callbacks.ZigAllocator.init(std.heap.c_allocator);
+    //bgfx_init.allocator = bgfx_alloc.bgfxAllocator();
 
     bgfx_init.callback = &bgfx_clbs;
 
@@ -1566,6 +1566,7 @@ pub const Init = extern struct {
         maxTransientVbSize: u32,
         maxTransientIbSize: u32,
         minUniformBufferSize: u32,
+        maxDrawCalls: u32,
     };
 
         type: RendererType,
@@ -1575,6 +1576,7 @@ pub const Init = extern struct {
         debug: bool,
         profile: bool,
         fallback: bool,
+        parallelSort: bool,
         platformData: PlatformData,
         resolution: Resolution,
         limits: Limits,
@@ -1711,6 +1713,26 @@ pub const Init = extern struct {
         viewStats: [*c]ViewStats,
         numEncoders: u8,
         encoderStats: [*c]EncoderStats,
+        dynamicIbFree: u32,
+        dynamicIbFreeLargest: u32,
+        dynamicIbFreeBlocks: u32,
+        dynamicVbFree: u32,
+        dynamicVbFreeLargest: u32,
+        dynamicVbFreeBlocks: u32,
+        transientVbHighWater: u32,
+        transientIbHighWater: u32,
+        transientVbPages: u8,
+        transientIbPages: u8,
+        memoryPoolHeapAllocs: u32,
+        memoryPoolCached: u32,
+        frameArenaAllocs: u32,
+        frameArenaUsed: u32,
+        uniformBytesSaved: u32,
+        numStateChanges: u32,
+        numProgramChanges: u32,
+        numTextureChanges: u32,
+        numBufferChanges: u32,
+        numUniformUpdates: u32,
     };
 
     pub const VertexLayout = extern struct {
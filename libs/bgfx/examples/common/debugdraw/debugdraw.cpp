@@ -943,6 +943,13 @@ struct DebugDrawShared
 			, sizeof(s_cubeIndices)
 			);
 
+		// Keep CPU copy of shape meshes, batched shapes are transformed on CPU.
+		m_vertices = (DebugShapeVertex*)bx::alloc(m_allocator, vb->size);
+		bx::memCopy(m_vertices, vb->data, vb->size);
+
+		m_indices = (uint16_t*)bx::alloc(m_allocator, ib->size);
+		bx::memCopy(m_indices, ib->data, ib->size);
+
 		m_vbh = bgfx::createVertexBuffer(vb, DebugShapeVertex::ms_layout);
 		m_ibh = bgfx::createIndexBuffer(ib);
 	}
@@ -951,6 +958,8 @@ struct DebugDrawShared
 	{
 		bgfx::destroy(m_ibh);
 		bgfx::destroy(m_vbh);
+		bx::free(m_allocator, m_vertices);
+		bx::free(m_allocator, m_indices);
 		for (uint32_t ii = 0; ii < Program::Count; ++ii)
 		{
 			bgfx::destroy(m_program[ii]);
@@ -1011,6 +1020,9 @@ struct DebugDrawShared
 
 	bgfx::VertexBufferHandle m_vbh;
 	bgfx::IndexBufferHandle  m_ibh;
+
+	DebugShapeVertex* m_vertices;
+	uint16_t*         m_indices;
 };
 
 static DebugDrawShared s_dds;
@@ -1048,6 +1060,10 @@ struct DebugDrawEncoderImpl
 		m_indexPos  = 0;
 		m_vertexPos = 0;
 		m_posQuad   = 0;
+		m_posMesh   = 0;
+
+		m_meshNumVertices = 0;
+		m_meshNumIndices  = 0;
 
 		Attrib& attrib = m_attrib[0];
 		attrib.m_state = 0
@@ -1073,6 +1089,7 @@ struct DebugDrawEncoderImpl
 		BX_ASSERT(0 == m_stack, "Invalid stack %d.", m_stack);
 
 		flushQuad();
+		flushMesh();
 		flush();
 
 		m_encoder = NULL;
@@ -1115,13 +1132,9 @@ struct DebugDrawEncoderImpl
 		}
 	}
 
-	void setTransform(const void* _mtx, uint16_t _num = 1, bool _flush = true)
+	void setTransform(const void* _mtx, uint16_t _num = 1)
 	{
 		BX_ASSERT(State::Count != m_state, "");
-		if (_flush)
-		{
-			flush();
-		}
 
 		MatrixStack& stack = m_mtxStack[m_mtxStackCurrent];
 
@@ -1150,46 +1163,48 @@ struct DebugDrawEncoderImpl
 		setTranslate(_pos[0], _pos[1], _pos[2]);
 	}
 
-	void pushTransform(const void* _mtx, uint16_t _num, bool _flush = true)
+	void pushTransform(const void* _mtx, uint16_t _num)
 	{
 		BX_ASSERT(m_mtxStackCurrent < BX_COUNTOF(m_mtxStack), "Out of matrix stack!");
 		BX_ASSERT(State::Count != m_state, "");
-		if (_flush)
-		{
-			flush();
-		}
 
-		float* mtx = NULL;
+		float* mtx = (float*)BX_STACK_ALLOC(_num*64);
+		concatTransform(mtx, (const float*)_mtx, _num);
+
+		m_mtxStackCurrent++;
+		setTransform(mtx, _num);
+	}
+
+	void popTransform()
+	{
+		BX_ASSERT(State::Count != m_state, "");
+		m_mtxStackCurrent--;
+	}
 
+	void concatTransform(float* _result, const float* _mtx, uint16_t _num) const
+	{
 		const MatrixStack& stack = m_mtxStack[m_mtxStackCurrent];
 
 		if (NULL == stack.data)
 		{
-			mtx = (float*)_mtx;
+			bx::memCopy(_result, _mtx, _num*64);
 		}
 		else
 		{
-			mtx = (float*)BX_STACK_ALLOC(_num*64);
 			for (uint16_t ii = 0; ii < _num; ++ii)
 			{
-				const float* mtxTransform = (const float*)_mtx;
-				bx::mtxMul(&mtx[ii*16], &mtxTransform[ii*16], stack.data);
+				bx::mtxMul(&_result[ii*16], &_mtx[ii*16], stack.data);
 			}
 		}
-
-		m_mtxStackCurrent++;
-		setTransform(mtx, _num, _flush);
 	}
 
-	void popTransform(bool _flush = true)
+	bx::Vec3 toWorld(const bx::Vec3& _pos) const
 	{
-		BX_ASSERT(State::Count != m_state, "");
-		if (_flush)
-		{
-			flush();
-		}
-
-		m_mtxStackCurrent--;
+		const MatrixStack& stack = m_mtxStack[m_mtxStackCurrent];
+		return NULL == stack.data
+			? _pos
+			: bx::mul(_pos, stack.data)
+			;
 	}
 
 	void pushTranslate(float _x, float _y, float _z)
@@ -1284,15 +1299,18 @@ struct DebugDrawEncoderImpl
 	void moveTo(float _x, float _y, float _z = 0.0f)
 	{
 		BX_ASSERT(State::Count != m_state, "");
+		moveToWorld(toWorld({_x, _y, _z}) );
+	}
 
+	// Lines are stored already transformed, transform changes don't break line batch.
+	void moveToWorld(const bx::Vec3& _pos)
+	{
 		softFlush();
 
 		m_state = State::MoveTo;
 
 		DebugVertex& vertex = m_cache[m_pos];
-		vertex.m_x = _x;
-		vertex.m_y = _y;
-		vertex.m_z = _z;
+		bx::store(&vertex.m_x, _pos);
 
 		Attrib& attrib = m_attrib[m_stack];
 		vertex.m_abgr = attrib.m_abgr;
@@ -1315,9 +1333,14 @@ struct DebugDrawEncoderImpl
 	void lineTo(float _x, float _y, float _z = 0.0f)
 	{
 		BX_ASSERT(State::Count != m_state, "");
+		lineToWorld(toWorld({_x, _y, _z}) );
+	}
+
+	void lineToWorld(const bx::Vec3& _pos)
+	{
 		if (State::None == m_state)
 		{
-			moveTo(_x, _y, _z);
+			moveToWorld(_pos);
 			return;
 		}
 
@@ -1350,9 +1373,7 @@ struct DebugDrawEncoderImpl
 		uint16_t prev = m_pos-1;
 		uint16_t curr = m_pos++;
 		DebugVertex& vertex = m_cache[curr];
-		vertex.m_x = _x;
-		vertex.m_y = _y;
-		vertex.m_z = _z;
+		bx::store(&vertex.m_x, _pos);
 
 		Attrib& attrib = m_attrib[m_stack];
 		vertex.m_abgr = attrib.m_abgr;
@@ -1380,7 +1401,7 @@ struct DebugDrawEncoderImpl
 	{
 		BX_ASSERT(State::Count != m_state, "");
 		DebugVertex& vertex = m_cache[m_vertexPos];
-		lineTo(vertex.m_x, vertex.m_y, vertex.m_z);
+		lineToWorld(bx::load<bx::Vec3>(&vertex.m_x) );
 
 		m_state = State::None;
 	}
@@ -1516,29 +1537,35 @@ struct DebugDrawEncoderImpl
 		}
 	}
 
-	void setUParams(const Attrib& _attrib, bool _wireframe)
+	static bx::Vec3 getLightDir(const Attrib& _attrib)
 	{
 		const float flip = 0 == (_attrib.m_state & BGFX_STATE_CULL_CCW) ? 1.0f : -1.0f;
+		return { 0.0f, -flip, 0.0f };
+	}
+
+	void setUParams(const Attrib& _attrib, bool _wireframe)
+	{
+		const bx::Vec3 lightDir = getLightDir(_attrib);
 		const uint8_t alpha = _attrib.m_abgr >> 24;
 
 		float params[4][4] =
 		{
 			{ // lightDir
-				 0.0f * flip,
-				-1.0f * flip,
-				 0.0f * flip,
-				 3.0f, // shininess
+				lightDir.x,
+				lightDir.y,
+				lightDir.z,
+				3.0f, // shininess
 			},
 			{ // skyColor
-				1.0f,
-				0.9f,
-				0.8f,
+				kSkyColor[0],
+				kSkyColor[1],
+				kSkyColor[2],
 				0.0f, // unused
 			},
 			{ // groundColor.xyz0
-				0.2f,
-				0.22f,
-				0.5f,
+				kGroundColor[0],
+				kGroundColor[1],
+				kGroundColor[2],
 				0.0f, // unused
 			},
 			{ // matColor
@@ -1549,14 +1576,40 @@ struct DebugDrawEncoderImpl
 			},
 		};
 
-		bx::store(params[0], bx::normalize(bx::load<bx::Vec3>(params[0]) ) );
 		m_encoder->setUniform(s_dds.u_params, params, 4);
 
-		m_encoder->setState(0
+		m_encoder->setState(getShapeState(_attrib, _wireframe) );
+	}
+
+	static uint64_t getShapeState(const Attrib& _attrib, bool _wireframe)
+	{
+		const uint8_t alpha = _attrib.m_abgr >> 24;
+
+		return 0
 			| _attrib.m_state
 			| (_wireframe ? BGFX_STATE_PT_LINES | BGFX_STATE_LINEAA | BGFX_STATE_BLEND_ALPHA
 			: (alpha < 0xff) ? BGFX_STATE_BLEND_ALPHA : 0)
-			);
+			;
+	}
+
+	// Same lighting as fs_debugdraw_fill_lit, with normal of triangle instead of screen space
+	// derivatives.
+	static uint32_t getLitColor(uint32_t _abgr, const bx::Vec3& _lightDir, const bx::Vec3& _v0, const bx::Vec3& _v1, const bx::Vec3& _v2)
+	{
+		const bx::Vec3 normal = bx::cross(bx::sub(_v1, _v0), bx::sub(_v2, _v0) );
+		const float len   = bx::length(normal);
+		const float ndotl = 0.0f < len ? bx::dot(normal, _lightDir)/len : 0.0f;
+		const float tt    = ndotl*0.5f + 0.5f;
+
+		uint32_t abgr = _abgr & 0xff000000;
+
+		for (uint32_t ii = 0; ii < 3; ++ii)
+		{
+			const float color = float( (_abgr >> (ii*8) ) & 0xff) * bx::lerp(kGroundColor[ii], kSkyColor[ii], tt);
+			abgr |= uint32_t(color + 0.5f) << (ii*8);
+		}
+
+		return abgr;
 	}
 
 	void draw(GeometryHandle _handle)
@@ -2115,8 +2168,53 @@ struct DebugDrawEncoderImpl
 
 	void draw(DebugMesh::Enum _mesh, const float* _mtx, uint16_t _num, bool _wireframe)
 	{
-		pushTransform(_mtx, _num, false /* flush */);
+		const DebugMesh& mesh = s_dds.m_mesh[_mesh];
+		const Attrib& attrib = m_attrib[m_stack];
+
+		// Color is stored in vertices, only state changes break batch. Solid shapes are lit on CPU,
+		// each triangle gets its own vertices.
+		const uint32_t numVertices = _wireframe ? mesh.m_numVertices : mesh.m_numIndices[0];
 
+		// Transforming large meshes on CPU costs more than draw call it saves.
+		if (kMeshBatchMaxVertices < numVertices
+		||  0 == mesh.m_numIndices[_wireframe])
+		{
+			float mtx[2*16];
+			concatTransform(mtx, _mtx, _num);
+			submit(attrib, _mesh, mtx, _num, _wireframe);
+			return;
+		}
+
+		const uint64_t state = getShapeState(attrib, _wireframe);
+
+		if (0 != m_posMesh
+		&& (m_posMesh == BX_COUNTOF(m_cacheMesh)
+		||  UINT16_MAX < m_meshNumVertices + numVertices
+		||  m_meshWireframe != _wireframe
+		||  m_meshState     != state) )
+		{
+			flushMesh();
+		}
+
+		if (0 == m_posMesh)
+		{
+			m_meshAttrib    = attrib;
+			m_meshState     = state;
+			m_meshWireframe = _wireframe;
+		}
+
+		MeshInstance& instance = m_cacheMesh[m_posMesh++];
+		instance.m_abgr = attrib.m_abgr;
+		instance.m_mesh = uint8_t(_mesh);
+		instance.m_num  = uint8_t(_num);
+		concatTransform(instance.m_mtx, _mtx, _num);
+
+		m_meshNumVertices += numVertices;
+		m_meshNumIndices  += _wireframe ? mesh.m_numIndices[1] : 0;
+	}
+
+	void submit(const Attrib& _attrib, DebugMesh::Enum _mesh, const float* _mtx, uint16_t _num, bool _wireframe)
+	{
 		const DebugMesh& mesh = s_dds.m_mesh[_mesh];
 
 		if (0 != mesh.m_numIndices[_wireframe])
@@ -2127,16 +2225,12 @@ struct DebugDrawEncoderImpl
 				);
 		}
 
-		const Attrib& attrib = m_attrib[m_stack];
-		setUParams(attrib, _wireframe);
+		setUParams(_attrib, _wireframe);
 
-		MatrixStack& stack = m_mtxStack[m_mtxStackCurrent];
-		m_encoder->setTransform(stack.mtx, stack.num);
+		m_encoder->setTransform(_mtx, _num);
 
 		m_encoder->setVertexBuffer(0, s_dds.m_vbh, mesh.m_startVertex, mesh.m_numVertices);
 		m_encoder->submit(m_viewId, s_dds.m_program[_wireframe ? Program::Fill : Program::FillLit]);
-
-		popTransform(false /* flush */);
 	}
 
 	void softFlush()
@@ -2172,7 +2266,6 @@ struct DebugDrawEncoderImpl
 					| BGFX_STATE_LINEAA
 					| BGFX_STATE_BLEND_ALPHA
 					);
-				m_encoder->setTransform(m_mtxStack[m_mtxStackCurrent].mtx);
 				bgfx::ProgramHandle program = s_dds.m_program[attrib.m_stipple ? 1 : 0];
 				m_encoder->submit(m_viewId, program);
 			}
@@ -2184,6 +2277,113 @@ struct DebugDrawEncoderImpl
 		}
 	}
 
+	static bx::Vec3 getMeshVertex(const float* _mtx, const DebugShapeVertex& _vertex)
+	{
+		return bx::mul(bx::Vec3{_vertex.m_x, _vertex.m_y, _vertex.m_z}, &_mtx[_vertex.m_indices[0]*16]);
+	}
+
+	static void setMeshVertex(DebugVertex& _vertex, const bx::Vec3& _pos, uint32_t _abgr)
+	{
+		bx::store(&_vertex.m_x, _pos);
+		_vertex.m_len  = 0.0f;
+		_vertex.m_abgr = _abgr;
+	}
+
+	void flushMesh()
+	{
+		if (0 != m_posMesh)
+		{
+			if (checkAvailTransientBuffers(m_meshNumVertices, DebugVertex::ms_layout, m_meshNumIndices) )
+			{
+				bgfx::TransientVertexBuffer tvb;
+				bgfx::allocTransientVertexBuffer(&tvb, m_meshNumVertices, DebugVertex::ms_layout);
+
+				bgfx::TransientIndexBuffer tib;
+				uint16_t* indices = NULL;
+
+				if (m_meshWireframe)
+				{
+					bgfx::allocTransientIndexBuffer(&tib, m_meshNumIndices);
+					indices = (uint16_t*)tib.data;
+				}
+
+				DebugVertex* vertices = (DebugVertex*)tvb.data;
+				uint16_t startVertex = 0;
+
+				bx::Vec3* pos = (bx::Vec3*)BX_STACK_ALLOC(kMeshBatchMaxVertices*sizeof(bx::Vec3) );
+				const bx::Vec3 lightDir = getLightDir(m_meshAttrib);
+
+				for (uint16_t ii = 0; ii < m_posMesh; ++ii)
+				{
+					const MeshInstance& instance = m_cacheMesh[ii];
+					const DebugMesh& mesh = s_dds.m_mesh[instance.m_mesh];
+
+					const DebugShapeVertex* src = &s_dds.m_vertices[mesh.m_startVertex];
+					const uint16_t* srcIndices  = &s_dds.m_indices[mesh.m_startIndex[m_meshWireframe] ];
+
+					for (uint32_t jj = 0, num = mesh.m_numVertices; jj < num; ++jj)
+					{
+						pos[jj] = getMeshVertex(instance.m_mtx, src[jj]);
+					}
+
+					if (m_meshWireframe)
+					{
+						for (uint32_t jj = 0, num = mesh.m_numVertices; jj < num; ++jj)
+						{
+							setMeshVertex(*vertices++, pos[jj], instance.m_abgr);
+						}
+
+						for (uint32_t jj = 0, num = mesh.m_numIndices[1]; jj < num; ++jj)
+						{
+							*indices++ = startVertex + srcIndices[jj];
+						}
+
+						startVertex += uint16_t(mesh.m_numVertices);
+					}
+					else
+					{
+						for (uint32_t jj = 0, num = mesh.m_numIndices[0]; jj < num; jj += 3)
+						{
+							const bx::Vec3& v0 = pos[srcIndices[jj+0] ];
+							const bx::Vec3& v1 = pos[srcIndices[jj+1] ];
+							const bx::Vec3& v2 = pos[srcIndices[jj+2] ];
+							const uint32_t abgr = getLitColor(instance.m_abgr, lightDir, v0, v1, v2);
+
+							setMeshVertex(*vertices++, v0, abgr);
+							setMeshVertex(*vertices++, v1, abgr);
+							setMeshVertex(*vertices++, v2, abgr);
+						}
+					}
+				}
+
+				m_encoder->setVertexBuffer(0, &tvb);
+
+				if (m_meshWireframe)
+				{
+					m_encoder->setIndexBuffer(&tib);
+				}
+
+				m_encoder->setState(m_meshState);
+				m_encoder->submit(m_viewId, s_dds.m_program[Program::Lines]);
+			}
+			else
+			{
+				for (uint16_t ii = 0; ii < m_posMesh; ++ii)
+				{
+					const MeshInstance& instance = m_cacheMesh[ii];
+
+					Attrib attrib = m_meshAttrib;
+					attrib.m_abgr = instance.m_abgr;
+					submit(attrib, DebugMesh::Enum(instance.m_mesh), instance.m_mtx, instance.m_num, m_meshWireframe);
+				}
+			}
+
+			m_posMesh         = 0;
+			m_meshNumVertices = 0;
+			m_meshNumIndices  = 0;
+		}
+	}
+
 	void flushQuad()
 	{
 		if (0 != m_posQuad)
@@ -2238,19 +2438,38 @@ struct DebugDrawEncoderImpl
 		};
 	};
 
+	struct MeshInstance
+	{
+		float    m_mtx[2*16];
+		uint32_t m_abgr;
+		uint8_t  m_mesh;
+		uint8_t  m_num;
+	};
+
 	static const uint32_t kCacheSize = 1024;
 	static const uint32_t kStackSize = 16;
 	static const uint32_t kCacheQuadSize = 1024;
+	static const uint32_t kCacheMeshSize = 64;
+	static const uint32_t kMeshBatchMaxVertices = 128;
+	static constexpr float kSkyColor[3]    = { 1.0f, 0.9f,  0.8f };
+	static constexpr float kGroundColor[3] = { 0.2f, 0.22f, 0.5f };
 	static_assert(kCacheSize >= 3, "Cache must be at least 3 elements.");
 
 	DebugVertex   m_cache[kCacheSize+1];
 	DebugUvVertex m_cacheQuad[kCacheQuadSize];
+	MeshInstance  m_cacheMesh[kCacheMeshSize];
 	uint16_t m_indices[kCacheSize*2];
 	uint16_t m_pos;
 	uint16_t m_posQuad;
+	uint16_t m_posMesh;
 	uint16_t m_indexPos;
 	uint16_t m_vertexPos;
 	uint32_t m_mtxStackCurrent;
+	uint32_t m_meshNumVertices;
+	uint32_t m_meshNumIndices;
+	uint64_t m_meshState;
+	Attrib   m_meshAttrib;
+	bool     m_meshWireframe;
 
 	struct MatrixStack
 	{
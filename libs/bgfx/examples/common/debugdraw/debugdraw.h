@@ -195,7 +195,7 @@ struct DebugDrawEncoder
 	///
 	void drawOrb(float _x, float _y, float _z, float _radius, Axis::Enum _highlight = Axis::Count);
 
-	BX_ALIGN_DECL_CACHE_LINE(uint8_t) m_internal[50<<10];
+	BX_ALIGN_DECL_CACHE_LINE(uint8_t) m_internal[60<<10];
 };
 
 ///
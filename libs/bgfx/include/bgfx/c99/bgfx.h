@@ -580,8 +580,8 @@ typedef struct bgfx_caps_limits_s
     uint32_t             maxOcclusionQueries; /** Maximum number of occlusion query handles. */
     uint32_t             maxEncoders;        /** Maximum number of encoder threads.       */
     uint32_t             minResourceCbSize;  /** Minimum resource command buffer size.    */
-    uint32_t             maxTransientVbSize; /** Maximum transient vertex buffer size.    */
-    uint32_t             maxTransientIbSize; /** Maximum transient index buffer size.     */
+    uint32_t             maxTransientVbSize; /** Transient vertex buffer page size.       */
+    uint32_t             maxTransientIbSize; /** Transient index buffer page size.        */
     uint32_t             minUniformBufferSize; /** Mimimum uniform buffer size.             */
 
 } bgfx_caps_limits_t;
@@ -709,9 +709,10 @@ typedef struct bgfx_init_limits_s
 {
     uint16_t             maxEncoders;        /** Maximum number of encoder threads.       */
     uint32_t             minResourceCbSize;  /** Minimum resource command buffer size.    */
-    uint32_t             maxTransientVbSize; /** Maximum transient vertex buffer size.    */
-    uint32_t             maxTransientIbSize; /** Maximum transient index buffer size.     */
+    uint32_t             maxTransientVbSize; /** Transient vertex buffer page size.       */
+    uint32_t             maxTransientIbSize; /** Transient index buffer page size.        */
     uint32_t             minUniformBufferSize; /** Mimimum uniform buffer size.             */
+    uint32_t             maxDrawCalls;       /** Maximum number of draw calls per frame.  */
 
 } bgfx_init_limits_t;
 
@@ -751,6 +752,7 @@ typedef struct bgfx_init_s
     bool                 debug;              /** Enable device for debugging.             */
     bool                 profile;            /** Enable device for profiling.             */
     bool                 fallback;           /** Enable fallback to next available renderer. */
+    bool                 parallelSort;       /** Sort draw keys per encoder, render thread only merges runs. */
     bgfx_platform_data_t platformData;       /** Platform data.                           */
     bgfx_resolution_t    resolution;         /** Backbuffer resolution and reset parameters. See: `bgfx::Resolution`. */
     bgfx_init_limits_t   limits;             /** Configurable runtime limits parameters.  */
@@ -959,6 +961,26 @@ typedef struct bgfx_stats_s
     bgfx_view_stats_t*   viewStats;          /** Array of View stats.                     */
     uint8_t              numEncoders;        /** Number of encoders used during frame.    */
     bgfx_encoder_stats_t* encoderStats;      /** Array of encoder stats.                  */
+    uint32_t             dynamicIbFree;      /** Free bytes in dynamic index buffer pool. */
+    uint32_t             dynamicIbFreeLargest; /** Largest free block in dynamic index buffer pool. */
+    uint32_t             dynamicIbFreeBlocks; /** Number of free blocks in dynamic index buffer pool. */
+    uint32_t             dynamicVbFree;      /** Free bytes in dynamic vertex buffer pool. */
+    uint32_t             dynamicVbFreeLargest; /** Largest free block in dynamic vertex buffer pool. */
+    uint32_t             dynamicVbFreeBlocks; /** Number of free blocks in dynamic vertex buffer pool. */
+    uint32_t             transientVbHighWater; /** Peak transient vertex buffer used since last trim. */
+    uint32_t             transientIbHighWater; /** Peak transient index buffer used since last trim. */
+    uint8_t              transientVbPages;   /** Number of allocated transient vertex buffer pages. */
+    uint8_t              transientIbPages;   /** Number of allocated transient index buffer pages. */
+    uint32_t             memoryPoolHeapAllocs; /** Number of memory blocks allocated from heap, instead of reused from pool. */
+    uint32_t             memoryPoolCached;   /** Free bytes kept in memory block pool and per-thread caches. */
+    uint32_t             frameArenaAllocs;   /** Number of render thread scratch allocations served by frame arena. */
+    uint32_t             frameArenaUsed;     /** Frame arena bytes used during frame.     */
+    uint32_t             uniformBytesSaved;  /** Uniform bytes not encoded because draw set same values as previous draw. */
+    uint32_t             numStateChanges;    /** Number of draws that changed render state. Reported only by Noop renderer built with BGFX_CONFIG_NOOP_WALK_FRAME. */
+    uint32_t             numProgramChanges;  /** Number of program changes.               */
+    uint32_t             numTextureChanges;  /** Number of texture, image and storage buffer binding changes. */
+    uint32_t             numBufferChanges;   /** Number of vertex, instance and index buffer binding changes. */
+    uint32_t             numUniformUpdates;  /** Number of uniform buffer ranges decoded. */
 
 } bgfx_stats_t;
 
@@ -6,6 +6,7 @@
 #include "bgfx.cpp"
 #include "debug_renderdoc.cpp"
 #include "dxgi.cpp"
+#include "frame_capture.cpp"
 #include "glcontext_egl.cpp"
 #include "glcontext_wgl.cpp"
 #include "glcontext_html5.cpp"
@@ -10,6 +10,7 @@
 #include <bx/file.h>
 #include <bx/mutex.h>
 
+#include "frame_capture.h"
 #include "topology.h"
 
 #if BX_PLATFORM_OSX || BX_PLATFORM_IOS || BX_PLATFORM_VISIONOS
@@ -391,6 +392,7 @@ namespace bgfx
 
 #if BGFX_CONFIG_MULTITHREADED
 	static BX_THREAD_LOCAL uint32_t s_threadIndex(0);
+	static BX_THREAD_LOCAL EncoderImpl* s_threadEncoder(NULL);
 #else
 	static uint32_t s_threadIndex(0);
 #endif // BGFX_CONFIG_MULTITHREADED
@@ -1348,8 +1350,8 @@ namespace bgfx
 			return;
 		}
 
-		const uint32_t renderItemIdx = bx::atomicFetchAndAddsat<uint32_t>(&m_frame->m_numRenderItems, 1, BGFX_CONFIG_MAX_DRAW_CALLS);
-		if (BGFX_CONFIG_MAX_DRAW_CALLS <= renderItemIdx)
+		const uint32_t renderItemIdx = allocRenderItem();
+		if (UINT32_MAX == renderItemIdx)
 		{
 			discard(_flags);
 			++m_numDropped;
@@ -1361,6 +1363,11 @@ namespace bgfx
 		UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
 		m_uniformEnd = uniformBuffer->getPos();
 
+		if (BX_ENABLED(BGFX_CONFIG_UNIFORM_DEDUP) )
+		{
+			dedupUniforms(uniformBuffer);
+		}
+
 		m_key.m_program = isValid(_program)
 			? _program
 			: ProgramHandle{0}
@@ -1379,8 +1386,17 @@ namespace bgfx
 
 		uint64_t key = m_key.encodeDraw(type);
 
-		m_frame->m_sortKeys[renderItemIdx]   = key;
-		m_frame->m_sortValues[renderItemIdx] = RenderItemCount(renderItemIdx);
+		RenderItemPage* page = m_renderItemPage;
+		const uint32_t  item = renderItemIdx & RenderItemPage::kMask;
+
+		if (NULL != m_frame->m_sortKeyRun)
+		{
+			m_frame->m_sortKeyRun[m_uniformIdx].add(key, RenderItemCount(renderItemIdx) );
+		}
+		else
+		{
+			page->m_sortKey[item] = key;
+		}
 
 		m_draw.m_uniformIdx   = m_uniformIdx;
 		m_draw.m_uniformBegin = m_uniformBegin;
@@ -1407,8 +1423,8 @@ namespace bgfx
 			m_draw.m_occlusionQuery = _occlusionQuery;
 		}
 
-		m_frame->m_renderItem[renderItemIdx].draw = m_draw;
-		m_frame->m_renderItemBind[renderItemIdx]  = m_bind;
+		page->m_renderItem[item].draw = m_draw;
+		page->m_renderItemBind[item]  = m_bind;
 
 		m_draw.clear(_flags);
 		m_bind.clear(_flags);
@@ -1431,8 +1447,8 @@ namespace bgfx
 			return;
 		}
 
-		const uint32_t renderItemIdx = bx::atomicFetchAndAddsat<uint32_t>(&m_frame->m_numRenderItems, 1, BGFX_CONFIG_MAX_DRAW_CALLS);
-		if (BGFX_CONFIG_MAX_DRAW_CALLS-1 <= renderItemIdx)
+		const uint32_t renderItemIdx = allocRenderItem();
+		if (UINT32_MAX == renderItemIdx)
 		{
 			discard(_flags);
 			++m_numDropped;
@@ -1456,14 +1472,24 @@ namespace bgfx
 		m_key.m_seq     = s_ctx->getSeqIncr(_id);
 
 		uint64_t key = m_key.encodeCompute();
-		m_frame->m_sortKeys[renderItemIdx]   = key;
-		m_frame->m_sortValues[renderItemIdx] = RenderItemCount(renderItemIdx);
+
+		RenderItemPage* page = m_renderItemPage;
+		const uint32_t  item = renderItemIdx & RenderItemPage::kMask;
+
+		if (NULL != m_frame->m_sortKeyRun)
+		{
+			m_frame->m_sortKeyRun[m_uniformIdx].add(key, RenderItemCount(renderItemIdx) );
+		}
+		else
+		{
+			page->m_sortKey[item] = key;
+		}
 
 		m_compute.m_uniformIdx   = m_uniformIdx;
 		m_compute.m_uniformBegin = m_uniformBegin;
 		m_compute.m_uniformEnd   = m_uniformEnd;
-		m_frame->m_renderItem[renderItemIdx].compute = m_compute;
-		m_frame->m_renderItemBind[renderItemIdx]     = m_bind;
+		page->m_renderItem[item].compute = m_compute;
+		page->m_renderItemBind[item]     = m_bind;
 
 		m_compute.clear(_flags);
 		m_bind.clear(_flags);
@@ -1505,6 +1531,11 @@ namespace bgfx
 
 	void Frame::sort()
 	{
+		if (m_sorted)
+		{
+			return;
+		}
+
 		BGFX_PROFILER_SCOPE("bgfx/Sort", kColorSubmit);
 
 		ViewId viewRemap[BGFX_CONFIG_MAX_VIEWS];
@@ -1542,21 +1573,166 @@ namespace bgfx
 			}
 		}
 
-		for (uint32_t ii = 0, num = m_numRenderItems; ii < num; ++ii)
+		// Most of the time view order is never changed, and there is nothing to remap.
+		const bool remap = !SortKey::isViewRemapIdentity(viewRemap);
+
+		// Sort buffers are shared between draw, blit and uniform cache keys, and only ever grow
+		// here on render thread. Frame::start shrinks them back when draw count drops.
+		const uint32_t sortCapacity = bx::max<uint32_t>(
+			  kMinSortCapacity
+			, m_numRenderItems
+			, m_numBlitItems
+			, m_uniformCacheFrame.m_numItems
+			);
+
+		if (m_sortCapacity < sortCapacity)
+		{
+			resizeSort(bx::alignUp(sortCapacity, RenderItemPage::kNum) );
+		}
+
+		if (NULL != m_sortKeyRun)
 		{
-			m_sortKeys[ii] = SortKey::remapView(m_sortKeys[ii], viewRemap);
+			mergeSortKeyRuns(viewRemap);
 		}
+		else
+		{
+			uint32_t num = 0;
+
+			for (uint32_t ii = 0, numChunks = m_numRenderItemChunks; ii < numChunks; ++ii)
+			{
+				const RenderItemChunk& chunk = m_renderItemChunk[ii];
+				const RenderItemPage*  page  = m_renderItemPage[chunk.m_begin >> RenderItemPage::kShift];
 
-		bx::radixSort(m_sortKeys, s_ctx->m_tempKeys, m_sortValues, s_ctx->m_tempValues, m_numRenderItems);
+				bx::memCopy(&m_sortKeys[num], &page->m_sortKey[chunk.m_begin & RenderItemPage::kMask], chunk.m_num*sizeof(uint64_t) );
+
+				for (uint32_t jj = 0; jj < chunk.m_num; ++jj)
+				{
+					m_sortValues[num+jj] = RenderItemCount(chunk.m_begin+jj);
+				}
+
+				num += chunk.m_num;
+			}
+
+			BX_ASSERT(num == m_numRenderItems
+				, "Number of committed render items %d doesn't match number of render items %d."
+				, num
+				, m_numRenderItems
+				);
+
+			if (remap)
+			{
+				SortKey::remapView(m_sortKeys, m_numRenderItems, viewRemap);
+			}
+
+			bx::radixSort(m_sortKeys, m_tempKeys, m_sortValues, m_tempValues, m_numRenderItems);
+		}
 
-		for (uint32_t ii = 0, num = m_numBlitItems; ii < num; ++ii)
+		if (remap)
 		{
-			m_blitKeys[ii] = BlitKey::remapView(m_blitKeys[ii], viewRemap);
+			BlitKey::remapView(m_blitKeys, m_numBlitItems, viewRemap);
 		}
 
-		bx::radixSort(m_blitKeys, (uint32_t*)&s_ctx->m_tempKeys, m_numBlitItems);
+		bx::radixSort(m_blitKeys, (uint32_t*)m_tempKeys, m_numBlitItems);
 
-		m_uniformCacheFrame.sort(viewRemap, s_ctx->m_tempKeys);
+		m_uniformCacheFrame.sort(viewRemap, m_tempKeys);
+
+		m_sorted = true;
+	}
+
+	void Frame::mergeSortKeyRuns(const ViewId* _viewRemap)
+	{
+		// Runs are sorted with original view ids. Remapping view only replaces view bits, so keys
+		// of the same view keep their relative order, and runs can be merged one view at the time
+		// in remapped view order.
+		SortKeyRun* active[128];
+		BX_ASSERT(m_numSortKeyRuns <= BX_COUNTOF(active), "Too many sort key runs %d.", m_numSortKeyRuns);
+
+		uint16_t viewStart[BGFX_CONFIG_MAX_VIEWS+1] = {};
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+		{
+			++viewStart[_viewRemap[ii]+1];
+		}
+
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+		{
+			viewStart[ii+1] += viewStart[ii];
+		}
+
+		ViewId viewOrder[BGFX_CONFIG_MAX_VIEWS];
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+		{
+			viewOrder[viewStart[_viewRemap[ii] ]++] = ViewId(ii);
+		}
+
+		uint32_t num = 0;
+
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+		{
+			const ViewId   id   = viewOrder[ii];
+			const uint64_t view = uint64_t(_viewRemap[id]) << kSortKeyViewBitShift;
+
+			uint32_t numActive = 0;
+			for (uint32_t jj = 0, numRuns = m_numSortKeyRuns; jj < numRuns; ++jj)
+			{
+				SortKeyRun& run = m_sortKeyRun[jj];
+				if (0 != run.m_num
+				&&  run.m_viewOffset[id] != run.m_viewOffset[id+1])
+				{
+					run.m_pos = run.m_viewOffset[id];
+					active[numActive++] = &run;
+				}
+			}
+
+			while (1 < numActive)
+			{
+				uint32_t best    = 0;
+				uint64_t bestKey = active[0]->m_keys[active[0]->m_pos];
+
+				for (uint32_t jj = 1; jj < numActive; ++jj)
+				{
+					const uint64_t key = active[jj]->m_keys[active[jj]->m_pos];
+					if (key < bestKey)
+					{
+						best    = jj;
+						bestKey = key;
+					}
+				}
+
+				SortKeyRun& run = *active[best];
+				m_sortKeys[num]   = (bestKey & ~kSortKeyViewMask) | view;
+				m_sortValues[num] = run.m_values[run.m_pos];
+				++num;
+				++run.m_pos;
+
+				if (run.m_pos == run.m_viewOffset[id+1])
+				{
+					// Keep runs in encoder order, so that equal keys are resolved the same way
+					// every frame.
+					--numActive;
+					for (uint32_t jj = best; jj < numActive; ++jj)
+					{
+						active[jj] = active[jj+1];
+					}
+				}
+			}
+
+			if (1 == numActive)
+			{
+				const SortKeyRun& run = *active[0];
+				for (uint32_t jj = run.m_pos, end = run.m_viewOffset[id+1]; jj < end; ++jj)
+				{
+					m_sortKeys[num]   = (run.m_keys[jj] & ~kSortKeyViewMask) | view;
+					m_sortValues[num] = run.m_values[jj];
+					++num;
+				}
+			}
+		}
+
+		BX_ASSERT(num == m_numRenderItems
+			, "Merged number of sort keys %d doesn't match number of render items %d."
+			, num
+			, m_numRenderItems
+			);
 	}
 
 	RenderFrame::Enum renderFrame(int32_t _msecs)
@@ -2054,10 +2230,10 @@ namespace bgfx
 		m_frameTimeLast = bx::getHPCounter();
 		m_flipAfterRender = !!(m_init.resolution.reset & BGFX_RESET_FLIP_AFTER_RENDER);
 
-		m_submit->create(_init.limits.minResourceCbSize);
+		m_submit->create(_init.limits.minResourceCbSize, _init.parallelSort);
 
 #if BGFX_CONFIG_MULTITHREADED
-		m_render->create(_init.limits.minResourceCbSize);
+		m_render->create(_init.limits.minResourceCbSize, _init.parallelSort);
 
 		if (s_renderFrameCalled)
 		{
@@ -2108,7 +2284,7 @@ namespace bgfx
 
 		frameNoRenderWait();
 
-		m_encoderHandle = bx::createHandleAlloc(g_allocator, _init.limits.maxEncoders);
+		m_encoderSlots  = 1;
 		m_encoder       = (EncoderImpl*)bx::alignedAlloc(g_allocator, sizeof(EncoderImpl)*_init.limits.maxEncoders, BX_ALIGNOF(EncoderImpl) );
 		m_encoderStats  = (EncoderStats*)bx::alloc(g_allocator, sizeof(EncoderStats)*_init.limits.maxEncoders);
 		for (uint32_t ii = 0, num = _init.limits.maxEncoders; ii < num; ++ii)
@@ -2116,8 +2292,6 @@ namespace bgfx
 			BX_PLACEMENT_NEW(&m_encoder[ii], EncoderImpl);
 		}
 
-		uint16_t idx = m_encoderHandle->alloc();
-		BX_ASSERT(0 == idx, "Internal encoder handle is not 0 (idx %d).", idx); BX_UNUSED(idx);
 		m_encoder[0].begin(m_submit, 0);
 		m_encoder0 = BX_ENABLED(BGFX_CONFIG_ENCODER_API_ONLY)
 			? NULL
@@ -2171,14 +2345,14 @@ namespace bgfx
 		m_textVideoMemBlitter.init(m_init.resolution.debugTextScale);
 		m_clearQuad.init();
 
-		m_submit->m_transientVb = createTransientVertexBuffer(_init.limits.maxTransientVbSize);
-		m_submit->m_transientIb = createTransientIndexBuffer(_init.limits.maxTransientIbSize);
+		m_submit->m_transientVb[0] = createTransientVertexBuffer(_init.limits.maxTransientVbSize);
+		m_submit->m_transientIb[0] = createTransientIndexBuffer(_init.limits.maxTransientIbSize);
 		frame();
 
 		if (BX_ENABLED(BGFX_CONFIG_MULTITHREADED) )
 		{
-			m_submit->m_transientVb = createTransientVertexBuffer(_init.limits.maxTransientVbSize);
-			m_submit->m_transientIb = createTransientIndexBuffer(_init.limits.maxTransientIbSize);
+			m_submit->m_transientVb[0] = createTransientVertexBuffer(_init.limits.maxTransientVbSize);
+			m_submit->m_transientIb[0] = createTransientIndexBuffer(_init.limits.maxTransientIbSize);
 			frame();
 		}
 
@@ -2192,16 +2366,14 @@ namespace bgfx
 		getCommandBuffer(CommandBuffer::RendererShutdownBegin);
 		frame();
 
-		destroyTransientVertexBuffer(m_submit->m_transientVb);
-		destroyTransientIndexBuffer(m_submit->m_transientIb);
+		destroyTransientBuffers(m_submit);
 		m_textVideoMemBlitter.shutdown();
 		m_clearQuad.shutdown();
 		frame();
 
 		if (BX_ENABLED(BGFX_CONFIG_MULTITHREADED) )
 		{
-			destroyTransientVertexBuffer(m_submit->m_transientVb);
-			destroyTransientIndexBuffer(m_submit->m_transientIb);
+			destroyTransientBuffers(m_submit);
 			frame();
 		}
 
@@ -2211,9 +2383,7 @@ namespace bgfx
 		frame();
 
 		m_encoder[0].end(true);
-		m_encoderHandle->free(0);
-		bx::destroyHandleAlloc(g_allocator, m_encoderHandle);
-		m_encoderHandle = NULL;
+		m_encoderSlots = 0;
 
 		for (uint32_t ii = 0, num = g_caps.limits.maxEncoders; ii < num; ++ii)
 		{
@@ -2405,17 +2575,21 @@ namespace bgfx
 		if (_forceNewEncoder
 		||  BGFX_API_THREAD_MAGIC != s_threadIndex)
 		{
-			bx::MutexScope beginLockScope(m_encoderBeginLock);
-			bx::MutexScope encoderApiScope(m_encoderApiLock);
-
-			uint16_t idx = m_encoderHandle->alloc();
-			if (kInvalidHandle == idx)
+			const uint32_t idx = encoderSlotAlloc();
+			if (UINT32_MAX == idx)
 			{
 				return NULL;
 			}
 
 			encoder = &m_encoder[idx];
 			encoder->begin(m_submit, uint8_t(idx) );
+
+			if (BGFX_API_THREAD_MAGIC != s_threadIndex)
+			{
+				// Address of thread local identifies thread.
+				bx::atomicStorePtr(&encoder->m_ownerThread, &s_threadEncoder);
+				s_threadEncoder = encoder;
+			}
 		}
 #else
 		BX_UNUSED(_forceNewEncoder);
@@ -2430,6 +2604,13 @@ namespace bgfx
 		EncoderImpl* encoder = reinterpret_cast<EncoderImpl*>(_encoder);
 		if (encoder != &m_encoder[0])
 		{
+			bx::atomicStorePtr(&encoder->m_ownerThread, NULL);
+
+			if (encoder == s_threadEncoder)
+			{
+				s_threadEncoder = NULL;
+			}
+
 			encoder->end(true);
 			m_encoderEndSem.post();
 		}
@@ -2443,23 +2624,18 @@ namespace bgfx
 		m_encoder[0].end(true);
 
 #if BGFX_CONFIG_MULTITHREADED
-		m_encoderBeginLock.lock(); // don't let any bgfx::begin calls...
-		encoderApiWait();          // wait for all started encoders to return...
-		bx::MutexScope encoderApiScope(m_encoderApiLock);
-		m_encoderBeginLock.unlock();
+		bx::MutexScope beginLockScope(m_encoderBeginLock); // don't let any bgfx::begin calls...
+		encoderApiWait();                                   // wait for all started encoders to return...
 
 		bx::MutexScope resourceApiScope(m_resourceApiLock);
 #else
 		encoderApiWait();
 #endif // BGFX_CONFIG_MULTITHREADED
 
-		m_encoderHandle->reset();
-		const uint16_t idx = m_encoderHandle->alloc();
-		BX_ASSERT(0 == idx, "Internal encoder handle is not 0 (idx %d).", idx); BX_UNUSED(idx);
-
 		if (0 != (_flags & BGFX_FRAME_DISCARD) )
 		{
-			m_submit->m_numRenderItems = 0;
+			m_submit->resetRenderItems();
+			m_submit->resetSortKeyRuns();
 		}
 
 		m_submit->m_capture = 0 != (_flags & BGFX_FRAME_DEBUG_CAPTURE);
@@ -2473,6 +2649,7 @@ namespace bgfx
 		frameNoRenderWait();
 
 		m_encoder[0].begin(m_submit, 0);
+		encoderApiResume();
 
 		return frameNum;
 	}
@@ -2495,7 +2672,7 @@ namespace bgfx
 
 		bx::memCopy(m_submit->m_viewRemap, m_viewRemap, sizeof(m_viewRemap) );
 
-		m_uniformCache.frame(m_submit->m_uniformCacheFrame);
+		m_uniformCache.frame(m_submit->m_uniformCacheFrame, m_viewRemap);
 
 		static_assert(bx::isTriviallyCopyable<View>(), "Must be memcopyiable...");
 		bx::memCopy(m_submit->m_view, m_view, sizeof(m_view) );
@@ -2523,6 +2700,7 @@ namespace bgfx
 
 		uint32_t nextFrameNum = m_render->m_frameNum + 1;
 		m_submit->start(nextFrameNum);
+		trimTransientBuffers(m_submit);
 
 		bx::memSet(m_seq, 0, sizeof(m_seq) );
 
@@ -2610,8 +2788,16 @@ namespace bgfx
 
 			if (m_rendererInitialized)
 			{
+				if (BX_ENABLED(BGFX_CONFIG_FRAME_CAPTURE)
+				&&  m_render->m_capture)
+				{
+					BGFX_PROFILER_SCOPE("bgfx/Frame capture", kColorResource);
+					frameCaptureSave(m_render);
+				}
+
 				{
 					BGFX_PROFILER_SCOPE("bgfx/Render submit", kColorSubmit);
+					rendererResetUniforms();
 					m_renderCtx->submit(m_render, m_clearQuad, m_textVideoMemBlitter);
 					m_flipped = false;
 				}
@@ -2631,8 +2817,16 @@ namespace bgfx
 				rendererExecCommands(m_render->m_cmdPost);
 			}
 
+			m_render->m_perfStats.frameArenaAllocs = m_render->m_frameArena.getNumAllocs();
+			m_render->m_perfStats.frameArenaUsed   = m_render->m_frameArena.getUsed();
+			m_render->m_frameArena.reset();
+
 			renderSemPost();
 
+			// Memory blocks released by render thread go back to shared pool in bulk, so API thread
+			// can reuse them.
+			memoryPoolFlush();
+
 			if (m_flipAfterRender)
 			{
 				if (!m_render->m_flush)
@@ -2653,8 +2847,34 @@ namespace bgfx
 			;
 	}
 
-	void rendererUpdateUniforms(RendererContextI* _renderCtx, UniformBuffer* _uniformBuffer, uint32_t _begin, uint32_t _end)
+	// Last uniform range applied by renderer. Encoder points draws with identical uniform bytes at
+	// the same range, so reapplying it would only write the same values again.
+	static const UniformBuffer* s_uniformAppliedBuffer = NULL;
+	static uint32_t s_uniformAppliedBegin = 0;
+	static uint32_t s_uniformAppliedEnd   = 0;
+
+	void rendererResetUniforms()
 	{
+		s_uniformAppliedBuffer = NULL;
+	}
+
+	bool rendererUpdateUniforms(RendererContextI* _renderCtx, UniformBuffer* _uniformBuffer, uint32_t _begin, uint32_t _end)
+	{
+		if (_begin == _end)
+		{
+			return false;
+		}
+
+		if (BX_ENABLED(BGFX_CONFIG_UNIFORM_DEDUP)
+		&&  _uniformBuffer == s_uniformAppliedBuffer
+		&&  _begin == s_uniformAppliedBegin
+		&&  _end   == s_uniformAppliedEnd)
+		{
+			return false;
+		}
+
+		bool hasMarker = false;
+
 		_uniformBuffer->reset(_begin);
 		while (_uniformBuffer->getPos() < _end)
 		{
@@ -2688,8 +2908,80 @@ namespace bgfx
 			else
 			{
 				_renderCtx->setMarker(data, uint16_t(size)-1);
+				hasMarker = true;
+			}
+		}
+
+		// Ranges with markers are never skipped, marker must be emitted for every draw.
+		s_uniformAppliedBuffer = hasMarker ? NULL : _uniformBuffer;
+		s_uniformAppliedBegin  = _begin;
+		s_uniformAppliedEnd    = _end;
+
+		return true;
+	}
+
+	bool frameReplay(bx::ReaderI* _reader, uint32_t _numIterations, FrameReplayStats* _stats, bx::Error* _err)
+	{
+		BX_ERROR_SCOPE(_err, "Frame replay");
+
+		bx::memSet(_stats, 0, sizeof(FrameReplayStats) );
+		_stats->timerFreq = bx::getHPFrequency();
+
+		if (NULL == s_ctx
+		||  !s_ctx->m_singleThreaded
+		||  RendererType::Noop != s_ctx->m_renderCtx->getRendererType() )
+		{
+			BX_ERROR_SET(_err, BGFX_ERROR_FRAME_CAPTURE_VALIDATION, "Frame replay requires single-threaded Noop renderer.");
+			return false;
+		}
+
+		Frame* frame = BX_ALIGNED_NEW(g_allocator, Frame, BX_CACHE_LINE_SIZE);
+		frame->create(g_caps.limits.minResourceCbSize, false);
+
+		if (frameCaptureRead(_reader, frame, _err) )
+		{
+			_stats->frameNum       = frame->m_frameNum;
+			_stats->numRenderItems = frame->m_numRenderItems;
+			_stats->numBlitItems   = frame->m_numBlitItems;
+			_stats->numIterations  = _numIterations;
+
+			// Sort remaps blit and uniform cache keys in place, each iteration starts from captured keys.
+			const UniformCacheFrame& uniformCacheFrame = frame->m_uniformCacheFrame;
+			const uint32_t blitKeysSize         = frame->m_numBlitItems*sizeof(uint32_t);
+			const uint32_t uniformCacheKeysSize = uniformCacheFrame.m_numItems*sizeof(uint64_t);
+
+			uint32_t* blitKeys         = (uint32_t*)bx::alloc(g_allocator, bx::max(blitKeysSize, 1u) );
+			uint64_t* uniformCacheKeys = (uint64_t*)bx::alloc(g_allocator, bx::max(uniformCacheKeysSize, 1u) );
+			bx::memCopy(blitKeys,         frame->m_blitKeys,         blitKeysSize);
+			bx::memCopy(uniformCacheKeys, uniformCacheFrame.m_keys, uniformCacheKeysSize);
+
+			for (uint32_t ii = 0; ii < _numIterations; ++ii)
+			{
+				bx::memCopy(frame->m_blitKeys,         blitKeys,         blitKeysSize);
+				bx::memCopy(uniformCacheFrame.m_keys, uniformCacheKeys, uniformCacheKeysSize);
+				frame->m_sorted = false;
+
+				const int64_t sortBegin = bx::getHPCounter();
+				frame->sort();
+
+				const int64_t submitBegin = bx::getHPCounter();
+				rendererResetUniforms();
+				s_ctx->m_renderCtx->submit(frame, s_ctx->m_clearQuad, s_ctx->m_textVideoMemBlitter);
+
+				const int64_t submitEnd = bx::getHPCounter();
+				_stats->sortTime   += submitBegin - sortBegin;
+				_stats->submitTime += submitEnd   - submitBegin;
 			}
+
+			bx::free(g_allocator, blitKeys);
+			bx::free(g_allocator, uniformCacheKeys);
 		}
+
+		frameCaptureFree(frame);
+		frame->destroy();
+		bx::deleteObject(g_allocator, frame, BX_CACHE_LINE_SIZE);
+
+		return _err->isOk();
 	}
 
 	void Context::flushTextureUpdateBatch(CommandBuffer& _cmdbuf)
@@ -3686,6 +3978,7 @@ namespace bgfx
 		, maxTransientVbSize(BGFX_CONFIG_MAX_TRANSIENT_VERTEX_BUFFER_SIZE)
 		, maxTransientIbSize(BGFX_CONFIG_MAX_TRANSIENT_INDEX_BUFFER_SIZE)
 		, minUniformBufferSize(BGFX_CONFIG_MIN_UNIFORM_BUFFER_SIZE)
+		, maxDrawCalls(BGFX_CONFIG_MAX_DRAW_CALLS)
 	{
 	}
 
@@ -3697,6 +3990,7 @@ namespace bgfx
 		, debug(BX_ENABLED(BGFX_CONFIG_DEBUG) )
 		, profile(BX_ENABLED(BGFX_CONFIG_DEBUG_ANNOTATION) )
 		, fallback(true)
+		, parallelSort(false)
 		, callback(NULL)
 		, allocator(NULL)
 	{
@@ -3724,6 +4018,7 @@ namespace bgfx
 
 		init.limits.maxEncoders       = bx::clamp<uint16_t>(init.limits.maxEncoders, 1, (0 != BGFX_CONFIG_MULTITHREADED) ? 128 : 1);
 		init.limits.minResourceCbSize = bx::min<uint32_t>(init.limits.minResourceCbSize, BGFX_CONFIG_MIN_RESOURCE_COMMAND_BUFFER_SIZE);
+		init.limits.maxDrawCalls      = bx::max<uint32_t>(init.limits.maxDrawCalls, 1);
 
 		struct ErrorState
 		{
@@ -3758,7 +4053,7 @@ namespace bgfx
 		}
 
 		bx::memSet(&g_caps, 0, sizeof(g_caps) );
-		g_caps.limits.maxDrawCalls            = BGFX_CONFIG_MAX_DRAW_CALLS;
+		g_caps.limits.maxDrawCalls            = init.limits.maxDrawCalls;
 		g_caps.limits.maxBlits                = BGFX_CONFIG_MAX_BLIT_ITEMS;
 		g_caps.limits.maxTextureSize          = 0;
 		g_caps.limits.maxTextureLayers        = 1;
@@ -3812,6 +4107,7 @@ namespace bgfx
 		case ErrorState::ContextAllocated:
 			bx::deleteObject(g_allocator, s_ctx, Context::kAlignment);
 			s_ctx = NULL;
+			memoryPoolShutdown();
 			[[fallthrough]];
 
 		case ErrorState::Default:
@@ -3848,6 +4144,8 @@ namespace bgfx
 
 		bx::deleteObject(g_allocator, ctx, Context::kAlignment);
 
+		memoryPoolShutdown();
+
 		BX_TRACE("Shutdown complete.");
 
 		if (NULL != s_allocatorStub)
@@ -4311,10 +4609,356 @@ namespace bgfx
 		return g_caps.rendererType;
 	}
 
+	// Memory blocks are allocated from size classes, four per power of two, from 64 bytes up to
+	// BGFX_CONFIG_MEMORY_POOL_MAX_BLOCK_SIZE. Every thread keeps small cache of free blocks per class,
+	// and exchanges blocks with shared pool in batches. Blocks are usually allocated on API thread and
+	// released on render thread, render thread returns its cache to shared pool once frame is consumed.
+	// Cache of any other thread goes back to shared pool when that thread exits.
+	struct MemoryBlock
+	{
+		union
+		{
+			MemoryBlock* next;
+			uint64_t     padding;
+		};
+
+		uint32_t sizeClass;
+		uint32_t reserved;
+	};
+
+	static_assert(16 == sizeof(MemoryBlock), "Memory block header must keep memory 16-byte aligned.");
+
+	constexpr uint32_t kMemoryPoolCacheSize   = 256<<10;
+	constexpr uint32_t kMemoryPoolMaxCacheNum = 64;
+
+	constexpr uint32_t kMemoryPoolNumClasses = memoryPoolSizeClass(BGFX_CONFIG_MEMORY_POOL_MAX_BLOCK_SIZE) + 1;
+	constexpr uint32_t kMemoryPoolUnpooled   = UINT32_MAX;
+
+	static_assert(BGFX_CONFIG_MEMORY_POOL_MAX_BLOCK_SIZE >= 1u<<kMemoryPoolMinShift, "BGFX_CONFIG_MEMORY_POOL_MAX_BLOCK_SIZE is too small.");
+
+	struct MemoryPoolCache
+	{
+		MemoryPoolCache* next;
+		MemoryBlock*     list[kMemoryPoolNumClasses];
+		uint32_t         num[kMemoryPoolNumClasses];
+
+		// Written only by owning thread, read without synchronization for stats.
+		volatile uint32_t cachedSize;
+	};
+
+	struct MemoryPool
+	{
+		bx::Mutex        mutex;
+		MemoryPoolCache* caches;
+		MemoryBlock*     list[kMemoryPoolNumClasses];
+		uint32_t         num[kMemoryPoolNumClasses];
+		uint32_t         cachedSize;
+		uint32_t         heapAllocs;
+		uint32_t         generation = 1;
+	};
+
+	static MemoryPool s_memoryPool;
+
+#if BGFX_CONFIG_MULTITHREADED
+	static BX_THREAD_LOCAL MemoryPoolCache* s_memoryPoolCache(NULL);
+	static BX_THREAD_LOCAL uint32_t s_memoryPoolGeneration(0);
+#else
+	static MemoryPoolCache* s_memoryPoolCache(NULL);
+	static uint32_t s_memoryPoolGeneration(0);
+#endif // BGFX_CONFIG_MULTITHREADED
+
+	static uint32_t memoryPoolCacheMax(uint32_t _sizeClass)
+	{
+		return bx::clamp<uint32_t>(kMemoryPoolCacheSize / memoryPoolClassSize(_sizeClass), 1, kMemoryPoolMaxCacheNum);
+	}
+
+#if BGFX_CONFIG_MULTITHREADED
+	static void memoryPoolThreadExit();
+
+	struct MemoryPoolThreadExit
+	{
+		~MemoryPoolThreadExit()
+		{
+			memoryPoolThreadExit();
+		}
+	};
+#endif // BGFX_CONFIG_MULTITHREADED
+
+	static MemoryPoolCache* memoryPoolGetCache()
+	{
+		// Generation changes on shutdown, cache pointer left in thread local storage of other threads
+		// is stale after that.
+		if (BX_LIKELY(s_memoryPoolGeneration == s_memoryPool.generation) )
+		{
+			return s_memoryPoolCache;
+		}
+
+		MemoryPoolCache* cache = (MemoryPoolCache*)bx::alloc(g_allocator, sizeof(MemoryPoolCache) );
+		bx::memSet(cache, 0, sizeof(MemoryPoolCache) );
+
+		bx::MutexScope scope(s_memoryPool.mutex);
+		cache->next = s_memoryPool.caches;
+		s_memoryPool.caches = cache;
+
+		s_memoryPoolCache      = cache;
+		s_memoryPoolGeneration = s_memoryPool.generation;
+
+#if BGFX_CONFIG_MULTITHREADED
+		// Constructed once per thread, its destructor runs when thread exits.
+		static thread_local MemoryPoolThreadExit s_threadExit;
+		BX_UNUSED(s_threadExit);
+#endif // BGFX_CONFIG_MULTITHREADED
+
+		return cache;
+	}
+
+	static void memoryPoolRefill(MemoryPoolCache* _cache, uint32_t _sizeClass)
+	{
+		bx::MutexScope scope(s_memoryPool.mutex);
+
+		const uint32_t num = bx::min(s_memoryPool.num[_sizeClass], bx::max<uint32_t>(memoryPoolCacheMax(_sizeClass)/2, 1) );
+
+		for (uint32_t ii = 0; ii < num; ++ii)
+		{
+			MemoryBlock* block = s_memoryPool.list[_sizeClass];
+			s_memoryPool.list[_sizeClass] = block->next;
+
+			block->next = _cache->list[_sizeClass];
+			_cache->list[_sizeClass] = block;
+		}
+
+		s_memoryPool.num[_sizeClass] -= num;
+		s_memoryPool.cachedSize      -= num*memoryPoolClassSize(_sizeClass);
+		_cache->num[_sizeClass]      += num;
+		_cache->cachedSize           += num*memoryPoolClassSize(_sizeClass);
+	}
+
+	// Must be called with shared pool mutex locked. Blocks that don't fit into shared pool are
+	// linked into _heap list, to be freed after mutex is unlocked.
+	static void memoryPoolReleaseLocked(MemoryPoolCache* _cache, uint32_t _sizeClass, uint32_t _num, MemoryBlock*& _heap)
+	{
+		const uint32_t size = memoryPoolClassSize(_sizeClass);
+
+		for (uint32_t ii = 0; ii < _num; ++ii)
+		{
+			MemoryBlock* block = _cache->list[_sizeClass];
+			_cache->list[_sizeClass] = block->next;
+
+			if (s_memoryPool.cachedSize + size <= BGFX_CONFIG_MEMORY_POOL_SIZE)
+			{
+				block->next = s_memoryPool.list[_sizeClass];
+				s_memoryPool.list[_sizeClass] = block;
+				s_memoryPool.num[_sizeClass]++;
+				s_memoryPool.cachedSize += size;
+			}
+			else
+			{
+				block->next = _heap;
+				_heap = block;
+			}
+		}
+
+		_cache->num[_sizeClass] -= _num;
+		_cache->cachedSize      -= _num*size;
+	}
+
+	static void memoryPoolFreeList(MemoryBlock* _list)
+	{
+		while (NULL != _list)
+		{
+			MemoryBlock* next = _list->next;
+			bx::free(g_allocator, _list);
+			_list = next;
+		}
+	}
+
+	static void memoryPoolRelease(MemoryPoolCache* _cache, uint32_t _sizeClass, uint32_t _num)
+	{
+		MemoryBlock* heap = NULL;
+
+		{
+			bx::MutexScope scope(s_memoryPool.mutex);
+			memoryPoolReleaseLocked(_cache, _sizeClass, _num, heap);
+		}
+
+		memoryPoolFreeList(heap);
+	}
+
+#if BGFX_CONFIG_MULTITHREADED
+	static void memoryPoolThreadExit()
+	{
+		MemoryBlock* heap = NULL;
+
+		{
+			bx::MutexScope scope(s_memoryPool.mutex);
+
+			// Cache was already freed if shutdown happened after it was created.
+			if (s_memoryPoolGeneration != s_memoryPool.generation)
+			{
+				return;
+			}
+
+			MemoryPoolCache* cache = s_memoryPoolCache;
+
+			for (uint32_t ii = 0; ii < kMemoryPoolNumClasses; ++ii)
+			{
+				memoryPoolReleaseLocked(cache, ii, cache->num[ii], heap);
+			}
+
+			MemoryPoolCache** link = &s_memoryPool.caches;
+			while (*link != cache)
+			{
+				link = &(*link)->next;
+			}
+
+			*link = cache->next;
+			bx::free(g_allocator, cache);
+
+			s_memoryPoolCache      = NULL;
+			s_memoryPoolGeneration = 0;
+		}
+
+		memoryPoolFreeList(heap);
+	}
+#endif // BGFX_CONFIG_MULTITHREADED
+
+	static MemoryBlock* memoryPoolAlloc(uint32_t _size)
+	{
+		const uint32_t size = uint32_t(sizeof(MemoryBlock) ) + _size;
+
+		if (0 == BGFX_CONFIG_MEMORY_POOL
+		||  size > BGFX_CONFIG_MEMORY_POOL_MAX_BLOCK_SIZE)
+		{
+			bx::atomicFetchAndAdd<uint32_t>(&s_memoryPool.heapAllocs, 1);
+
+			MemoryBlock* block = (MemoryBlock*)bx::alloc(g_allocator, size);
+			block->sizeClass = kMemoryPoolUnpooled;
+			return block;
+		}
+
+		const uint32_t sizeClass = memoryPoolSizeClass(size);
+		MemoryPoolCache* cache = memoryPoolGetCache();
+
+		if (0 == cache->num[sizeClass])
+		{
+			memoryPoolRefill(cache, sizeClass);
+		}
+
+		MemoryBlock* block = cache->list[sizeClass];
+
+		if (NULL != block)
+		{
+			cache->list[sizeClass] = block->next;
+			cache->num[sizeClass]--;
+			cache->cachedSize -= memoryPoolClassSize(sizeClass);
+			return block;
+		}
+
+		bx::atomicFetchAndAdd<uint32_t>(&s_memoryPool.heapAllocs, 1);
+
+		block = (MemoryBlock*)bx::alloc(g_allocator, memoryPoolClassSize(sizeClass) );
+		block->sizeClass = sizeClass;
+		return block;
+	}
+
+	static void memoryPoolFree(MemoryBlock* _block)
+	{
+		const uint32_t sizeClass = _block->sizeClass;
+
+		if (kMemoryPoolUnpooled == sizeClass)
+		{
+			bx::free(g_allocator, _block);
+			return;
+		}
+
+		MemoryPoolCache* cache = memoryPoolGetCache();
+
+		_block->next = cache->list[sizeClass];
+		cache->list[sizeClass] = _block;
+		cache->num[sizeClass]++;
+		cache->cachedSize += memoryPoolClassSize(sizeClass);
+
+		const uint32_t max = memoryPoolCacheMax(sizeClass);
+		if (cache->num[sizeClass] > max)
+		{
+			memoryPoolRelease(cache, sizeClass, cache->num[sizeClass] - max/2);
+		}
+	}
+
+	void memoryPoolFlush()
+	{
+		if (s_memoryPoolGeneration != s_memoryPool.generation)
+		{
+			return;
+		}
+
+		MemoryPoolCache* cache = s_memoryPoolCache;
+
+		for (uint32_t ii = 0; ii < kMemoryPoolNumClasses; ++ii)
+		{
+			if (0 != cache->num[ii])
+			{
+				memoryPoolRelease(cache, ii, cache->num[ii]);
+			}
+		}
+	}
+
+	void memoryPoolShutdown()
+	{
+		bx::MutexScope scope(s_memoryPool.mutex);
+
+		for (MemoryPoolCache* cache = s_memoryPool.caches; NULL != cache;)
+		{
+			for (uint32_t ii = 0; ii < kMemoryPoolNumClasses; ++ii)
+			{
+				memoryPoolFreeList(cache->list[ii]);
+			}
+
+			MemoryPoolCache* next = cache->next;
+			bx::free(g_allocator, cache);
+			cache = next;
+		}
+
+		for (uint32_t ii = 0; ii < kMemoryPoolNumClasses; ++ii)
+		{
+			memoryPoolFreeList(s_memoryPool.list[ii]);
+			s_memoryPool.list[ii] = NULL;
+			s_memoryPool.num[ii]  = 0;
+		}
+
+		s_memoryPool.caches     = NULL;
+		s_memoryPool.cachedSize = 0;
+		s_memoryPool.heapAllocs = 0;
+		s_memoryPool.generation++;
+	}
+
+	void getMemoryPoolStats(Stats& _outStats)
+	{
+		bx::MutexScope scope(s_memoryPool.mutex);
+		uint32_t cachedSize = s_memoryPool.cachedSize;
+		for (const MemoryPoolCache* cache = s_memoryPool.caches; NULL != cache; cache = cache->next)
+		{
+			cachedSize += cache->cachedSize;
+		}
+
+		_outStats.memoryPoolHeapAllocs = s_memoryPool.heapAllocs;
+		_outStats.memoryPoolCached     = cachedSize;
+	}
+
+	bx::AllocatorI* getFrameAllocator()
+	{
+		if (BX_ENABLED(BGFX_CONFIG_FRAME_ARENA) )
+		{
+			return &s_ctx->m_render->m_frameArena;
+		}
+
+		return g_allocator;
+	}
+
 	const Memory* alloc(uint32_t _size)
 	{
 		BX_ASSERT(0 < _size, "Invalid memory operation. _size is 0.");
-		Memory* mem = (Memory*)bx::alloc(g_allocator, sizeof(Memory) + _size);
+		Memory* mem = (Memory*)(memoryPoolAlloc(sizeof(Memory) + _size) + 1);
 		mem->size = _size;
 		mem->data = (uint8_t*)mem + sizeof(Memory);
 		return mem;
@@ -4337,7 +4981,7 @@ namespace bgfx
 
 	const Memory* makeRef(const void* _data, uint32_t _size, ReleaseFn _releaseFn, void* _userData)
 	{
-		MemoryRef* memRef = (MemoryRef*)bx::alloc(g_allocator, sizeof(MemoryRef) );
+		MemoryRef* memRef = (MemoryRef*)(memoryPoolAlloc(sizeof(MemoryRef) ) + 1);
 		memRef->mem.size  = _size;
 		memRef->mem.data  = (uint8_t*)_data;
 		memRef->releaseFn = _releaseFn;
@@ -4362,7 +5006,7 @@ namespace bgfx
 				memRef->releaseFn(mem->data, memRef->userData);
 			}
 		}
-		bx::free(g_allocator, mem);
+		memoryPoolFree(reinterpret_cast<MemoryBlock*>(mem) - 1);
 	}
 
 	void setDebug(uint32_t _debug)
@@ -4494,23 +5138,46 @@ namespace bgfx
 		s_ctx->destroyDynamicVertexBuffer(_handle);
 	}
 
+	// Returns encoder used by calling thread, main thread always uses encoder 0. Transient buffers
+	// requested from thread with encoder are sub-allocated from encoder's chunk without locking.
+	static EncoderImpl* getThreadEncoder()
+	{
+#if BGFX_CONFIG_MULTITHREADED
+		if (BGFX_API_THREAD_MAGIC == s_threadIndex)
+		{
+			return &s_ctx->m_encoder[0];
+		}
+
+		// Encoder begun by this thread could have been ended on other thread, and its slot reused
+		// since, so it's used only while it's still owned by this thread.
+		EncoderImpl* encoder = s_threadEncoder;
+		return NULL != encoder
+			&& &s_threadEncoder == bx::atomicLoadPtr(&encoder->m_ownerThread)
+			? encoder
+			: NULL
+			;
+#else
+		return &s_ctx->m_encoder[0];
+#endif // BGFX_CONFIG_MULTITHREADED
+	}
+
 	uint32_t getAvailTransientIndexBuffer(uint32_t _num, bool _index32)
 	{
 		BX_ASSERT(0 < _num, "Requesting 0 indices.");
-		return s_ctx->getAvailTransientIndexBuffer(_num, _index32);
+		return s_ctx->getAvailTransientIndexBuffer(_num, _index32, getThreadEncoder() );
 	}
 
 	uint32_t getAvailTransientVertexBuffer(uint32_t _num, const VertexLayout& _layout)
 	{
 		BX_ASSERT(0 < _num, "Requesting 0 vertices.");
 		BX_ASSERT(isValid(_layout), "Invalid VertexLayout.");
-		return s_ctx->getAvailTransientVertexBuffer(_num, _layout.m_stride);
+		return s_ctx->getAvailTransientVertexBuffer(_num, _layout.m_stride, getThreadEncoder() );
 	}
 
 	uint32_t getAvailInstanceDataBuffer(uint32_t _num, uint16_t _stride)
 	{
 		BX_ASSERT(0 < _num, "Requesting 0 instances.");
-		return s_ctx->getAvailTransientVertexBuffer(_num, _stride);
+		return s_ctx->getAvailTransientVertexBuffer(_num, _stride, getThreadEncoder() );
 	}
 
 	void allocTransientIndexBuffer(TransientIndexBuffer* _tib, uint32_t _num, bool _index32)
@@ -4522,7 +5189,7 @@ namespace bgfx
 			, "32-bit indices are not supported. Use bgfx::getCaps to check BGFX_CAPS_INDEX32 backend renderer capabilities."
 			);
 
-		s_ctx->allocTransientIndexBuffer(_tib, _num, _index32);
+		s_ctx->allocTransientIndexBuffer(_tib, _num, _index32, getThreadEncoder() );
 
 		const uint32_t indexSize = _tib->isIndex16 ? 2 : 4;
 		BX_ASSERT(_num == _tib->size/ indexSize
@@ -4540,14 +5207,28 @@ namespace bgfx
 		BX_ASSERT(0 < _num, "Requesting 0 vertices.");
 		BX_ASSERT(isValid(_layout), "Invalid VertexLayout.");
 
-		VertexLayoutHandle layoutHandle;
+		EncoderImpl* encoder = getThreadEncoder();
+
+		VertexLayoutHandle layoutHandle = BGFX_INVALID_HANDLE;
+		if (NULL != encoder)
+		{
+			layoutHandle = encoder->findVertexLayout(_layout.m_hash);
+		}
+
+		if (!isValid(layoutHandle) )
 		{
 			BGFX_MUTEX_SCOPE(s_ctx->m_resourceApiLock);
 			layoutHandle = s_ctx->findOrCreateVertexLayout(_layout, true);
+
+			if (NULL != encoder
+			&&  isValid(layoutHandle) )
+			{
+				encoder->addVertexLayout(_layout.m_hash, layoutHandle);
+			}
 		}
 		BX_ASSERT(isValid(layoutHandle), "Failed to allocate vertex layout handle (BGFX_CONFIG_MAX_VERTEX_LAYOUTS, max: %d).", BGFX_CONFIG_MAX_VERTEX_LAYOUTS);
 
-		s_ctx->allocTransientVertexBuffer(_tvb, _num, layoutHandle, _layout.m_stride);
+		s_ctx->allocTransientVertexBuffer(_tvb, _num, layoutHandle, _layout.m_stride, encoder);
 
 		BX_ASSERT(_num == _tvb->size / _layout.m_stride
 			, "Failed to allocate transient vertex buffer (requested %d, available %d). "
@@ -4577,7 +5258,7 @@ namespace bgfx
 		BGFX_CHECK_CAPS(BGFX_CAPS_INSTANCING, "Instancing is not supported!");
 		BX_ASSERT(bx::isAligned(_stride, 16), "Stride must be multiple of 16.");
 		BX_ASSERT(0 < _num, "Requesting 0 instanced data vertices.");
-		s_ctx->allocInstanceDataBuffer(_idb, _num, _stride);
+		s_ctx->allocInstanceDataBuffer(_idb, _num, _stride, getThreadEncoder() );
 		BX_ASSERT(_num == _idb->size / _stride
 			, "Failed to allocate instance data buffer (requested %d, available %d). "
 			  "Use bgfx::getAvailTransient* functions to ensure availability."
@@ -305,11 +305,9 @@ namespace bgfx
 	extern void isFrameBufferValid(uint8_t _num, const Attachment* _attachment, bx::Error* _err);
 	extern void isIdentifierValid(const bx::StringView& _name, bx::Error* _err);
 
-#if BGFX_CONFIG_MAX_DRAW_CALLS < (64<<10)
-	typedef uint16_t RenderItemCount;
-#else
+	// Number of draw calls is configurable at runtime with `Init::Limits::maxDrawCalls`, which
+	// can be above 64K.
 	typedef uint32_t RenderItemCount;
-#endif // BGFX_CONFIG_MAX_DRAW_CALLS < (64<<10)
 
 	///
 	struct Handle
@@ -609,6 +607,40 @@ namespace bgfx
 	void setGraphicsDebuggerPresent(bool _present);
 	bool isGraphicsDebuggerPresent();
 	void release(const Memory* _mem);
+	void memoryPoolFlush();
+	void memoryPoolShutdown();
+
+	constexpr uint32_t kMemoryPoolMinShift = 6;
+
+	/// Returns size class of memory block of _size bytes. Classes are 64 bytes and below, then four
+	/// classes per power of two.
+	constexpr uint32_t memoryPoolSizeClass(uint32_t _size)
+	{
+		if (_size <= 1u<<kMemoryPoolMinShift)
+		{
+			return 0;
+		}
+
+		const uint32_t val   = _size - 1;
+		const uint32_t shift = 31 - bx::countLeadingZeros(val);
+		return (shift - kMemoryPoolMinShift)*4 + ( (val >> (shift - 2) ) & 3) + 1;
+	}
+
+	/// Returns size of memory block in _sizeClass.
+	constexpr uint32_t memoryPoolClassSize(uint32_t _sizeClass)
+	{
+		if (0 == _sizeClass)
+		{
+			return 1u<<kMemoryPoolMinShift;
+		}
+
+		const uint32_t idx   = _sizeClass - 1;
+		const uint32_t shift = kMemoryPoolMinShift + idx/4;
+		return (5 + idx%4) << (shift - 2);
+	}
+
+	bx::AllocatorI* getFrameAllocator();
+	void getMemoryPoolStats(Stats& _outStats);
 	const char* getAttribName(Attrib::Enum _attr);
 	const char* getAttribNameShort(Attrib::Enum _attr);
 	void getTextureSizeFromRatio(BackbufferRatio::Enum _ratio, uint16_t& _width, uint16_t& _height);
@@ -1378,6 +1410,61 @@ namespace bgfx
 			return key;
 		}
 
+		static void remapView(uint64_t* _keys, uint32_t _num, ViewId _viewRemap[BGFX_CONFIG_MAX_VIEWS])
+		{
+			if (BX_ENABLED(BX_CPU_ENDIAN_LITTLE)
+			&&  8 == kSortKeyViewNumBits)
+			{
+				// View occupies the most significant byte of the key, remap it in place without
+				// touching the rest of the key.
+				remapViewByte(reinterpret_cast<uint8_t*>(_keys) + sizeof(uint64_t) - 1, sizeof(uint64_t), _num, _viewRemap);
+				return;
+			}
+
+			for (uint32_t ii = 0; ii < _num; ++ii)
+			{
+				_keys[ii] = remapView(_keys[ii], _viewRemap);
+			}
+		}
+
+		static void remapViewByte(uint8_t* _view, uint32_t _stride, uint32_t _num, const ViewId* _viewRemap)
+		{
+			uint8_t* view = _view;
+
+			uint32_t ii = 0;
+			for (uint32_t num = _num & ~3; ii < num; ii += 4)
+			{
+				const uint8_t v0 = uint8_t(_viewRemap[view[0*_stride] ]);
+				const uint8_t v1 = uint8_t(_viewRemap[view[1*_stride] ]);
+				const uint8_t v2 = uint8_t(_viewRemap[view[2*_stride] ]);
+				const uint8_t v3 = uint8_t(_viewRemap[view[3*_stride] ]);
+				view[0*_stride] = v0;
+				view[1*_stride] = v1;
+				view[2*_stride] = v2;
+				view[3*_stride] = v3;
+				view += 4*_stride;
+			}
+
+			for (; ii < _num; ++ii)
+			{
+				view[0] = uint8_t(_viewRemap[view[0] ]);
+				view += _stride;
+			}
+		}
+
+		static bool isViewRemapIdentity(const ViewId _viewRemap[BGFX_CONFIG_MAX_VIEWS])
+		{
+			for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+			{
+				if (ii != _viewRemap[ii])
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
 		void reset()
 		{
 			m_depth       = 0;
@@ -1437,6 +1524,21 @@ namespace bgfx
 			return key;
 		}
 
+		static void remapView(KeyT* _keys, uint32_t _num, ViewId _viewRemap[BGFX_CONFIG_MAX_VIEWS])
+		{
+			if (BX_ENABLED(BX_CPU_ENDIAN_LITTLE)
+			&&  8 == kSortKeyViewNumBits)
+			{
+				SortKey::remapViewByte(reinterpret_cast<uint8_t*>(_keys) + sizeof(KeyT) - 1, sizeof(KeyT), _num, _viewRemap);
+				return;
+			}
+
+			for (uint32_t ii = 0; ii < _num; ++ii)
+			{
+				_keys[ii] = remapView(_keys[ii], _viewRemap);
+			}
+		}
+
 		uint16_t m_item;
 		ViewId   m_view;
 	};
@@ -1468,11 +1570,26 @@ namespace bgfx
 	struct MatrixCache
 	{
 		MatrixCache()
-			: m_num(1)
+			: m_cache(NULL)
+			, m_capacity(0)
+			, m_num(1)
+		{
+		}
+
+		void create(uint32_t _capacity)
 		{
+			m_cache    = (Matrix4*)bx::alloc(g_allocator, sizeof(Matrix4)*_capacity);
+			m_capacity = _capacity;
 			m_cache[0].setIdentity();
 		}
 
+		void destroy()
+		{
+			bx::free(g_allocator, m_cache);
+			m_cache    = NULL;
+			m_capacity = 0;
+		}
+
 		void reset()
 		{
 			m_num = 1;
@@ -1481,9 +1598,9 @@ namespace bgfx
 		uint32_t reserve(uint16_t* _num)
 		{
 			uint32_t num = *_num;
-			uint32_t first = bx::atomicFetchAndAddsat<uint32_t>(&m_num, num, BGFX_CONFIG_MAX_MATRIX_CACHE - 1);
-			BX_WARN(first+num < BGFX_CONFIG_MAX_MATRIX_CACHE, "Matrix cache overflow. %d (max: %d)", first+num, BGFX_CONFIG_MAX_MATRIX_CACHE);
-			num = bx::min(num, BGFX_CONFIG_MAX_MATRIX_CACHE-1-first);
+			uint32_t first = bx::atomicFetchAndAddsat<uint32_t>(&m_num, num, m_capacity - 1);
+			BX_WARN(first+num < m_capacity, "Matrix cache overflow. %d (max: %d)", first+num, m_capacity);
+			num = bx::min(num, m_capacity-1-first);
 			*_num = bx::narrowCast<uint16_t>(num);
 			return first;
 		}
@@ -1502,9 +1619,9 @@ namespace bgfx
 
 		float* toPtr(uint32_t _cacheIdx)
 		{
-			BX_ASSERT(_cacheIdx < BGFX_CONFIG_MAX_MATRIX_CACHE, "Matrix cache out of bounds index %d (max: %d)"
+			BX_ASSERT(_cacheIdx < m_capacity, "Matrix cache out of bounds index %d (max: %d)"
 				, _cacheIdx
-				, BGFX_CONFIG_MAX_MATRIX_CACHE
+				, m_capacity
 				);
 			return m_cache[_cacheIdx].un.val;
 		}
@@ -1514,7 +1631,8 @@ namespace bgfx
 			return uint32_t( (const Matrix4*)_ptr - m_cache);
 		}
 
-		Matrix4 m_cache[BGFX_CONFIG_MAX_MATRIX_CACHE];
+		Matrix4* m_cache;
+		uint32_t m_capacity;
 		uint32_t m_num;
 	};
 
@@ -1658,6 +1776,16 @@ namespace bgfx
 			return result;
 		}
 
+		bool isEqual(uint32_t _posA, uint32_t _posB, uint32_t _size) const
+		{
+			return 0 == bx::memCmp(&m_buffer[_posA], &m_buffer[_posB], _size);
+		}
+
+		const char* getData() const
+		{
+			return m_buffer;
+		}
+
 		bool isEmpty() const
 		{
 			return 0 == m_pos;
@@ -2315,6 +2443,8 @@ namespace bgfx
 		uint32_t offset;
 		uint16_t size;
 		int16_t  refCount;
+		uint32_t frameOffset;
+		uint32_t frameNum;
 	};
 
 	struct UniformCacheFrame
@@ -2328,6 +2458,7 @@ namespace bgfx
 			, m_numItems(0)
 			, m_keysCapacity(kMinKeysCapacity)
 			, m_dataCapacity(kMinDataCapacity)
+			, m_sorted(false)
 		{
 			m_keys = (UniformCacheKey::KeyT*)bx::alloc(g_allocator, m_keysCapacity*sizeof(uint64_t) );
 			m_data = (uint8_t*)bx::alloc(g_allocator, m_dataCapacity);
@@ -2364,6 +2495,11 @@ namespace bgfx
 
 		void sort(ViewId* _viewRemap, uint64_t* _tempKeys)
 		{
+			if (m_sorted)
+			{
+				return;
+			}
+
 			for (uint32_t ii = 0, num = m_numItems; ii < num; ++ii)
 			{
 				m_keys[ii] = UniformCacheKey::remapView(m_keys[ii], _viewRemap);
@@ -2377,6 +2513,7 @@ namespace bgfx
 		uint32_t  m_numItems;
 		uint32_t  m_keysCapacity;
 		uint32_t  m_dataCapacity;
+		bool      m_sorted; //!< Keys are already remapped and in physical view order.
 	};
 
 	struct FrameCache
@@ -2409,36 +2546,338 @@ namespace bgfx
 		FrameBufferHandle handle;
 	};
 
+	// Sort keys submitted by single encoder. Run is sorted on submitting thread when encoder
+	// ends, and render thread only merges runs of all encoders together.
+	struct SortKeyRun
+	{
+		static constexpr uint32_t kMinCapacity = 1<<10;
+
+		SortKeyRun()
+			: m_keys(NULL)
+			, m_tempKeys(NULL)
+			, m_values(NULL)
+			, m_tempValues(NULL)
+			, m_num(0)
+			, m_capacity(0)
+			, m_pos(0)
+		{
+		}
+
+		~SortKeyRun()
+		{
+			bx::free(g_allocator, m_keys);
+			bx::free(g_allocator, m_tempKeys);
+			bx::free(g_allocator, m_values);
+			bx::free(g_allocator, m_tempValues);
+		}
+
+		void reset()
+		{
+			m_num = 0;
+		}
+
+		void add(uint64_t _key, RenderItemCount _value)
+		{
+			if (m_num == m_capacity)
+			{
+				resize(bx::max(m_capacity*2, kMinCapacity) );
+			}
+
+			m_keys[m_num]   = _key;
+			m_values[m_num] = _value;
+			++m_num;
+		}
+
+		void resize(uint32_t _capacity)
+		{
+			m_keys   = (uint64_t*)bx::realloc(g_allocator, m_keys, _capacity*sizeof(uint64_t) );
+			m_values = (RenderItemCount*)bx::realloc(g_allocator, m_values, _capacity*sizeof(RenderItemCount) );
+
+			// Temp buffers content doesn't need to be preserved.
+			bx::free(g_allocator, m_tempKeys);
+			bx::free(g_allocator, m_tempValues);
+			m_tempKeys   = (uint64_t*)bx::alloc(g_allocator, _capacity*sizeof(uint64_t) );
+			m_tempValues = (RenderItemCount*)bx::alloc(g_allocator, _capacity*sizeof(RenderItemCount) );
+
+			m_capacity = _capacity;
+		}
+
+		void sort()
+		{
+			if (0 < m_num)
+			{
+				bx::radixSort(m_keys, m_tempKeys, m_values, m_tempValues, m_num);
+			}
+
+			// Remember where each view begins, so that render thread can merge runs view by view
+			// after view remap, without searching for view boundaries.
+			uint32_t view = 0;
+			for (uint32_t ii = 0, num = m_num; ii < num; ++ii)
+			{
+				const ViewId id = SortKey::decodeView(m_keys[ii]);
+				for (; view <= id; ++view)
+				{
+					m_viewOffset[view] = ii;
+				}
+			}
+
+			for (; view <= BGFX_CONFIG_MAX_VIEWS; ++view)
+			{
+				m_viewOffset[view] = m_num;
+			}
+		}
+
+		uint64_t*        m_keys;
+		uint64_t*        m_tempKeys;
+		RenderItemCount* m_values;
+		RenderItemCount* m_tempValues;
+		uint32_t         m_num;
+		uint32_t         m_capacity;
+		uint32_t         m_pos;
+		uint32_t         m_viewOffset[BGFX_CONFIG_MAX_VIEWS+1];
+	};
+
+	// Render items are stored in fixed size pages, allocated on demand by the submitting
+	// threads. Already allocated pages never move, so encoders can keep writing into them while
+	// other encoders are adding new pages.
+	BX_ALIGN_DECL_CACHE_LINE(struct) RenderItemPage
+	{
+		static constexpr uint32_t kShift = 10;
+		static constexpr uint32_t kNum   = 1<<kShift;
+		static constexpr uint32_t kMask  = kNum-1;
+
+		RenderItem m_renderItem[kNum];
+		RenderBind m_renderItemBind[kNum];
+		uint64_t   m_sortKey[kNum];
+	};
+
+	// Range of render items reserved by encoder. Encoders reserve render items in chunks, so that
+	// submitting draw call doesn't touch shared frame state.
+	struct RenderItemChunk
+	{
+		static constexpr uint32_t kNum = 64;
+		static_assert(0 == RenderItemPage::kNum % kNum, "Render item chunk must not cross page.");
+
+		uint32_t m_begin;
+		uint32_t m_num;
+	};
+
+	// Range of transient vertex or index buffer reserved by encoder. Encoders sub-allocate small
+	// transient buffers from their own chunk, and only reserving chunk touches shared frame state.
+	struct TransientChunk
+	{
+		static constexpr uint32_t kVertexBufferSize = 64<<10;
+		static constexpr uint32_t kIndexBufferSize  = 16<<10;
+
+		void reset()
+		{
+			m_pos = 0;
+			m_end = 0;
+		}
+
+		// Chunk never crosses transient buffer page, offsets are aligned to stride within page.
+		uint32_t getAvail(uint32_t _num, uint16_t _stride, uint32_t _pageSize, uint32_t& _outOffset) const
+		{
+			const uint32_t pageStart = m_pos - m_pos % _pageSize;
+			_outOffset = pageStart + bx::strideAlign(m_pos - pageStart, _stride);
+
+			return m_end > _outOffset
+				? bx::min(_num, (m_end - _outOffset)/_stride)
+				: 0
+				;
+		}
+
+		uint32_t m_pos;
+		uint32_t m_end;
+	};
+
+	// Bump allocator for render thread scratch memory that is used only while frame is rendered
+	// (texture update conversion buffers, etc.). Free is no-op, all memory is released at once by
+	// reset() after frame is rendered. Allocations that don't fit go to heap, and arena is grown on
+	// next reset, so that steady state frames don't touch heap.
+	class FrameArena : public bx::AllocatorI
+	{
+	public:
+		static constexpr uint32_t kAlign = 16;
+
+		FrameArena()
+			: m_data(NULL)
+			, m_overflow(NULL)
+			, m_size(BGFX_CONFIG_FRAME_ARENA_SIZE)
+			, m_pos(0)
+			, m_overflowSize(0)
+			, m_numAllocs(0)
+		{
+		}
+
+		virtual ~FrameArena()
+		{
+		}
+
+		virtual void* realloc(void* _ptr, size_t _size, size_t _align, const char* /*_file*/, uint32_t /*_line*/) override
+		{
+			if (0 == _size)
+			{
+				return NULL;
+			}
+
+			void* ptr = alloc(uint32_t(_size), uint32_t(bx::max<size_t>(_align, kAlign) ) );
+
+			if (NULL != _ptr)
+			{
+				bx::memCopy(ptr, _ptr, bx::min(getSize(_ptr), uint32_t(_size) ) );
+			}
+
+			return ptr;
+		}
+
+		void reset()
+		{
+			if (NULL != m_overflow)
+			{
+				freeOverflow();
+
+				bx::free(g_allocator, m_data);
+				m_data = NULL;
+				m_size = bx::max(m_size + m_size/2, m_pos + m_overflowSize);
+			}
+
+			m_pos          = 0;
+			m_overflowSize = 0;
+			m_numAllocs    = 0;
+		}
+
+		void destroy()
+		{
+			freeOverflow();
+
+			bx::free(g_allocator, m_data);
+			m_data = NULL;
+			m_pos  = 0;
+		}
+
+		uint32_t getNumAllocs() const
+		{
+			return m_numAllocs;
+		}
+
+		uint32_t getUsed() const
+		{
+			return m_pos + m_overflowSize;
+		}
+
+	private:
+		struct Overflow
+		{
+			Overflow* next;
+		};
+
+		static uint32_t& getSize(void* _ptr)
+		{
+			return ( (uint32_t*)_ptr)[-1];
+		}
+
+		void* alloc(uint32_t _size, uint32_t _align)
+		{
+			++m_numAllocs;
+
+			if (NULL == m_data)
+			{
+				m_data = (uint8_t*)bx::alloc(g_allocator, m_size);
+			}
+
+			// Size of allocation is kept right before returned pointer, for realloc.
+			uint8_t* ptr = bx::alignUp(&m_data[m_pos] + sizeof(uint32_t), _align);
+
+			if (ptr + _size <= &m_data[m_size])
+			{
+				m_pos = uint32_t(ptr + _size - m_data);
+				getSize(ptr) = _size;
+				return ptr;
+			}
+
+			const uint32_t size = sizeof(Overflow) + sizeof(uint32_t) + _align + _size;
+			Overflow* overflow = (Overflow*)bx::alloc(g_allocator, size);
+			overflow->next = m_overflow;
+			m_overflow     = overflow;
+			m_overflowSize += size;
+
+			ptr = bx::alignUp( (uint8_t*)overflow + sizeof(Overflow) + sizeof(uint32_t), _align);
+			getSize(ptr) = _size;
+			return ptr;
+		}
+
+		void freeOverflow()
+		{
+			while (NULL != m_overflow)
+			{
+				Overflow* next = m_overflow->next;
+				bx::free(g_allocator, m_overflow);
+				m_overflow = next;
+			}
+		}
+
+		uint8_t*  m_data;
+		Overflow* m_overflow;
+		uint32_t  m_size;
+		uint32_t  m_pos;
+		uint32_t  m_overflowSize;
+		uint32_t  m_numAllocs;
+	};
+
 	BX_ALIGN_DECL_CACHE_LINE(struct) Frame
 	{
+		// Pages above high-water mark are released after being unused for this many frames.
+		static constexpr uint32_t kRenderItemPageTrimFrames = 120;
+		static constexpr uint32_t kMinSortCapacity          = RenderItemPage::kNum;
+
 		Frame()
-			: m_waitSubmit(0)
+			: m_sortKeys(NULL)
+			, m_sortValues(NULL)
+			, m_tempKeys(NULL)
+			, m_tempValues(NULL)
+			, m_sortCapacity(0)
+			, m_renderItemPage(NULL)
+			, m_numRenderItemPages(0)
+			, m_renderItemPageHighWater(0)
+			, m_renderItemPageFrames(0)
+			, m_renderItemChunk(NULL)
+			, m_numRenderItemChunks(0)
+			, m_numRenderItemsReserved(0)
+			, m_numRenderItems(0)
+			, m_transientIbMax(0)
+			, m_transientVbMax(0)
+			, m_transientIbHighWater(0)
+			, m_transientVbHighWater(0)
+			, m_transientTrimFrames(0)
+			, m_waitSubmit(0)
 			, m_waitRender(0)
 			, m_frameNum(0)
+			, m_sortKeyRun(NULL)
+			, m_numSortKeyRuns(0)
 			, m_capture(false)
 			, m_flush(false)
+			, m_sorted(false)
 		{
-			SortKey term;
-			term.reset();
-			term.m_program = BGFX_INVALID_HANDLE;
-			m_sortKeys[BGFX_CONFIG_MAX_DRAW_CALLS]   = term.encodeDraw(SortKey::SortProgram);
-			m_sortValues[BGFX_CONFIG_MAX_DRAW_CALLS] = BGFX_CONFIG_MAX_DRAW_CALLS;
 			bx::memSet(m_occlusion, 0xff, sizeof(m_occlusion) );
+			bx::memSet(m_transientIb, 0, sizeof(m_transientIb) );
+			bx::memSet(m_transientVb, 0, sizeof(m_transientVb) );
 
 			m_perfStats.viewStats = m_viewStats;
-
-			bx::memSet(&m_renderItemBind[0], 0, sizeof(m_renderItemBind) );
 		}
 
 		~Frame()
 		{
 		}
 
-		void create(uint32_t _minResourceCbSize)
+		void create(uint32_t _minResourceCbSize, bool _parallelSort)
 		{
 			m_cmdPre.init(_minResourceCbSize);
 			m_cmdPost.init(_minResourceCbSize);
 
+			m_transientIbMax = getTransientMax(g_caps.limits.maxTransientIbSize);
+			m_transientVbMax = getTransientMax(g_caps.limits.maxTransientVbSize);
+
 			{
 				const uint32_t num = g_caps.limits.maxEncoders;
 
@@ -2450,6 +2889,34 @@ namespace bgfx
 				}
 			}
 
+			// Each draw call may reference its own transform, BGFX_CONFIG_MAX_MATRIX_CACHE is minimum.
+			m_frameCache.m_matrixCache.create(bx::max<uint32_t>(BGFX_CONFIG_MAX_MATRIX_CACHE, g_caps.limits.maxDrawCalls+1) );
+
+			{
+				const uint32_t num = (g_caps.limits.maxDrawCalls + RenderItemPage::kMask) >> RenderItemPage::kShift;
+
+				m_renderItemPage = (RenderItemPage**)bx::alloc(g_allocator, sizeof(RenderItemPage*)*num);
+				bx::memSet(m_renderItemPage, 0, sizeof(RenderItemPage*)*num);
+				m_numRenderItemPages = num;
+
+				m_renderItemChunk = (RenderItemChunk*)bx::alloc(g_allocator
+					, sizeof(RenderItemChunk)*( (g_caps.limits.maxDrawCalls + RenderItemChunk::kNum - 1) / RenderItemChunk::kNum)
+					);
+			}
+
+			if (_parallelSort)
+			{
+				const uint32_t num = g_caps.limits.maxEncoders;
+
+				m_sortKeyRun = (SortKeyRun*)bx::alloc(g_allocator, sizeof(SortKeyRun)*num);
+				m_numSortKeyRuns = uint16_t(num);
+
+				for (uint32_t ii = 0; ii < num; ++ii)
+				{
+					BX_PLACEMENT_NEW(&m_sortKeyRun[ii], SortKeyRun);
+				}
+			}
+
 			reset();
 			start(0);
 			m_textVideoMem = BX_NEW(g_allocator, TextVideoMem);
@@ -2463,7 +2930,31 @@ namespace bgfx
 			}
 
 			bx::free(g_allocator, m_uniformBuffer);
+
+			freeRenderItemPages(0);
+			bx::free(g_allocator, m_renderItemPage);
+			m_renderItemPage     = NULL;
+			m_numRenderItemPages = 0;
+
+			bx::free(g_allocator, m_renderItemChunk);
+			m_renderItemChunk = NULL;
+
+			m_frameCache.m_matrixCache.destroy();
+
+			resizeSort(0);
+
+			for (uint32_t ii = 0, num = m_numSortKeyRuns; ii < num; ++ii)
+			{
+				m_sortKeyRun[ii].~SortKeyRun();
+			}
+
+			bx::free(g_allocator, m_sortKeyRun);
+			m_sortKeyRun     = NULL;
+			m_numSortKeyRuns = 0;
+
 			bx::deleteObject(g_allocator, m_textVideoMem);
+
+			m_frameArena.destroy();
 		}
 
 		void reset()
@@ -2478,15 +2969,25 @@ namespace bgfx
 			m_perfStats.transientVbUsed = m_vboffset;
 			m_perfStats.transientIbUsed = m_iboffset;
 
+			m_transientVbHighWater = bx::max(m_transientVbHighWater, m_vboffset);
+			m_transientIbHighWater = bx::max(m_transientIbHighWater, m_iboffset);
+			m_perfStats.transientVbHighWater = m_transientVbHighWater;
+			m_perfStats.transientIbHighWater = m_transientIbHighWater;
+			++m_transientTrimFrames;
+
+			trimRenderItemPages();
+
 			m_frameCache.reset();
-			m_numRenderItems = 0;
+			resetRenderItems();
 			m_numBlitItems   = 0;
+			resetSortKeyRuns();
 			m_iboffset = 0;
 			m_vboffset = 0;
 			m_cmdPre.start();
 			m_cmdPost.start();
 			m_capture = false;
 			m_flush   = false;
+			m_sorted  = false;
 			m_numScreenShots = 0;
 			m_frameNum = frameNum;
 		}
@@ -2499,42 +3000,286 @@ namespace bgfx
 
 		void sort();
 
-		uint32_t getAvailTransientIndexBuffer(uint32_t _num, uint16_t _indexSize)
-		{
-			const uint32_t offset = bx::strideAlign(m_iboffset, _indexSize);
-			uint32_t iboffset = offset + _num*_indexSize;
-			iboffset = bx::min<uint32_t>(iboffset, g_caps.limits.maxTransientIbSize);
-			const uint32_t num = (iboffset-offset)/_indexSize;
-			return num;
-		}
+		void mergeSortKeyRuns(const ViewId* _viewRemap);
 
-		uint32_t allocTransientIndexBuffer(uint32_t& _num, uint16_t _indexSize)
+		RenderItemPage* getRenderItemPage(uint32_t _idx)
 		{
-			uint32_t offset = bx::strideAlign(m_iboffset, _indexSize);
-			uint32_t num    = getAvailTransientIndexBuffer(_num, _indexSize);
-			m_iboffset = offset + num*_indexSize;
-			_num = num;
+			// Other encoder threads can read page without lock, so it's published with release
+			// store only after it's fully initialized.
+			void* volatile* slot = (void* volatile*)&m_renderItemPage[_idx >> RenderItemPage::kShift];
 
-			return offset;
+			RenderItemPage* page = (RenderItemPage*)bx::atomicLoadPtr(slot);
+
+			if (BX_UNLIKELY(NULL == page) )
+			{
+				bx::MutexScope scope(m_renderItemPageLock);
+
+				page = (RenderItemPage*)bx::atomicLoadPtr(slot);
+
+				if (NULL == page)
+				{
+					page = (RenderItemPage*)bx::alignedAlloc(g_allocator, sizeof(RenderItemPage), BX_ALIGNOF(RenderItemPage) );
+
+					// Bind is hashed by renderers, padding must be deterministic.
+					bx::memSet(page->m_renderItemBind, 0, sizeof(page->m_renderItemBind) );
+
+					bx::atomicStorePtr(slot, page);
+				}
+			}
+
+			return page;
 		}
 
-		uint32_t getAvailTransientVertexBuffer(uint32_t _num, uint16_t _stride)
+		RenderItem& getRenderItem(uint32_t _idx) const
 		{
-			uint32_t offset   = bx::strideAlign(m_vboffset, _stride);
-			uint32_t vboffset = offset + _num * _stride;
-			vboffset = bx::min<uint32_t>(vboffset, g_caps.limits.maxTransientVbSize);
-			uint32_t num = (vboffset-offset)/_stride;
-			return num;
+			return m_renderItemPage[_idx >> RenderItemPage::kShift]->m_renderItem[_idx & RenderItemPage::kMask];
 		}
 
-		uint32_t allocTransientVertexBuffer(uint32_t& _num, uint16_t _stride)
+		RenderBind& getRenderItemBind(uint32_t _idx) const
 		{
-			uint32_t offset = bx::strideAlign(m_vboffset, _stride);
-			uint32_t num    = getAvailTransientVertexBuffer(_num, _stride);
-			m_vboffset = offset + num * _stride;
-			_num = num;
+			return m_renderItemPage[_idx >> RenderItemPage::kShift]->m_renderItemBind[_idx & RenderItemPage::kMask];
+		}
 
-			return offset;
+		// Reserves up to RenderItemChunk::kNum render items. Returns number of reserved items,
+		// zero when frame is out of render items.
+		uint32_t reserveRenderItems(uint32_t& _outBegin)
+		{
+			const uint32_t maxDrawCalls = g_caps.limits.maxDrawCalls;
+			const uint32_t begin = bx::atomicFetchAndAddsat<uint32_t>(&m_numRenderItemsReserved, RenderItemChunk::kNum, maxDrawCalls);
+
+			_outBegin = begin;
+			return begin < maxDrawCalls
+				? bx::min(RenderItemChunk::kNum, maxDrawCalls - begin)
+				: 0
+				;
+		}
+
+		// Publishes render items written by encoder into reserved range.
+		void commitRenderItems(uint32_t _begin, uint32_t _num)
+		{
+			const uint32_t idx = bx::atomicFetchAndAdd<uint32_t>(&m_numRenderItemChunks, 1);
+
+			RenderItemChunk& chunk = m_renderItemChunk[idx];
+			chunk.m_begin = _begin;
+			chunk.m_num   = _num;
+
+			bx::atomicFetchAndAdd<uint32_t>(&m_numRenderItems, _num);
+		}
+
+		void resetRenderItems()
+		{
+			m_numRenderItems         = 0;
+			m_numRenderItemChunks    = 0;
+			m_numRenderItemsReserved = 0;
+		}
+
+		void freeRenderItemPages(uint32_t _first)
+		{
+			for (uint32_t ii = _first, num = m_numRenderItemPages; ii < num; ++ii)
+			{
+				if (NULL != m_renderItemPage[ii])
+				{
+					bx::alignedFree(g_allocator, m_renderItemPage[ii], BX_ALIGNOF(RenderItemPage) );
+					m_renderItemPage[ii] = NULL;
+				}
+			}
+		}
+
+		void trimRenderItemPages()
+		{
+			const uint32_t numUsed = (m_numRenderItemsReserved + RenderItemPage::kMask) >> RenderItemPage::kShift;
+			m_renderItemPageHighWater = bx::max(m_renderItemPageHighWater, numUsed);
+
+			if (++m_renderItemPageFrames < kRenderItemPageTrimFrames)
+			{
+				return;
+			}
+
+			freeRenderItemPages(m_renderItemPageHighWater);
+
+			const uint32_t sortCapacity = bx::max(m_renderItemPageHighWater << RenderItemPage::kShift, kMinSortCapacity);
+			if (sortCapacity < m_sortCapacity)
+			{
+				resizeSort(sortCapacity);
+			}
+
+			m_renderItemPageHighWater = 0;
+			m_renderItemPageFrames    = 0;
+		}
+
+		void resizeSort(uint32_t _capacity)
+		{
+			if (0 == _capacity)
+			{
+				bx::free(g_allocator, m_sortKeys);
+				bx::free(g_allocator, m_sortValues);
+				bx::free(g_allocator, m_tempKeys);
+				bx::free(g_allocator, m_tempValues);
+				m_sortKeys   = NULL;
+				m_sortValues = NULL;
+				m_tempKeys   = NULL;
+				m_tempValues = NULL;
+			}
+			else
+			{
+				m_sortKeys   = (uint64_t*)bx::realloc(g_allocator, m_sortKeys, _capacity*sizeof(uint64_t) );
+				m_sortValues = (RenderItemCount*)bx::realloc(g_allocator, m_sortValues, _capacity*sizeof(RenderItemCount) );
+				m_tempKeys   = (uint64_t*)bx::realloc(g_allocator, m_tempKeys, _capacity*sizeof(uint64_t) );
+				m_tempValues = (RenderItemCount*)bx::realloc(g_allocator, m_tempValues, _capacity*sizeof(RenderItemCount) );
+			}
+
+			m_sortCapacity = _capacity;
+		}
+
+		void resetSortKeyRuns()
+		{
+			for (uint32_t ii = 0, num = m_numSortKeyRuns; ii < num; ++ii)
+			{
+				m_sortKeyRun[ii].reset();
+			}
+		}
+
+		// Transient buffer is made of pages, each page is separate GPU buffer of page size. Offsets
+		// are virtual, page index is offset divided by page size, and allocation never crosses page.
+		// Returns number of available elements and sets _outOffset to where they start.
+		static uint32_t getAvailTransient(uint32_t _offset, uint32_t _num, uint16_t _stride, uint32_t _pageSize, uint32_t _max, uint32_t& _outOffset)
+		{
+			_outOffset = _offset;
+
+			if (_offset >= _max)
+			{
+				return 0;
+			}
+
+			const uint32_t pageStart = _offset - _offset % _pageSize;
+			const uint32_t pageEnd   = pageStart + _pageSize;
+			const uint32_t offset    = pageStart + bx::strideAlign(_offset - pageStart, _stride);
+			const uint32_t num       = bx::min(_num, _pageSize/_stride);
+			const uint32_t avail     = pageEnd > offset ? (pageEnd - offset)/_stride : 0;
+
+			if (avail < num
+			&&  pageEnd < _max)
+			{
+				// Doesn't fit into rest of page, continue at start of next page.
+				_outOffset = pageEnd;
+				return num;
+			}
+
+			_outOffset = offset;
+			return bx::min(num, avail);
+		}
+
+		// Transient buffer offsets are bumped atomically, since encoders reserve transient chunks
+		// without holding resource API lock. Offset is never advanced into page that isn't created
+		// yet, instead nothing is reserved and _outPage is set to page caller must create before
+		// retrying. Otherwise _outPage is UINT32_MAX.
+		static uint32_t allocTransient(uint32_t* _offset, uint32_t& _num, uint16_t _stride, uint32_t _pageSize, uint32_t _max, void* volatile* _pages, uint32_t& _outPage)
+		{
+			_outPage = UINT32_MAX;
+
+			uint32_t current = *(volatile uint32_t*)_offset;
+
+			for (;;)
+			{
+				uint32_t offset;
+				const uint32_t num = getAvailTransient(current, _num, _stride, _pageSize, _max, offset);
+
+				if (0 != num
+				&&  NULL == bx::atomicLoadPtr(&_pages[offset/_pageSize]) )
+				{
+					_outPage = offset/_pageSize;
+					_num     = 0;
+					return offset;
+				}
+
+				const uint32_t next = 0 == num ? current : offset + num*_stride;
+
+				const uint32_t prev = bx::atomicCompareAndSwap<uint32_t>(_offset, current, next);
+				if (prev == current)
+				{
+					_num = num;
+					return offset;
+				}
+
+				current = prev;
+			}
+		}
+
+		// Reserves up to _size bytes within single page for encoder's transient chunk. Returns false
+		// when transient buffer is full, or when page must be created first (see allocTransient).
+		static bool reserveTransient(uint32_t* _offset, uint32_t _size, uint32_t _pageSize, uint32_t _max, void* volatile* _pages, TransientChunk& _outChunk, uint32_t& _outPage)
+		{
+			uint32_t size = _size;
+			const uint32_t begin = allocTransient(_offset, size, 1, _pageSize, _max, _pages, _outPage);
+
+			_outChunk.m_pos = begin;
+			_outChunk.m_end = begin + size;
+
+			return 0 != size;
+		}
+
+		// Virtual size of all transient buffer pages, end of last page must fit into 32-bit offset.
+		static uint32_t getTransientMax(uint32_t _pageSize)
+		{
+			const uint32_t maxPages = bx::min<uint32_t>(BGFX_CONFIG_MAX_TRANSIENT_BUFFER_PAGES, UINT32_MAX/_pageSize - 1);
+			return bx::max<uint32_t>(maxPages, 1) * _pageSize;
+		}
+
+		static uint32_t getNumTransientPages(uint32_t _offset, uint32_t _pageSize)
+		{
+			return (_offset + _pageSize - 1) / _pageSize;
+		}
+
+		static uint32_t getTransientPageUsed(uint32_t _offset, uint32_t _pageSize, uint32_t _page)
+		{
+			const uint32_t pageStart = _page*_pageSize;
+			return _offset > pageStart
+				? bx::min(_offset - pageStart, _pageSize)
+				: 0
+				;
+		}
+
+		uint32_t getAvailTransientIndexBuffer(uint32_t _num, uint16_t _indexSize)
+		{
+			uint32_t offset;
+			return getAvailTransient(m_iboffset, _num, _indexSize, g_caps.limits.maxTransientIbSize, m_transientIbMax, offset);
+		}
+
+		uint32_t allocTransientIndexBuffer(uint32_t& _num, uint16_t _indexSize, uint32_t& _outPage)
+		{
+			return allocTransient(&m_iboffset, _num, _indexSize, g_caps.limits.maxTransientIbSize, m_transientIbMax, (void* volatile*)m_transientIb, _outPage);
+		}
+
+		uint32_t getAvailTransientVertexBuffer(uint32_t _num, uint16_t _stride)
+		{
+			uint32_t offset;
+			return getAvailTransient(m_vboffset, _num, _stride, g_caps.limits.maxTransientVbSize, m_transientVbMax, offset);
+		}
+
+		uint32_t allocTransientVertexBuffer(uint32_t& _num, uint16_t _stride, uint32_t& _outPage)
+		{
+			return allocTransient(&m_vboffset, _num, _stride, g_caps.limits.maxTransientVbSize, m_transientVbMax, (void* volatile*)m_transientVb, _outPage);
+		}
+
+		// Number of transient buffer pages used by frame. Renderers update used part of each page.
+		uint32_t getNumTransientIbPages() const
+		{
+			return getNumTransientPages(m_iboffset, g_caps.limits.maxTransientIbSize);
+		}
+
+		uint32_t getTransientIbPageUsed(uint32_t _page) const
+		{
+			return getTransientPageUsed(m_iboffset, g_caps.limits.maxTransientIbSize, _page);
+		}
+
+		uint32_t getNumTransientVbPages() const
+		{
+			return getNumTransientPages(m_vboffset, g_caps.limits.maxTransientVbSize);
+		}
+
+		uint32_t getTransientVbPageUsed(uint32_t _page) const
+		{
+			return getTransientPageUsed(m_vboffset, g_caps.limits.maxTransientVbSize, _page);
 		}
 
 		bool free(IndexBufferHandle _handle)
@@ -2596,10 +3341,21 @@ namespace bgfx
 
 		int32_t m_occlusion[BGFX_CONFIG_MAX_OCCLUSION_QUERIES];
 
-		uint64_t m_sortKeys[BGFX_CONFIG_MAX_DRAW_CALLS+1];
-		RenderItemCount m_sortValues[BGFX_CONFIG_MAX_DRAW_CALLS+1];
-		RenderItem m_renderItem[BGFX_CONFIG_MAX_DRAW_CALLS+1];
-		RenderBind m_renderItemBind[BGFX_CONFIG_MAX_DRAW_CALLS + 1];
+		uint64_t*        m_sortKeys;
+		RenderItemCount* m_sortValues;
+		uint64_t*        m_tempKeys;
+		RenderItemCount* m_tempValues;
+		uint32_t         m_sortCapacity;
+
+		RenderItemPage** m_renderItemPage;
+		uint32_t         m_numRenderItemPages;
+		uint32_t         m_renderItemPageHighWater;
+		uint32_t         m_renderItemPageFrames;
+		bx::Mutex        m_renderItemPageLock;
+
+		RenderItemChunk* m_renderItemChunk;
+		uint32_t         m_numRenderItemChunks;
+		uint32_t         m_numRenderItemsReserved;
 
 		uint32_t m_blitKeys[BGFX_CONFIG_MAX_BLIT_ITEMS+1];
 		BlitItem m_blitItem[BGFX_CONFIG_MAX_BLIT_ITEMS+1];
@@ -2614,8 +3370,13 @@ namespace bgfx
 
 		uint32_t m_iboffset;
 		uint32_t m_vboffset;
-		TransientIndexBuffer* m_transientIb;
-		TransientVertexBuffer* m_transientVb;
+		uint32_t m_transientIbMax;
+		uint32_t m_transientVbMax;
+		uint32_t m_transientIbHighWater;
+		uint32_t m_transientVbHighWater;
+		uint32_t m_transientTrimFrames;
+		TransientIndexBuffer*  m_transientIb[BGFX_CONFIG_MAX_TRANSIENT_BUFFER_PAGES];
+		TransientVertexBuffer* m_transientVb[BGFX_CONFIG_MAX_TRANSIENT_BUFFER_PAGES];
 
 		Resolution m_resolution;
 		uint32_t m_debug;
@@ -2694,6 +3455,8 @@ namespace bgfx
 		TextVideoMem* m_textVideoMem;
 
 		Stats     m_perfStats;
+
+		FrameArena m_frameArena;
 		ViewStats m_viewStats[BGFX_CONFIG_MAX_VIEWS];
 
 		int64_t m_waitSubmit;
@@ -2701,8 +3464,12 @@ namespace bgfx
 
 		uint32_t m_frameNum;
 
+		SortKeyRun* m_sortKeyRun;
+		uint16_t    m_numSortKeyRuns;
+
 		bool m_capture;
 		bool m_flush;
+		bool m_sorted; //!< Sort keys are remapped and sorted, sort() does nothing until start().
 	};
 
 	BX_ALIGN_DECL_CACHE_LINE(struct) EncoderImpl
@@ -2716,6 +3483,7 @@ namespace bgfx
 			// clear all bytes (inclusively the padding) before we start.
 			bx::memSet(&m_bind, 0, sizeof(m_bind) );
 
+			m_ownerThread = NULL;
 			m_discard = false;
 			m_draw.clear(BGFX_DISCARD_ALL);
 			m_compute.clear(BGFX_DISCARD_ALL);
@@ -2731,21 +3499,41 @@ namespace bgfx
 			m_uniformIdx   = _idx;
 			m_uniformBegin = 0;
 			m_uniformEnd   = 0;
+			m_uniformPrevBegin  = 0;
+			m_uniformPrevEnd    = 0;
+			m_uniformBytesSaved = 0;
 
 			UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
 			uniformBuffer->reset();
 
+			m_renderItemBegin = 0;
+			m_renderItemPos   = 0;
+			m_renderItemEnd   = 0;
+			m_renderItemPage  = NULL;
+
 			m_numSubmitted = 0;
 			m_numDropped   = 0;
+
+			m_transientVb.reset();
+			m_transientIb.reset();
+			bx::memSet(m_vertexLayoutCache, 0xff, sizeof(m_vertexLayoutCache) );
+			m_vertexLayoutCacheIdx = 0;
 		}
 
 		void end(bool _finalize)
 		{
 			if (_finalize)
 			{
+				commitRenderItems();
+
 				UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
 				uniformBuffer->finish();
 
+				if (NULL != m_frame->m_sortKeyRun)
+				{
+					m_frame->m_sortKeyRun[m_uniformIdx].sort();
+				}
+
 				m_cpuTimeEnd = bx::getHPCounter();
 			}
 
@@ -2760,6 +3548,138 @@ namespace bgfx
 			}
 		}
 
+		// Returns index of next render item from encoder's reserved chunk, or UINT32_MAX when frame
+		// is out of render items.
+		uint32_t allocRenderItem()
+		{
+			if (BX_UNLIKELY(m_renderItemPos == m_renderItemEnd) )
+			{
+				commitRenderItems();
+
+				uint32_t begin;
+				const uint32_t num = m_frame->reserveRenderItems(begin);
+				if (0 == num)
+				{
+					return UINT32_MAX;
+				}
+
+				m_renderItemBegin = begin;
+				m_renderItemPos   = begin;
+				m_renderItemEnd   = begin + num;
+				m_renderItemPage  = m_frame->getRenderItemPage(begin);
+			}
+
+			return m_renderItemPos++;
+		}
+
+		void commitRenderItems()
+		{
+			if (m_renderItemBegin != m_renderItemPos)
+			{
+				m_frame->commitRenderItems(m_renderItemBegin, m_renderItemPos - m_renderItemBegin);
+				m_renderItemBegin = m_renderItemPos;
+			}
+		}
+
+		uint32_t getAvailTransientVertexBuffer(uint32_t _num, uint16_t _stride)
+		{
+			uint32_t offset;
+			const uint32_t num = m_transientVb.getAvail(_num, _stride, g_caps.limits.maxTransientVbSize, offset);
+			return num == _num
+				? num
+				: bx::max(num, m_frame->getAvailTransientVertexBuffer(_num, _stride) )
+				;
+		}
+
+		uint32_t allocTransientVertexBuffer(uint32_t& _num, uint16_t _stride, uint32_t& _outPage)
+		{
+			return allocTransient(
+				  m_transientVb
+				, &m_frame->m_vboffset
+				, TransientChunk::kVertexBufferSize
+				, g_caps.limits.maxTransientVbSize
+				, m_frame->m_transientVbMax
+				, (void* volatile*)m_frame->m_transientVb
+				, _num
+				, _stride
+				, _outPage
+				);
+		}
+
+		uint32_t getAvailTransientIndexBuffer(uint32_t _num, uint16_t _indexSize)
+		{
+			uint32_t offset;
+			const uint32_t num = m_transientIb.getAvail(_num, _indexSize, g_caps.limits.maxTransientIbSize, offset);
+			return num == _num
+				? num
+				: bx::max(num, m_frame->getAvailTransientIndexBuffer(_num, _indexSize) )
+				;
+		}
+
+		uint32_t allocTransientIndexBuffer(uint32_t& _num, uint16_t _indexSize, uint32_t& _outPage)
+		{
+			return allocTransient(
+				  m_transientIb
+				, &m_frame->m_iboffset
+				, TransientChunk::kIndexBufferSize
+				, g_caps.limits.maxTransientIbSize
+				, m_frame->m_transientIbMax
+				, (void* volatile*)m_frame->m_transientIb
+				, _num
+				, _indexSize
+				, _outPage
+				);
+		}
+
+		// Returns offset of transient buffer sub-allocated from encoder's chunk. Requests larger than
+		// half of chunk are allocated directly from frame, so they don't waste rest of chunk.
+		static uint32_t allocTransient(TransientChunk& _chunk, uint32_t* _offset, uint32_t _chunkSize, uint32_t _pageSize, uint32_t _max, void* volatile* _pages, uint32_t& _num, uint16_t _stride, uint32_t& _outPage)
+		{
+			_outPage = UINT32_MAX;
+
+			uint32_t offset;
+			while (_chunk.getAvail(_num, _stride, _pageSize, offset) != _num)
+			{
+				if (_num*_stride > bx::min(_chunkSize, _pageSize)/2)
+				{
+					return Frame::allocTransient(_offset, _num, _stride, _pageSize, _max, _pages, _outPage);
+				}
+
+				if (!Frame::reserveTransient(_offset, _chunkSize, _pageSize, _max, _pages, _chunk, _outPage) )
+				{
+					_num = 0;
+					return offset;
+				}
+			}
+
+			_chunk.m_pos = offset + _num*_stride;
+
+			return offset;
+		}
+
+		// Vertex layout handles stay valid until end of frame, so lookups done by this encoder are
+		// cached for frame to avoid taking resource API lock for every transient vertex buffer.
+		VertexLayoutHandle findVertexLayout(uint32_t _hash) const
+		{
+			for (uint32_t ii = 0; ii < BX_COUNTOF(m_vertexLayoutCache); ++ii)
+			{
+				if (_hash == m_vertexLayoutCache[ii].m_hash)
+				{
+					return m_vertexLayoutCache[ii].m_handle;
+				}
+			}
+
+			return BGFX_INVALID_HANDLE;
+		}
+
+		void addVertexLayout(uint32_t _hash, VertexLayoutHandle _handle)
+		{
+			VertexLayoutCacheEntry& entry = m_vertexLayoutCache[m_vertexLayoutCacheIdx];
+			entry.m_hash   = _hash;
+			entry.m_handle = _handle;
+			m_vertexLayoutCacheIdx = (m_vertexLayoutCacheIdx + 1) % BX_COUNTOF(m_vertexLayoutCache);
+		}
+
 		void setMarker(const bx::StringView& _name)
 		{
 			UniformBuffer::update(&m_frame->m_uniformBuffer[m_uniformIdx]);
@@ -2791,6 +3711,31 @@ namespace bgfx
 			uniformBuffer->writeUniform(_type, _handle.idx, _value, _num);
 		}
 
+		// When uniforms written since last draw are byte-identical to previous draw's uniforms, drop
+		// them and point draw at previous draw's range.
+		void dedupUniforms(UniformBuffer* _uniformBuffer)
+		{
+			const uint32_t size = m_uniformEnd - m_uniformBegin;
+			if (0 == size)
+			{
+				return;
+			}
+
+			if (m_uniformPrevEnd == m_uniformBegin
+			&&  m_uniformPrevEnd - m_uniformPrevBegin == size
+			&&  _uniformBuffer->isEqual(m_uniformPrevBegin, m_uniformBegin, size) )
+			{
+				_uniformBuffer->reset(m_uniformBegin);
+				m_uniformBegin = m_uniformPrevBegin;
+				m_uniformEnd   = m_uniformPrevEnd;
+				m_uniformBytesSaved += size;
+				return;
+			}
+
+			m_uniformPrevBegin = m_uniformBegin;
+			m_uniformPrevEnd   = m_uniformEnd;
+		}
+
 		void setState(uint64_t _state, uint32_t _rgba)
 		{
 			const uint8_t blend =     ( (_state&BGFX_STATE_BLEND_MASK    )>>BGFX_STATE_BLEND_SHIFT    )&0xff;
@@ -2861,12 +3806,13 @@ namespace bgfx
 
 		void setTransform(uint32_t _cache, uint16_t _num)
 		{
-			BX_ASSERT(_cache < BGFX_CONFIG_MAX_MATRIX_CACHE, "Matrix cache out of bounds index %d (max: %d)"
+			const uint32_t capacity = m_frame->m_frameCache.m_matrixCache.m_capacity;
+			BX_ASSERT(_cache < capacity, "Matrix cache out of bounds index %d (max: %d)"
 				, _cache
-				, BGFX_CONFIG_MAX_MATRIX_CACHE
+				, capacity
 				);
 			m_draw.m_startMatrix = _cache;
-			m_draw.m_numMatrices = uint16_t(bx::min<uint32_t>(_cache+_num, BGFX_CONFIG_MAX_MATRIX_CACHE-1) - _cache);
+			m_draw.m_numMatrices = uint16_t(bx::min<uint32_t>(_cache+_num, capacity-1) - _cache);
 		}
 
 		void setIndexBuffer(IndexBufferHandle _handle, const IndexBuffer& _ib, uint32_t _firstIndex, uint32_t _numIndices)
@@ -3108,8 +4054,32 @@ namespace bgfx
 		uint32_t m_numSubmitted;
 		uint32_t m_numDropped;
 
+		uint32_t        m_renderItemBegin;
+		uint32_t        m_renderItemPos;
+		uint32_t        m_renderItemEnd;
+		RenderItemPage* m_renderItemPage;
+
+		TransientChunk m_transientVb;
+		TransientChunk m_transientIb;
+
+		// Thread that began encoder, only that thread sub-allocates transient buffers from encoder's
+		// chunks. Cleared when encoder ends, which can happen on other thread.
+		void* volatile m_ownerThread;
+
+		struct VertexLayoutCacheEntry
+		{
+			uint32_t           m_hash;
+			VertexLayoutHandle m_handle;
+		};
+
+		VertexLayoutCacheEntry m_vertexLayoutCache[4];
+		uint32_t               m_vertexLayoutCacheIdx;
+
 		uint32_t m_uniformBegin;
 		uint32_t m_uniformEnd;
+		uint32_t m_uniformPrevBegin;
+		uint32_t m_uniformPrevEnd;
+		uint32_t m_uniformBytesSaved;
 		uint32_t m_numVertices[BGFX_CONFIG_MAX_VERTEX_STREAMS];
 		uint8_t  m_uniformIdx;
 		bool     m_discard;
@@ -3219,22 +4189,22 @@ namespace bgfx
 		VertexLayoutHandle m_dynamicVertexBufferRef[BGFX_CONFIG_MAX_DYNAMIC_VERTEX_BUFFERS];
 	};
 
-	// First-fit non-local allocator.
-	//
-	// The free list is kept sorted by address at all times, which:
-	//  - Enables O(1) adjacent-block coalescing on free.
-	//  - Provides cache-friendly iteration (contiguous vector storage).
-	//  - Uses binary search for sorted insertion, replacing the O(n) push_front.
-	//
+	// Segregated fit allocator for address ranges that are not CPU accessible (sub-allocations of
+	// GPU buffers, uniform store offsets). Free blocks are kept in two-level size bins with bitmap
+	// lookup (TLSF), so alloc, free and coalescing are O(1), independent of number of blocks.
 	class NonLocalAllocator
 	{
 	public:
 		static const uint64_t kInvalidBlock = UINT64_MAX;
 
 		NonLocalAllocator()
-			: m_totalUsed(0)
+			: m_firstFreeNode(kInvalidNode)
+			, m_flBitmap(0)
+			, m_numFree(0)
+			, m_totalUsed(0)
 			, m_totalAvailable(0)
 		{
+			resetBins();
 		}
 
 		~NonLocalAllocator()
@@ -3243,16 +4213,18 @@ namespace bgfx
 
 		void reset()
 		{
-			m_free.clear();
+			m_node.clear();
 			m_used.clear();
-			m_slab.clear();
+			m_orphaned.clear();
+			m_firstFreeNode = kInvalidNode;
+			resetBins();
 			m_totalUsed = 0;
 		}
 
 		void add(uint64_t _ptr, uint32_t _size)
 		{
-			m_slab.insert(stl::make_pair(_ptr, _size) );
-			insertFreeBlock(_ptr, _size);
+			const uint32_t node = allocNode(_ptr, _size);
+			insertFree(node);
 			m_totalAvailable += _size;
 		}
 
@@ -3260,13 +4232,13 @@ namespace bgfx
 		{
 			BX_ASSERT(0 == m_used.size(), "");
 
-			if (0 < m_free.size() )
+			if (0 != m_flBitmap)
 			{
-				Free freeBlock = m_free.front();
-				m_free.erase(m_free.begin() );
-				m_slab.erase(m_slab.find(freeBlock.m_ptr));
-				m_totalAvailable -= freeBlock.m_size;
-				return freeBlock.m_ptr;
+				const uint32_t fl   = bx::countTrailingZeros(m_flBitmap);
+				const uint32_t sl   = bx::countTrailingZeros(m_slBitmap[fl]);
+				const uint32_t node = m_bin[fl][sl];
+
+				return removeSlab(node);
 			}
 
 			return 0;
@@ -3277,159 +4249,368 @@ namespace bgfx
 		/// GPU buffers whose sub-allocations have all been released.
 		uint64_t removeOrphaned()
 		{
-			for (FreeList::iterator it = m_free.begin(), itEnd = m_free.end(); it != itEnd; ++it)
+			while (!m_orphaned.empty() )
 			{
-				SlabList::iterator slabIt = m_slab.find(it->m_ptr);
-				if (slabIt != m_slab.end()
-				&&  slabIt->second == it->m_size)
+				const uint32_t node = m_orphaned.back();
+				m_orphaned.pop_back();
+
+				Node& block = m_node[node];
+				block.m_orphaned = false;
+
+				if (block.m_free
+				&&  kInvalidNode == block.m_prevPhys
+				&&  kInvalidNode == block.m_nextPhys)
+				{
+					return removeSlab(node);
+				}
+			}
+
+			return 0;
+		}
+
+		uint64_t alloc(uint32_t _size)
+		{
+			_size = bx::max(_size, kMinBlockSize);
+
+			uint32_t fl, sl;
+			if (!findFree(_size, fl, sl) )
+			{
+				// there is no block large enough.
+				return kInvalidBlock;
+			}
+
+			const uint32_t node = m_bin[fl][sl];
+			removeFree(node, fl, sl);
+
+			Node& block = m_node[node];
+			if (block.m_size != _size)
+			{
+				const uint32_t remainder = allocNode(m_node[node].m_ptr + _size, m_node[node].m_size - _size);
+
+				Node& rest = m_node[remainder];
+				Node& used = m_node[node];
+				rest.m_prevPhys = node;
+				rest.m_nextPhys = used.m_nextPhys;
+
+				if (kInvalidNode != used.m_nextPhys)
+				{
+					m_node[used.m_nextPhys].m_prevPhys = remainder;
+				}
+
+				used.m_nextPhys = remainder;
+				used.m_size     = _size;
+
+				insertFree(remainder);
+			}
+
+			const uint64_t ptr = m_node[node].m_ptr;
+			m_used.insert(stl::make_pair(ptr, node) );
+			m_totalUsed += _size;
+
+			return ptr;
+		}
+
+		void free(uint64_t _block)
+		{
+			UsedList::iterator it = m_used.find(_block);
+			if (it != m_used.end() )
+			{
+				uint32_t node = it->second;
+				m_used.erase(it);
+
+				m_totalUsed -= m_node[node].m_size;
+
+				// Coalesce with physically adjacent free blocks.
+				const uint32_t prev = m_node[node].m_prevPhys;
+				if (kInvalidNode != prev
+				&&  m_node[prev].m_free)
+				{
+					removeFree(prev);
+					node = merge(prev, node);
+				}
+
+				const uint32_t next = m_node[node].m_nextPhys;
+				if (kInvalidNode != next
+				&&  m_node[next].m_free)
 				{
-					m_totalAvailable -= it->m_size;
+					removeFree(next);
+					node = merge(node, next);
+				}
+
+				insertFree(node);
+			}
+		}
+
+		uint32_t getTotalUsed() const
+		{
+			return m_totalUsed;
+		}
+
+		uint32_t getTotalAvailable() const
+		{
+			return m_totalAvailable;
+		}
+
+		uint32_t getTotalFree() const
+		{
+			return m_totalAvailable - m_totalUsed;
+		}
+
+		uint32_t getNumFreeBlocks() const
+		{
+			return m_numFree;
+		}
+
+		uint32_t getLargestFree() const
+		{
+			if (0 == m_flBitmap)
+			{
+				return 0;
+			}
+
+			// Blocks in the same bin differ only within bin granularity, walk the last bin.
+			const uint32_t fl = bx::findLastSet(m_flBitmap) - 1;
+			const uint32_t sl = bx::findLastSet(m_slBitmap[fl]) - 1;
+
+			uint32_t largest = 0;
+			for (uint32_t node = m_bin[fl][sl]; kInvalidNode != node; node = m_node[node].m_nextFree)
+			{
+				largest = bx::max(largest, m_node[node].m_size);
+			}
+
+			return largest;
+		}
+
+	private:
+		static constexpr uint32_t kInvalidNode  = UINT32_MAX;
+		static constexpr uint32_t kMinBlockSize = 16;
+		static constexpr uint32_t kSlShift      = 4;
+		static constexpr uint32_t kSlNum        = 1<<kSlShift;
+		static constexpr uint32_t kFlNum        = 32;
+
+		struct Node
+		{
+			uint64_t m_ptr;
+			uint32_t m_size;
+			uint32_t m_prevPhys;
+			uint32_t m_nextPhys;
+			uint32_t m_prevFree;
+			uint32_t m_nextFree;
+			bool     m_free;
+			bool     m_orphaned;
+		};
+
+		void resetBins()
+		{
+			m_flBitmap = 0;
+			m_numFree  = 0;
+			bx::memSet(m_slBitmap, 0, sizeof(m_slBitmap) );
+			bx::memSet(m_bin, 0xff, sizeof(m_bin) );
+		}
+
+		// Blocks smaller than minimum allocation are kept in bin 0, which is never searched.
+		static void mapping(uint32_t _size, uint32_t& _outFl, uint32_t& _outSl)
+		{
+			if (_size < kMinBlockSize)
+			{
+				_outFl = 0;
+				_outSl = 0;
+				return;
+			}
+
+			const uint32_t fl = bx::findLastSet(_size) - 1;
+			_outFl = fl;
+			_outSl = (_size >> (fl - kSlShift) ) ^ kSlNum;
+		}
+
+		bool findFree(uint32_t _size, uint32_t& _outFl, uint32_t& _outSl) const
+		{
+			// Round up to the next bin, so any block in found bin is large enough.
+			const uint32_t fl   = bx::findLastSet(_size) - 1;
+			const uint64_t size = uint64_t(_size) + (uint64_t(1) << (fl - kSlShift) ) - 1;
+			if (size > UINT32_MAX)
+			{
+				return false;
+			}
+
+			uint32_t flIdx, slIdx;
+			mapping(uint32_t(size), flIdx, slIdx);
+
+			uint32_t slBitmap = m_slBitmap[flIdx] & (UINT32_MAX << slIdx);
+			if (0 == slBitmap)
+			{
+				const uint32_t flBitmap = flIdx + 1 < kFlNum
+					? m_flBitmap & (UINT32_MAX << (flIdx + 1) )
+					: 0
+					;
+
+				if (0 == flBitmap)
+				{
+					return false;
+				}
+
+				flIdx    = bx::countTrailingZeros(flBitmap);
+				slBitmap = m_slBitmap[flIdx];
+			}
+
+			_outFl = flIdx;
+			_outSl = bx::countTrailingZeros(slBitmap);
+			return true;
+		}
+
+		uint32_t allocNode(uint64_t _ptr, uint32_t _size)
+		{
+			uint32_t node;
+
+			if (kInvalidNode != m_firstFreeNode)
+			{
+				node = m_firstFreeNode;
+				m_firstFreeNode = m_node[node].m_nextFree;
+			}
+			else
+			{
+				node = uint32_t(m_node.size() );
+				m_node.push_back(Node() );
+			}
+
+			Node& block = m_node[node];
+			block.m_ptr      = _ptr;
+			block.m_size     = _size;
+			block.m_prevPhys = kInvalidNode;
+			block.m_nextPhys = kInvalidNode;
+			block.m_prevFree = kInvalidNode;
+			block.m_nextFree = kInvalidNode;
+			block.m_free     = false;
+			block.m_orphaned = false;
+
+			return node;
+		}
+
+		void freeNode(uint32_t _node)
+		{
+			Node& block = m_node[_node];
+			block.m_free     = false;
+			block.m_nextFree = m_firstFreeNode;
+			m_firstFreeNode  = _node;
+		}
+
+		void insertFree(uint32_t _node)
+		{
+			Node& block = m_node[_node];
 
-					uint64_t ptr = it->m_ptr;
-					m_free.erase(it);
-					m_slab.erase(slabIt);
-					return ptr;
-				}
+			uint32_t fl, sl;
+			mapping(block.m_size, fl, sl);
+
+			const uint32_t head = m_bin[fl][sl];
+			block.m_free     = true;
+			block.m_prevFree = kInvalidNode;
+			block.m_nextFree = head;
+
+			if (kInvalidNode != head)
+			{
+				m_node[head].m_prevFree = _node;
 			}
 
-			return 0;
+			m_bin[fl][sl] = _node;
+			m_flBitmap    |= UINT32_C(1) << fl;
+			m_slBitmap[fl] |= UINT32_C(1) << sl;
+			++m_numFree;
+
+			if (kInvalidNode == block.m_prevPhys
+			&&  kInvalidNode == block.m_nextPhys
+			&&  !block.m_orphaned)
+			{
+				block.m_orphaned = true;
+				m_orphaned.push_back(_node);
+			}
 		}
 
-		uint64_t alloc(uint32_t _size)
+		void removeFree(uint32_t _node, uint32_t _fl, uint32_t _sl)
 		{
-			_size = bx::max(_size, 16u);
+			Node& block = m_node[_node];
 
-			for (FreeList::iterator it = m_free.begin(), itEnd = m_free.end(); it != itEnd; ++it)
+			if (kInvalidNode != block.m_prevFree)
 			{
-				if (it->m_size >= _size)
-				{
-					uint64_t ptr = it->m_ptr;
+				m_node[block.m_prevFree].m_nextFree = block.m_nextFree;
+			}
+			else
+			{
+				m_bin[_fl][_sl] = block.m_nextFree;
 
-					m_used.insert(stl::make_pair(ptr, _size) );
-					m_totalUsed += _size;
+				if (kInvalidNode == block.m_nextFree)
+				{
+					m_slBitmap[_fl] &= ~(UINT32_C(1) << _sl);
 
-					if (it->m_size != _size)
-					{
-						it->m_size -= _size;
-						it->m_ptr  += _size;
-					}
-					else
+					if (0 == m_slBitmap[_fl])
 					{
-						m_free.erase(it);
+						m_flBitmap &= ~(UINT32_C(1) << _fl);
 					}
-
-					return ptr;
 				}
 			}
 
-			// there is no block large enough.
-			return kInvalidBlock;
-		}
-
-		void free(uint64_t _block)
-		{
-			UsedList::iterator it = m_used.find(_block);
-			if (it != m_used.end() )
+			if (kInvalidNode != block.m_nextFree)
 			{
-				const uint64_t ptr  = it->first;
-				const uint32_t size = it->second;
-
-				m_totalUsed -= size;
-				m_used.erase(it);
-
-				// Insert into sorted free list and coalesce with adjacent blocks.
-				insertFreeBlock(ptr, size);
+				m_node[block.m_nextFree].m_prevFree = block.m_prevFree;
 			}
-		}
 
-		uint32_t getTotalUsed() const
-		{
-			return m_totalUsed;
+			block.m_free = false;
+			--m_numFree;
 		}
 
-		uint32_t getTotalAvailable() const
+		void removeFree(uint32_t _node)
 		{
-			return m_totalAvailable;
+			uint32_t fl, sl;
+			mapping(m_node[_node].m_size, fl, sl);
+			removeFree(_node, fl, sl);
 		}
 
-	private:
-		struct Free
+		// Merges _next into _prev, and returns _prev.
+		uint32_t merge(uint32_t _prev, uint32_t _next)
 		{
-			Free(uint64_t _ptr, uint32_t _size)
-				: m_ptr(_ptr)
-				, m_size(_size)
-			{
-			}
+			Node& prev = m_node[_prev];
+			Node& next = m_node[_next];
 
-			bool operator<(const Free& rhs) const
-			{
-				return m_ptr < rhs.m_ptr;
-			}
+			prev.m_size    += next.m_size;
+			prev.m_nextPhys = next.m_nextPhys;
 
-			bool operator>(const Free& rhs) const
+			if (kInvalidNode != next.m_nextPhys)
 			{
-				return m_ptr > rhs.m_ptr;
+				m_node[next.m_nextPhys].m_prevPhys = _prev;
 			}
 
-			uint64_t m_ptr;
-			uint32_t m_size;
-		};
+			freeNode(_next);
+
+			return _prev;
+		}
 
-		// Insert a free block at its sorted position and coalesce with
-		// adjacent neighbors. Uses bx::upperBound to find the insertion
-		// point in O(log n), then checks the immediate neighbors for
-		// merge opportunities.
-		void insertFreeBlock(uint64_t _ptr, uint32_t _size)
+		uint64_t removeSlab(uint32_t _node)
 		{
-			// Use bx::upperBound to find the insertion point (first element with m_ptr > _ptr).
-			const Free key(_ptr, 0);
-			const uint32_t idx = 0 < m_free.size()
-				? bx::upperBound(key, m_free.data(), uint32_t(m_free.size() ) )
-				: 0
-				;
+			removeFree(_node);
 
-			// Check if we can merge with the previous block.
-			const bool mergePrev = idx > 0
-				&& (m_free[idx - 1].m_ptr + m_free[idx - 1].m_size) == _ptr
-				;
+			const uint64_t ptr = m_node[_node].m_ptr;
+			m_totalAvailable  -= m_node[_node].m_size;
 
-			// Check if we can merge with the next block.
-			const bool mergeNext = idx < uint32_t(m_free.size() )
-				&& (_ptr + _size) == m_free[idx].m_ptr
-				;
+			// Stale orphaned list entries are skipped by removeOrphaned, since it checks block
+			// state rather than trusting the list.
+			freeNode(_node);
 
-			if (mergePrev && mergeNext)
-			{
-				// Merge all three: extend previous to cover current + next.
-				m_free[idx - 1].m_size += _size + m_free[idx].m_size;
-				m_free.erase(m_free.begin() + idx);
-			}
-			else if (mergePrev)
-			{
-				// Extend previous block.
-				m_free[idx - 1].m_size += _size;
-			}
-			else if (mergeNext)
-			{
-				// Extend next block backward.
-				m_free[idx].m_ptr   = _ptr;
-				m_free[idx].m_size += _size;
-			}
-			else
-			{
-				// No merge possible — insert new block at sorted position.
-				m_free.insert(m_free.begin() + idx, Free(_ptr, _size) );
-			}
+			return ptr;
 		}
 
-		typedef stl::vector<Free> FreeList;
-		FreeList m_free;
+		typedef stl::vector<Node> NodeArray;
+		NodeArray m_node;
+		uint32_t  m_firstFreeNode;
 
 		typedef stl::unordered_map<uint64_t, uint32_t> UsedList;
 		UsedList m_used;
 
-		typedef stl::unordered_map<uint64_t, uint32_t> SlabList;
-		SlabList m_slab;
+		typedef stl::vector<uint32_t> OrphanedList;
+		OrphanedList m_orphaned;
+
+		uint32_t m_bin[kFlNum][kSlNum];
+		uint32_t m_slBitmap[kFlNum];
+		uint32_t m_flBitmap;
+		uint32_t m_numFree;
 
 		uint32_t m_totalUsed;
 		uint32_t m_totalAvailable;
@@ -3438,6 +4619,8 @@ namespace bgfx
 	struct UniformCache
 	{
 		UniformCache()
+			: m_frameNum(0)
+			, m_viewKeysDirty(true)
 		{
 			const uint32_t size = 1<<20;
 			m_data = (uint8_t*)bx::alloc(g_allocator, size);
@@ -3540,6 +4723,7 @@ namespace bgfx
 			else
 			{
 				m_uniformKeyHashMap.insert(stl::make_pair(_uniformKey, hash) );
+				m_viewKeysDirty = true;
 			}
 
 			UniformEntryMap::iterator itEntry = m_uniformEntryMap.find(hash);
@@ -3554,29 +4738,69 @@ namespace bgfx
 
 				m_uniformEntryMap.insert(stl::make_pair(hash, UniformCacheEntry
 					{
-						.offset   = bx::narrowCast<uint32_t>(offset),
-						.size     = bx::narrowCast<uint16_t>(dataSize),
-						.refCount = 1
+						.offset      = bx::narrowCast<uint32_t>(offset),
+						.size        = bx::narrowCast<uint16_t>(dataSize),
+						.refCount    = 1,
+						.frameOffset = 0,
+						.frameNum    = 0,
 					}) );
 
 				bx::memCopy(&m_data[offset], _value, dataSize);
 			}
 		}
 
-		void frame(UniformCacheFrame& _outUniformCacheFrame)
+		void frame(UniformCacheFrame& _outUniformCacheFrame, const ViewId* _viewOrder)
 		{
+			const uint32_t numKeys = uint32_t(m_uniformKeyHashMap.size() );
+
 			_outUniformCacheFrame.resize(
-				  uint32_t(m_uniformKeyHashMap.size() )
+				  numKeys
 				, m_uniformStoreAlloc.getTotalUsed()
 				);
 
-			using OffsetRemap = stl::unordered_map<uint32_t, uint32_t>;
-			OffsetRemap offsetRemap;
+			if (m_viewKeysDirty)
+			{
+				updateViewKeys();
+			}
+
+			++m_frameNum;
 
+			// Keys are written out one view bucket at the time in physical view order, so renderer
+			// can consume them without remapping and sorting. Frame uniforms go into physical view 0.
+			uint32_t num          = 0;
 			uint32_t linearOffset = 0;
-			uint32_t num = 0;
-			for (UniformKeyHashMap::const_iterator itKey = m_uniformKeyHashMap.begin(), itEnd = m_uniformKeyHashMap.end(); itKey != itEnd; ++itKey)
+			frameView(_outUniformCacheFrame, num, linearOffset, m_viewKeyBegin[BGFX_CONFIG_MAX_VIEWS], numKeys, 0);
+
+			ViewId viewRemap[BGFX_CONFIG_MAX_VIEWS];
+			for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+			{
+				viewRemap[_viewOrder[ii] ] = ViewId(ii);
+			}
+
+			for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+			{
+				const ViewId view = _viewOrder[ii];
+
+				// View order with duplicate views maps each view only once.
+				if (ii != viewRemap[view])
+				{
+					continue;
+				}
+
+				frameView(_outUniformCacheFrame, num, linearOffset, m_viewKeyBegin[view], m_viewKeyBegin[view+1], ViewId(ii) );
+			}
+
+			_outUniformCacheFrame.m_numItems = num;
+			_outUniformCacheFrame.m_sorted   = true;
+		}
+
+		void frameView(UniformCacheFrame& _outUniformCacheFrame, uint32_t& _num, uint32_t& _linearOffset, uint32_t _begin, uint32_t _end, ViewId _view)
+		{
+			for (uint32_t ii = _begin; ii < _end; ++ii)
 			{
+				const uint32_t uniformKey = m_viewKeys[ii];
+
+				UniformKeyHashMap::const_iterator itKey = m_uniformKeyHashMap.find(uniformKey);
 				UniformEntryMap::iterator itEntry = m_uniformEntryMap.find(itKey->second);
 				BX_ASSERT(itEntry != m_uniformEntryMap.end()
 					, "Couldn't find uniform cache entry for key 0x%d, hash 0x%x!"
@@ -3584,32 +4808,58 @@ namespace bgfx
 					, itKey->second
 					);
 
-				const uint32_t offset = itEntry->second.offset;
-				const uint16_t size   = itEntry->second.size;
+				// Entries shared by multiple keys are copied only once per frame.
+				UniformCacheEntry& entry = itEntry->second;
+				if (m_frameNum != entry.frameNum)
+				{
+					entry.frameNum    = m_frameNum;
+					entry.frameOffset = _linearOffset;
+
+					bx::memCopy(&_outUniformCacheFrame.m_data[_linearOffset], &m_data[entry.offset], entry.size);
+					_linearOffset += entry.size;
+				}
 
 				UniformCacheKey key;
-				key.decode(uint64_t(itKey->first)<<32);
-				key.m_size = size;
+				key.decode(uint64_t(uniformKey)<<32);
+				key.m_offset = entry.frameOffset;
+				key.m_size   = entry.size;
+				key.m_view   = _view;
 
-				OffsetRemap::const_iterator itOffset = offsetRemap.find(offset);
-				if (itOffset != offsetRemap.end())
-				{
-					key.m_offset = itOffset->second;
-				}
-				else
-				{
-					key.m_offset = linearOffset;
+				_outUniformCacheFrame.m_keys[_num++] = key.encode();
+			}
+		}
+
+		void updateViewKeys()
+		{
+			m_viewKeys.clear();
+
+			for (UniformKeyHashMap::const_iterator itKey = m_uniformKeyHashMap.begin(), itEnd = m_uniformKeyHashMap.end(); itKey != itEnd; ++itKey)
+			{
+				m_viewKeys.push_back(itKey->first);
+			}
 
-					offsetRemap.insert(stl::make_pair(offset, linearOffset) );
-					bx::memCopy(&_outUniformCacheFrame.m_data[linearOffset], &m_data[offset], size);
+			const uint32_t num = uint32_t(m_viewKeys.size() );
+			bx::quickSort(m_viewKeys.data(), num);
 
-					linearOffset += size;
+			// View is in top bits of key, sorted keys are grouped by view, and frame uniforms
+			// (view UINT16_MAX) are at the end.
+			for (uint32_t view = 0, ii = 0; view <= BGFX_CONFIG_MAX_VIEWS; ++view)
+			{
+				for (; ii < num; ++ii)
+				{
+					UniformCacheKey key;
+					key.decode(uint64_t(m_viewKeys[ii])<<32);
+
+					if (key.m_view >= view)
+					{
+						break;
+					}
 				}
 
-				_outUniformCacheFrame.m_keys[num++] = key.encode();
+				m_viewKeyBegin[view] = ii;
 			}
 
-			_outUniformCacheFrame.m_numItems = num;
+			m_viewKeysDirty = false;
 		}
 
 		void invalidate(ViewId _viewId)
@@ -3627,6 +4877,7 @@ namespace bgfx
 					++itKey;
 
 					m_uniformKeyHashMap.erase(itErase);
+					m_viewKeysDirty = true;
 				}
 				else
 				{
@@ -3650,6 +4901,7 @@ namespace bgfx
 					++itKey;
 
 					m_uniformKeyHashMap.erase(itErase);
+					m_viewKeysDirty = true;
 				}
 				else
 				{
@@ -3691,6 +4943,13 @@ namespace bgfx
 		UniformKeyHashMap m_uniformKeyHashMap;
 		UniformEntryMap   m_uniformEntryMap;
 
+		// Uniform keys sorted by view, and index of first key of each view. Rebuilt only when keys
+		// are added or removed.
+		stl::vector<uint32_t> m_viewKeys;
+		uint32_t m_viewKeyBegin[BGFX_CONFIG_MAX_VIEWS+1];
+		uint32_t m_frameNum;
+		bool     m_viewKeysDirty;
+
 		NonLocalAllocator m_uniformStoreAlloc;
 		uint8_t* m_data;
 	};
@@ -3746,7 +5005,11 @@ namespace bgfx
 	{
 	}
 
-	void rendererUpdateUniforms(RendererContextI* _renderCtx, UniformBuffer* _uniformBuffer, uint32_t _begin, uint32_t _end);
+	/// Applies uniform range, returns false when range is empty or same as last applied range.
+	bool rendererUpdateUniforms(RendererContextI* _renderCtx, UniformBuffer* _uniformBuffer, uint32_t _begin, uint32_t _end);
+
+	///
+	void rendererResetUniforms();
 
 #if BGFX_CONFIG_DEBUG
 #	define BGFX_API_FUNC(_func) BX_NO_INLINE _func
@@ -3958,6 +5221,23 @@ namespace bgfx
 			stats.textureMemoryUsed = m_textureMemoryUsed;
 			stats.rtMemoryUsed      = m_rtMemoryUsed;
 
+			stats.dynamicIbFree        = m_dynIndexBufferAllocator.getTotalFree();
+			stats.dynamicIbFreeLargest = m_dynIndexBufferAllocator.getLargestFree();
+			stats.dynamicIbFreeBlocks  = m_dynIndexBufferAllocator.getNumFreeBlocks();
+			stats.dynamicVbFree        = m_dynVertexBufferAllocator.getTotalFree();
+			stats.dynamicVbFreeLargest = m_dynVertexBufferAllocator.getLargestFree();
+			stats.dynamicVbFreeBlocks  = m_dynVertexBufferAllocator.getNumFreeBlocks();
+
+			stats.transientVbPages = 0;
+			stats.transientIbPages = 0;
+			for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_TRANSIENT_BUFFER_PAGES; ++ii)
+			{
+				stats.transientVbPages += NULL != m_submit->m_transientVb[ii];
+				stats.transientIbPages += NULL != m_submit->m_transientIb[ii];
+			}
+
+			getMemoryPoolStats(stats);
+
 			return &stats;
 		}
 
@@ -4539,17 +5819,31 @@ namespace bgfx
 			m_dynamicVertexBufferHandle.free(_handle.idx);
 		}
 
-		BGFX_API_FUNC(uint32_t getAvailTransientIndexBuffer(uint32_t _num, bool _index32) )
+		// Transient buffer functions take encoder used by calling thread. Encoder sub-allocates from
+		// its own transient chunk without taking resource API lock. Without encoder, allocation goes
+		// directly to submit frame.
+		BGFX_API_FUNC(uint32_t getAvailTransientIndexBuffer(uint32_t _num, bool _index32, EncoderImpl* _encoder) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
-
 			const bool isIndex16     = !_index32;
 			const uint16_t indexSize = isIndex16 ? 2 : 4;
+
+			if (NULL != _encoder)
+			{
+				return _encoder->getAvailTransientIndexBuffer(_num, indexSize);
+			}
+
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
 			return m_submit->getAvailTransientIndexBuffer(_num, indexSize);
 		}
 
-		BGFX_API_FUNC(uint32_t getAvailTransientVertexBuffer(uint32_t _num, uint16_t _stride) )
+		BGFX_API_FUNC(uint32_t getAvailTransientVertexBuffer(uint32_t _num, uint16_t _stride, EncoderImpl* _encoder) )
 		{
+			if (NULL != _encoder)
+			{
+				return _encoder->getAvailTransientVertexBuffer(_num, _stride);
+			}
+
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
 
 			return m_submit->getAvailTransientVertexBuffer(_num, _stride);
@@ -4593,23 +5887,175 @@ namespace bgfx
 			bx::alignedFree(g_allocator, _tib, 16);
 		}
 
-		BGFX_API_FUNC(void allocTransientIndexBuffer(TransientIndexBuffer* _tib, uint32_t _num, bool _index32) )
+		BGFX_API_FUNC(void allocTransientIndexBuffer(TransientIndexBuffer* _tib, uint32_t _num, bool _index32, EncoderImpl* _encoder) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
-
 			const bool isIndex16     = !_index32;
 			const uint16_t indexSize = isIndex16 ? 2 : 4;
-			const uint32_t offset    = m_submit->allocTransientIndexBuffer(_num, indexSize);
 
-			TransientIndexBuffer& tib = *m_submit->m_transientIb;
+			Frame* frame;
+			uint32_t offset;
+			uint32_t num;
+			uint32_t page;
+
+			do
+			{
+				num = _num;
+
+				if (NULL != _encoder)
+				{
+					frame  = _encoder->m_frame;
+					offset = _encoder->allocTransientIndexBuffer(num, indexSize, page);
+				}
+				else
+				{
+					BGFX_MUTEX_SCOPE(m_resourceApiLock);
+					frame  = m_submit;
+					offset = frame->allocTransientIndexBuffer(num, indexSize, page);
+				}
+			}
+			while (UINT32_MAX != page
+			&&     createTransientIndexBufferPage(frame, page) );
+
+			const TransientIndexBuffer& tib = *getTransientIndexBufferPage(frame, offset, num);
 
 			_tib->data       = &tib.data[offset];
-			_tib->size       = _num * indexSize;
+			_tib->size       = num * indexSize;
 			_tib->handle     = tib.handle;
-			_tib->startIndex = bx::strideAlign(offset, indexSize) / indexSize;
+			_tib->startIndex = offset / indexSize;
 			_tib->isIndex16  = isIndex16;
 		}
 
+		// Creates transient buffer page that allocation is about to advance into. Returns false when
+		// page can't be created, in which case allocation fails without advancing frame's offset.
+		bool createTransientIndexBufferPage(Frame* _frame, uint32_t _page)
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			void* volatile* slot = (void* volatile*)&_frame->m_transientIb[_page];
+
+			if (NULL == bx::atomicLoadPtr(slot) )
+			{
+				TransientIndexBuffer* tib = createTransientIndexBuffer(g_caps.limits.maxTransientIbSize);
+
+				if (NULL == tib)
+				{
+					return false;
+				}
+
+				// Page is read by other encoders without lock, publish it after it's initialized.
+				bx::atomicStorePtr(slot, tib);
+			}
+
+			return true;
+		}
+
+		bool createTransientVertexBufferPage(Frame* _frame, uint32_t _page)
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			void* volatile* slot = (void* volatile*)&_frame->m_transientVb[_page];
+
+			if (NULL == bx::atomicLoadPtr(slot) )
+			{
+				TransientVertexBuffer* tvb = createTransientVertexBuffer(g_caps.limits.maxTransientVbSize);
+
+				if (NULL == tvb)
+				{
+					return false;
+				}
+
+				bx::atomicStorePtr(slot, tvb);
+			}
+
+			return true;
+		}
+
+		// Returns transient buffer page containing virtual _offset, and makes _offset relative to
+		// page. Page was created before allocation advanced into it, and is kept by frame until
+		// trimmed.
+		TransientIndexBuffer* getTransientIndexBufferPage(Frame* _frame, uint32_t& _offset, uint32_t _num)
+		{
+			if (0 == _num)
+			{
+				_offset = 0;
+				return _frame->m_transientIb[0];
+			}
+
+			const uint32_t pageSize = g_caps.limits.maxTransientIbSize;
+			const uint32_t page     = _offset / pageSize;
+
+			_offset -= page*pageSize;
+			return (TransientIndexBuffer*)bx::atomicLoadPtr( (void* volatile*)&_frame->m_transientIb[page]);
+		}
+
+		TransientVertexBuffer* getTransientVertexBufferPage(Frame* _frame, uint32_t& _offset, uint32_t _num)
+		{
+			if (0 == _num)
+			{
+				_offset = 0;
+				return _frame->m_transientVb[0];
+			}
+
+			const uint32_t pageSize = g_caps.limits.maxTransientVbSize;
+			const uint32_t page     = _offset / pageSize;
+
+			_offset -= page*pageSize;
+			return (TransientVertexBuffer*)bx::atomicLoadPtr( (void* volatile*)&_frame->m_transientVb[page]);
+		}
+
+		// Releases transient buffer pages above frame's high-water mark, after frame was calm for
+		// BGFX_CONFIG_TRANSIENT_BUFFER_TRIM_FRAMES frames. First page is always kept.
+		void trimTransientBuffers(Frame* _frame)
+		{
+			if (_frame->m_transientTrimFrames < BGFX_CONFIG_TRANSIENT_BUFFER_TRIM_FRAMES)
+			{
+				return;
+			}
+
+			const uint32_t numIbPages = bx::max<uint32_t>(1, Frame::getNumTransientPages(_frame->m_transientIbHighWater, g_caps.limits.maxTransientIbSize) );
+			const uint32_t numVbPages = bx::max<uint32_t>(1, Frame::getNumTransientPages(_frame->m_transientVbHighWater, g_caps.limits.maxTransientVbSize) );
+
+			for (uint32_t ii = numIbPages; ii < BGFX_CONFIG_MAX_TRANSIENT_BUFFER_PAGES; ++ii)
+			{
+				if (NULL != _frame->m_transientIb[ii])
+				{
+					destroyTransientIndexBuffer(_frame->m_transientIb[ii]);
+					_frame->m_transientIb[ii] = NULL;
+				}
+			}
+
+			for (uint32_t ii = numVbPages; ii < BGFX_CONFIG_MAX_TRANSIENT_BUFFER_PAGES; ++ii)
+			{
+				if (NULL != _frame->m_transientVb[ii])
+				{
+					destroyTransientVertexBuffer(_frame->m_transientVb[ii]);
+					_frame->m_transientVb[ii] = NULL;
+				}
+			}
+
+			_frame->m_transientIbHighWater = 0;
+			_frame->m_transientVbHighWater = 0;
+			_frame->m_transientTrimFrames  = 0;
+		}
+
+		void destroyTransientBuffers(Frame* _frame)
+		{
+			for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_TRANSIENT_BUFFER_PAGES; ++ii)
+			{
+				if (NULL != _frame->m_transientIb[ii])
+				{
+					destroyTransientIndexBuffer(_frame->m_transientIb[ii]);
+					_frame->m_transientIb[ii] = NULL;
+				}
+
+				if (NULL != _frame->m_transientVb[ii])
+				{
+					destroyTransientVertexBuffer(_frame->m_transientVb[ii]);
+					_frame->m_transientVb[ii] = NULL;
+				}
+			}
+		}
+
 		TransientVertexBuffer* createTransientVertexBuffer(uint32_t _size, const VertexLayout* _layout = NULL)
 		{
 			TransientVertexBuffer* tvb = NULL;
@@ -4663,33 +6109,75 @@ namespace bgfx
 			bx::alignedFree(g_allocator, _tvb, 16);
 		}
 
-		BGFX_API_FUNC(void allocTransientVertexBuffer(TransientVertexBuffer* _tvb, uint32_t _num, VertexLayoutHandle _layoutHandle, uint16_t _stride) )
+		BGFX_API_FUNC(void allocTransientVertexBuffer(TransientVertexBuffer* _tvb, uint32_t _num, VertexLayoutHandle _layoutHandle, uint16_t _stride, EncoderImpl* _encoder) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			Frame* frame;
+			uint32_t offset;
+			uint32_t num;
+			uint32_t page;
+
+			do
+			{
+				num = _num;
+
+				if (NULL != _encoder)
+				{
+					frame  = _encoder->m_frame;
+					offset = _encoder->allocTransientVertexBuffer(num, _stride, page);
+				}
+				else
+				{
+					BGFX_MUTEX_SCOPE(m_resourceApiLock);
+					frame  = m_submit;
+					offset = frame->allocTransientVertexBuffer(num, _stride, page);
+				}
+			}
+			while (UINT32_MAX != page
+			&&     createTransientVertexBufferPage(frame, page) );
 
-			const uint32_t offset = m_submit->allocTransientVertexBuffer(_num, _stride);
-			const TransientVertexBuffer& dvb = *m_submit->m_transientVb;
+			const TransientVertexBuffer& dvb = *getTransientVertexBufferPage(frame, offset, num);
 
 			_tvb->data         = &dvb.data[offset];
-			_tvb->size         = _num * _stride;
-			_tvb->startVertex  = bx::strideAlign(offset, _stride)/_stride;
+			_tvb->size         = num * _stride;
+			_tvb->startVertex  = offset/_stride;
 			_tvb->stride       = _stride;
 			_tvb->handle       = dvb.handle;
 			_tvb->layoutHandle = _layoutHandle;
 		}
 
-		BGFX_API_FUNC(void allocInstanceDataBuffer(InstanceDataBuffer* _idb, uint32_t _num, uint16_t _stride) )
+		BGFX_API_FUNC(void allocInstanceDataBuffer(InstanceDataBuffer* _idb, uint32_t _num, uint16_t _stride, EncoderImpl* _encoder) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
-
 			const uint16_t stride = bx::alignUp(_stride, 16);
-			const uint32_t offset = m_submit->allocTransientVertexBuffer(_num, stride);
 
-			TransientVertexBuffer& dvb = *m_submit->m_transientVb;
+			Frame* frame;
+			uint32_t offset;
+			uint32_t num;
+			uint32_t page;
+
+			do
+			{
+				num = _num;
+
+				if (NULL != _encoder)
+				{
+					frame  = _encoder->m_frame;
+					offset = _encoder->allocTransientVertexBuffer(num, stride, page);
+				}
+				else
+				{
+					BGFX_MUTEX_SCOPE(m_resourceApiLock);
+					frame  = m_submit;
+					offset = frame->allocTransientVertexBuffer(num, stride, page);
+				}
+			}
+			while (UINT32_MAX != page
+			&&     createTransientVertexBufferPage(frame, page) );
+
+			const TransientVertexBuffer& dvb = *getTransientVertexBufferPage(frame, offset, num);
 			_idb->data   = &dvb.data[offset];
-			_idb->size   = _num * stride;
+			_idb->size   = num * stride;
 			_idb->offset = offset;
-			_idb->num    = _num;
+			_idb->num    = num;
 			_idb->stride = stride;
 			_idb->handle = dvb.handle;
 		}
@@ -5906,27 +7394,77 @@ namespace bgfx
 
 		void encoderApiWait()
 		{
-			uint16_t numEncoders = m_encoderHandle->getNumHandles();
+			// Close encoder slots, bgfx::begin calls will wait on m_encoderBeginLock until frame
+			// is done.
+			uint32_t slots = m_encoderSlots;
+			for (uint32_t prev = bx::atomicCompareAndSwap<uint32_t>(&m_encoderSlots, slots, slots | kEncoderSlotsClosed)
+				; prev != slots
+				; prev = bx::atomicCompareAndSwap<uint32_t>(&m_encoderSlots, slots, slots | kEncoderSlotsClosed)
+				)
+			{
+				slots = prev;
+			}
+
+			const uint16_t numEncoders = uint16_t(slots);
 
 			for (uint16_t ii = 1; ii < numEncoders; ++ii)
 			{
 				m_encoderEndSem.wait();
 			}
 
+			uint32_t uniformBytesSaved = 0;
+
 			for (uint16_t ii = 0; ii < numEncoders; ++ii)
 			{
-				uint16_t idx = m_encoderHandle->getHandleAt(ii);
-				m_encoderStats[ii].cpuTimeBegin = m_encoder[idx].m_cpuTimeBegin;
-				m_encoderStats[ii].cpuTimeEnd   = m_encoder[idx].m_cpuTimeEnd;
+				m_encoderStats[ii].cpuTimeBegin = m_encoder[ii].m_cpuTimeBegin;
+				m_encoderStats[ii].cpuTimeEnd   = m_encoder[ii].m_cpuTimeEnd;
+				uniformBytesSaved += m_encoder[ii].m_uniformBytesSaved;
 			}
 
-			m_submit->m_perfStats.numEncoders = uint8_t(numEncoders);
+			m_submit->m_perfStats.numEncoders       = uint8_t(numEncoders);
+			m_submit->m_perfStats.uniformBytesSaved = uniformBytesSaved;
+		}
+
+		void encoderApiResume()
+		{
+			// Reopen encoder slots, only API thread encoder is in use at the start of frame.
+			uint32_t slots = m_encoderSlots;
+			for (uint32_t prev = bx::atomicCompareAndSwap<uint32_t>(&m_encoderSlots, slots, 1)
+				; prev != slots
+				; prev = bx::atomicCompareAndSwap<uint32_t>(&m_encoderSlots, slots, 1)
+				)
+			{
+				slots = prev;
+			}
+		}
+
+		uint32_t encoderSlotAlloc()
+		{
+			for (;;)
+			{
+				const uint32_t slots = m_encoderSlots;
+
+				if (0 != (slots & kEncoderSlotsClosed) )
+				{
+					bx::MutexScope beginLockScope(m_encoderBeginLock);
+					continue;
+				}
+
+				if (slots >= g_caps.limits.maxEncoders)
+				{
+					return UINT32_MAX;
+				}
+
+				if (slots == bx::atomicCompareAndSwap<uint32_t>(&m_encoderSlots, slots, slots+1) )
+				{
+					return slots;
+				}
+			}
 		}
 
 		bx::Semaphore m_renderSem;
 		bx::Semaphore m_apiSem;
 		bx::Semaphore m_encoderEndSem;
-		bx::Mutex     m_encoderApiLock;
 		bx::Mutex     m_encoderBeginLock;
 		bx::Mutex     m_resourceApiLock;
 		bx::Thread    m_thread;
@@ -5953,23 +7491,29 @@ namespace bgfx
 		{
 			m_encoderStats[0].cpuTimeBegin = m_encoder[0].m_cpuTimeBegin;
 			m_encoderStats[0].cpuTimeEnd   = m_encoder[0].m_cpuTimeEnd;
-			m_submit->m_perfStats.numEncoders = 1;
+			m_submit->m_perfStats.numEncoders       = 1;
+			m_submit->m_perfStats.uniformBytesSaved = m_encoder[0].m_uniformBytesSaved;
+		}
+
+		void encoderApiResume()
+		{
 		}
 #endif // BGFX_CONFIG_MULTITHREADED
 
+		// Number of encoders handed out in current frame. Encoder index is slot index, slot 0 is
+		// always API thread encoder. Top bit is set while frame is waiting for encoders to end.
+		static constexpr uint32_t kEncoderSlotsClosed = UINT32_C(1)<<31;
+
 		EncoderStats* m_encoderStats;
 		Encoder*      m_encoder0;
 		EncoderImpl*  m_encoder;
 		uint32_t      m_numEncoders;
-		bx::HandleAlloc* m_encoderHandle;
+		uint32_t      m_encoderSlots;
 
 		Frame  m_frame[1+(BGFX_CONFIG_MULTITHREADED ? 1 : 0)];
 		Frame* m_render;
 		Frame* m_submit;
 
-		uint64_t m_tempKeys[BGFX_CONFIG_MAX_DRAW_CALLS];
-		RenderItemCount m_tempValues[BGFX_CONFIG_MAX_DRAW_CALLS];
-
 		IndexBuffer  m_indexBuffers[BGFX_CONFIG_MAX_INDEX_BUFFERS];
 		VertexBuffer m_vertexBuffers[BGFX_CONFIG_MAX_VERTEX_BUFFERS];
 
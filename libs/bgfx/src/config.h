@@ -248,8 +248,9 @@
 #	define BGFX_CONFIG_MAX_BLIT_ITEMS (1<<10)
 #endif // BGFX_CONFIG_MAX_BLIT_ITEMS
 
-/// Maximum number of cached transform matrices. Default is BGFX_CONFIG_MAX_DRAW_CALLS + 1.
-/// Each draw call may reference a transform matrix; this cache stores them for the frame.
+/// Minimum number of cached transform matrices. Default is BGFX_CONFIG_MAX_DRAW_CALLS + 1.
+/// Each draw call may reference a transform matrix; this cache stores them for the frame. At
+/// runtime cache is sized to hold at least `Init::Limits::maxDrawCalls + 1` matrices.
 #ifndef BGFX_CONFIG_MAX_MATRIX_CACHE
 #	define BGFX_CONFIG_MAX_MATRIX_CACHE (BGFX_CONFIG_MAX_DRAW_CALLS+1)
 #endif // BGFX_CONFIG_MAX_MATRIX_CACHE
@@ -381,17 +382,56 @@ static_assert(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS must
 #endif // BGFX_CONFIG_MIN_RESOURCE_COMMAND_BUFFER_SIZE
 
 #ifndef BGFX_CONFIG_MAX_TRANSIENT_VERTEX_BUFFER_SIZE
-/// Maximum transient vertex buffer size. There is no growth, and all transient
-/// vertices must fit into this buffer.
+/// Transient vertex buffer page size. Single transient vertex buffer allocation
+/// must fit into one page, frame grows by adding pages.
 #	define BGFX_CONFIG_MAX_TRANSIENT_VERTEX_BUFFER_SIZE (6<<20)
 #endif // BGFX_CONFIG_MAX_TRANSIENT_VERTEX_BUFFER_SIZE
 
 #ifndef BGFX_CONFIG_MAX_TRANSIENT_INDEX_BUFFER_SIZE
-/// Maximum transient index buffer size. There is no growth, and all transient
-/// indices must fit into this buffer.
+/// Transient index buffer page size. Single transient index buffer allocation
+/// must fit into one page, frame grows by adding pages.
 #	define BGFX_CONFIG_MAX_TRANSIENT_INDEX_BUFFER_SIZE (2<<20)
 #endif // BGFX_CONFIG_MAX_TRANSIENT_INDEX_BUFFER_SIZE
 
+#ifndef BGFX_CONFIG_MAX_TRANSIENT_BUFFER_PAGES
+/// Maximum number of transient vertex and index buffer pages per frame. First
+/// page is always allocated, other pages are allocated on demand.
+#	define BGFX_CONFIG_MAX_TRANSIENT_BUFFER_PAGES 8
+#endif // BGFX_CONFIG_MAX_TRANSIENT_BUFFER_PAGES
+
+#ifndef BGFX_CONFIG_TRANSIENT_BUFFER_TRIM_FRAMES
+/// Transient buffer pages above high-water mark are released after this many
+/// frames.
+#	define BGFX_CONFIG_TRANSIENT_BUFFER_TRIM_FRAMES 120
+#endif // BGFX_CONFIG_TRANSIENT_BUFFER_TRIM_FRAMES
+
+#ifndef BGFX_CONFIG_MEMORY_POOL
+/// Enable size-classed pool for bgfx::alloc/copy/makeRef memory blocks.
+#	define BGFX_CONFIG_MEMORY_POOL 1
+#endif // BGFX_CONFIG_MEMORY_POOL
+
+#ifndef BGFX_CONFIG_MEMORY_POOL_MAX_BLOCK_SIZE
+/// Memory blocks larger than this are allocated directly from heap.
+#	define BGFX_CONFIG_MEMORY_POOL_MAX_BLOCK_SIZE (1<<20)
+#endif // BGFX_CONFIG_MEMORY_POOL_MAX_BLOCK_SIZE
+
+#ifndef BGFX_CONFIG_MEMORY_POOL_SIZE
+/// Maximum amount of free memory blocks kept in shared pool, blocks released
+/// above this are returned to heap.
+#	define BGFX_CONFIG_MEMORY_POOL_SIZE (32<<20)
+#endif // BGFX_CONFIG_MEMORY_POOL_SIZE
+
+#ifndef BGFX_CONFIG_FRAME_ARENA
+/// Enable per-frame arena for render thread scratch allocations (texture
+/// update conversion buffers, etc.). Arena is reset after frame is rendered.
+#	define BGFX_CONFIG_FRAME_ARENA 0
+#endif // BGFX_CONFIG_FRAME_ARENA
+
+#ifndef BGFX_CONFIG_FRAME_ARENA_SIZE
+/// Initial frame arena size, arena grows when frame doesn't fit.
+#	define BGFX_CONFIG_FRAME_ARENA_SIZE (1<<20)
+#endif // BGFX_CONFIG_FRAME_ARENA_SIZE
+
 #ifndef BGFX_CONFIG_MIN_UNIFORM_BUFFER_SIZE
 /// Mimumum uniform buffer size. This buffer will resize on demand.
 #	define BGFX_CONFIG_MIN_UNIFORM_BUFFER_SIZE (1<<20)
@@ -407,6 +447,12 @@ static_assert(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS must
 #	define BGFX_CONFIG_UNIFORM_BUFFER_RESIZE_INCREMENT_SIZE (1<<20)
 #endif // BGFX_CONFIG_UNIFORM_BUFFER_RESIZE_INCREMENT_SIZE
 
+#ifndef BGFX_CONFIG_UNIFORM_DEDUP
+/// Draw that sets exactly same uniform values as previous draw reuses previous draw's uniform
+/// data, and renderer doesn't apply it again.
+#	define BGFX_CONFIG_UNIFORM_DEDUP 1
+#endif // BGFX_CONFIG_UNIFORM_DEDUP
+
 #ifndef BGFX_CONFIG_CACHED_DEVICE_MEMORY_ALLOCATIONS_SIZE
 /// Amount of allowed memory allocations left on device to use for recycling during
 /// later allocations. This can be beneficial in case the driver is slow allocating memory
@@ -464,6 +510,33 @@ static_assert(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS must
 #	define BGFX_CONFIG_RENDERDOC_CAPTURE_KEYS { eRENDERDOC_Key_F11 }
 #endif // BGFX_CONFIG_RENDERDOC_CAPTURE_KEYS
 
+/// Enable writing binary frame capture for frames submitted with
+/// BGFX_FRAME_DEBUG_CAPTURE flag. Capture can be replayed with framereplay
+/// tool. Default is 0.
+#ifndef BGFX_CONFIG_FRAME_CAPTURE
+#	define BGFX_CONFIG_FRAME_CAPTURE 0
+#endif // BGFX_CONFIG_FRAME_CAPTURE
+
+/// File path prefix for binary frame capture output, frame number and
+/// ".bgfxframe" extension are appended. Default is "temp/bgfx".
+#ifndef BGFX_CONFIG_FRAME_CAPTURE_FILEPATH
+#	define BGFX_CONFIG_FRAME_CAPTURE_FILEPATH "temp/bgfx"
+#endif // BGFX_CONFIG_FRAME_CAPTURE_FILEPATH
+
+/// Maximum used size of encoder uniform buffer that can be written into, or read from frame
+/// capture. Default is 64 MiB.
+#ifndef BGFX_CONFIG_FRAME_CAPTURE_MAX_UNIFORM_BUFFER_SIZE
+#	define BGFX_CONFIG_FRAME_CAPTURE_MAX_UNIFORM_BUFFER_SIZE (64<<20)
+#endif // BGFX_CONFIG_FRAME_CAPTURE_MAX_UNIFORM_BUFFER_SIZE
+
+/// Noop renderer walks sorted frame the same way other renderers do, with
+/// state change detection and uniform decoding, but without issuing any GPU
+/// calls. Renderer CPU cost and state, program, binding and buffer change
+/// counts are reported in Stats. Default is 0.
+#ifndef BGFX_CONFIG_NOOP_WALK_FRAME
+#	define BGFX_CONFIG_NOOP_WALK_FRAME 0
+#endif // BGFX_CONFIG_NOOP_WALK_FRAME
+
 /// Timeout in milliseconds for the API/render thread semaphore wait.
 /// Default is 5000 ms. If the wait times out, it typically indicates a
 /// deadlock or the other thread has stalled.
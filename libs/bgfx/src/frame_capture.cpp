@@ -0,0 +1,691 @@
+/*
+ * Copyright 2011-2026 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include "bgfx_p.h"
+#include "frame_capture.h"
+
+#include <bx/file.h>
+
+namespace bgfx
+{
+	static constexpr uint32_t kFrameCaptureMagic   = BX_MAKEFOURCC('B', 'G', 'F', 'C');
+	static constexpr uint32_t kFrameCaptureVersion = 2;
+
+	// Capture contains raw frame structures, and it can be replayed only by bgfx built with the same
+	// configuration. Layout part of header is compared as whole, count part is validated against
+	// limits of frame it's read into.
+	//
+	// Layout of capture file:
+	//
+	//   FrameCaptureHeader
+	//   Resolution, view remap, color palette, views, occlusion query results
+	//   Render items: sort key, RenderItem, RenderBind
+	//   Uniform buffers: used size of each buffer, followed by data of each buffer
+	//   Blit keys, blit items
+	//   Uniform cache frame keys and data
+	//   Matrix cache, rect cache
+	//   Transient index buffer pages, then transient vertex buffer pages: used size of page (zero
+	//   when page wasn't created), followed by used part of page
+	struct FrameCaptureLayout
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint32_t renderItemSize;
+		uint32_t renderBindSize;
+		uint32_t blitItemSize;
+		uint32_t viewSize;
+		uint32_t maxViews;
+		uint32_t maxColorPalette;
+		uint32_t maxOcclusionQueries;
+		uint32_t maxBlitItems;
+		uint32_t maxUniformBufferSize;
+	};
+
+	struct FrameCaptureHeader
+	{
+		FrameCaptureLayout layout;
+
+		uint32_t frameNum;
+		uint32_t debug;
+		uint32_t numRenderItems;
+		uint32_t numBlitItems;
+		uint32_t numUniformBuffers;
+		uint32_t numUniformCacheItems;
+		uint32_t uniformCacheDataSize;
+		uint32_t uniformCacheSorted;
+		uint32_t numMatrices;
+		uint32_t numRects;
+		uint32_t transientIbPageSize;
+		uint32_t transientVbPageSize;
+		uint32_t iboffset;
+		uint32_t vboffset;
+	};
+
+	static void initLayout(FrameCaptureLayout& _layout)
+	{
+		bx::memSet(&_layout, 0, sizeof(_layout) );
+		_layout.magic               = kFrameCaptureMagic;
+		_layout.version             = kFrameCaptureVersion;
+		_layout.renderItemSize      = sizeof(RenderItem);
+		_layout.renderBindSize      = sizeof(RenderBind);
+		_layout.blitItemSize        = sizeof(BlitItem);
+		_layout.viewSize            = sizeof(View);
+		_layout.maxViews            = BGFX_CONFIG_MAX_VIEWS;
+		_layout.maxColorPalette     = BGFX_CONFIG_MAX_COLOR_PALETTE;
+		_layout.maxOcclusionQueries = BGFX_CONFIG_MAX_OCCLUSION_QUERIES;
+		_layout.maxBlitItems        = BGFX_CONFIG_MAX_BLIT_ITEMS;
+		_layout.maxUniformBufferSize = BGFX_CONFIG_FRAME_CAPTURE_MAX_UNIFORM_BUFFER_SIZE;
+	}
+
+	// Collects render items in the order they were committed by encoders, before sorting.
+	static uint32_t getRenderItems(const Frame* _frame, uint64_t* _keys, RenderItemCount* _values)
+	{
+		uint32_t num = 0;
+
+		if (NULL != _frame->m_sortKeyRun)
+		{
+			for (uint32_t ii = 0, numRuns = _frame->m_numSortKeyRuns; ii < numRuns; ++ii)
+			{
+				const SortKeyRun& run = _frame->m_sortKeyRun[ii];
+
+				bx::memCopy(&_keys[num],   run.m_keys,   run.m_num*sizeof(uint64_t) );
+				bx::memCopy(&_values[num], run.m_values, run.m_num*sizeof(RenderItemCount) );
+				num += run.m_num;
+			}
+		}
+		else
+		{
+			for (uint32_t ii = 0, numChunks = _frame->m_numRenderItemChunks; ii < numChunks; ++ii)
+			{
+				const RenderItemChunk& chunk = _frame->m_renderItemChunk[ii];
+				const RenderItemPage*  page  = _frame->m_renderItemPage[chunk.m_begin >> RenderItemPage::kShift];
+
+				bx::memCopy(&_keys[num], &page->m_sortKey[chunk.m_begin & RenderItemPage::kMask], chunk.m_num*sizeof(uint64_t) );
+
+				for (uint32_t jj = 0; jj < chunk.m_num; ++jj)
+				{
+					_values[num+jj] = RenderItemCount(chunk.m_begin+jj);
+				}
+
+				num += chunk.m_num;
+			}
+		}
+
+		return num;
+	}
+
+	static uint32_t getUniformCacheDataSize(const UniformCacheFrame& _uniformCacheFrame)
+	{
+		uint32_t size = 0;
+
+		for (uint32_t ii = 0, num = _uniformCacheFrame.m_numItems; ii < num; ++ii)
+		{
+			UniformCacheKey key;
+			key.decode(_uniformCacheFrame.m_keys[ii]);
+			size = bx::max(size, key.m_offset + key.m_size);
+		}
+
+		return size;
+	}
+
+	static bool isHandleInRange(uint16_t _idx, uint32_t _max)
+	{
+		return kInvalidHandle == _idx
+			|| _idx < _max
+			;
+	}
+
+	static bool isUniformRangeValid(uint8_t _uniformIdx, uint32_t _uniformBegin, uint32_t _uniformEnd, const uint32_t* _uniformBufferSize, uint32_t _numUniformBuffers)
+	{
+		return _uniformIdx   < _numUniformBuffers
+			&& _uniformBegin <= _uniformEnd
+			&& _uniformEnd   <= _uniformBufferSize[_uniformIdx]
+			;
+	}
+
+	static bool isMatrixRangeValid(uint32_t _startMatrix, uint16_t _numMatrices, uint32_t _numCached)
+	{
+		return uint64_t(_startMatrix) + _numMatrices <= _numCached;
+	}
+
+	static bool isRenderBindValid(const RenderBind& _renderBind)
+	{
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++ii)
+		{
+			const Binding& bind = _renderBind.m_bind[ii];
+
+			if (kInvalidHandle == bind.m_idx)
+			{
+				continue;
+			}
+
+			uint32_t max = 0;
+			switch (bind.m_type)
+			{
+			case Binding::Image:
+			case Binding::Texture:      max = g_caps.limits.maxTextures;      break;
+			case Binding::IndexBuffer:  max = g_caps.limits.maxIndexBuffers;  break;
+			case Binding::VertexBuffer: max = g_caps.limits.maxVertexBuffers; break;
+			default:                                                          break;
+			}
+
+			if (bind.m_idx >= max)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	static bool isRenderItemValid(Frame* _frame, uint64_t _key, const RenderItem& _renderItem, const RenderBind& _renderBind, const uint32_t* _uniformBufferSize, uint32_t _numUniformBuffers)
+	{
+		const uint32_t numMatrices = _frame->m_frameCache.m_matrixCache.m_num;
+
+		SortKey key;
+		const bool isCompute = key.decode(_key, _frame->m_viewRemap);
+
+		if (key.m_program.idx >= g_caps.limits.maxPrograms
+		||  !isRenderBindValid(_renderBind) )
+		{
+			return false;
+		}
+
+		if (isCompute)
+		{
+			const RenderCompute& compute = _renderItem.compute;
+
+			return true
+				&& isUniformRangeValid(compute.m_uniformIdx, compute.m_uniformBegin, compute.m_uniformEnd, _uniformBufferSize, _numUniformBuffers)
+				&& isMatrixRangeValid(compute.m_startMatrix, compute.m_numMatrices, numMatrices)
+				&& isHandleInRange(compute.m_indirectBuffer.idx, g_caps.limits.maxVertexBuffers)
+				;
+		}
+
+		const RenderDraw& draw = _renderItem.draw;
+
+		if (UINT8_MAX != draw.m_streamMask)
+		{
+			if (0 != (uint32_t(draw.m_streamMask) >> BGFX_CONFIG_MAX_VERTEX_STREAMS) )
+			{
+				return false;
+			}
+
+			for (BitMaskToIndexIteratorT it(draw.m_streamMask); !it.isDone(); it.next() )
+			{
+				const Stream& stream = draw.m_stream[it.idx];
+
+				if (stream.m_handle.idx >= g_caps.limits.maxVertexBuffers
+				||  !isHandleInRange(stream.m_layoutHandle.idx, g_caps.limits.maxVertexLayouts) )
+				{
+					return false;
+				}
+			}
+		}
+
+		return true
+			&& isUniformRangeValid(draw.m_uniformIdx, draw.m_uniformBegin, draw.m_uniformEnd, _uniformBufferSize, _numUniformBuffers)
+			&& isMatrixRangeValid(draw.m_startMatrix, draw.m_numMatrices, numMatrices)
+			&& (UINT16_MAX == draw.m_scissor || draw.m_scissor < _frame->m_frameCache.m_rectCache.m_num)
+			&& isHandleInRange(draw.m_indexBuffer.idx,        g_caps.limits.maxIndexBuffers)
+			&& isHandleInRange(draw.m_instanceDataBuffer.idx, g_caps.limits.maxVertexBuffers)
+			&& isHandleInRange(draw.m_indirectBuffer.idx,     g_caps.limits.maxVertexBuffers)
+			&& isHandleInRange(draw.m_numIndirectBuffer.idx,  g_caps.limits.maxIndexBuffers)
+			&& isHandleInRange(draw.m_occlusionQuery.idx,     g_caps.limits.maxOcclusionQueries)
+			;
+	}
+
+	static bool isBlitItemValid(uint32_t _key, const BlitItem& _blitItem, uint32_t _numBlitItems)
+	{
+		BlitKey key;
+		key.decode(_key);
+
+		return true
+			&& key.m_view < BGFX_CONFIG_MAX_VIEWS
+			&& key.m_item < _numBlitItems
+			&& Handle::Texture == _blitItem.m_src.type
+			&& Handle::Texture == _blitItem.m_dst.type
+			&& _blitItem.m_src.idx < g_caps.limits.maxTextures
+			&& _blitItem.m_dst.idx < g_caps.limits.maxTextures
+			;
+	}
+
+	// Render items, binds, blit items and uniform cache keys are read as raw structures, indices and handles
+	// in them must be checked before renderer dereferences them.
+	static bool isFrameValid(Frame* _frame, const uint32_t* _uniformBufferSize, uint32_t _numUniformBuffers, uint32_t _uniformCacheDataSize)
+	{
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+		{
+			if (_frame->m_viewRemap[ii] >= BGFX_CONFIG_MAX_VIEWS)
+			{
+				return false;
+			}
+		}
+
+		for (uint32_t ii = 0, numChunks = _frame->m_numRenderItemChunks; ii < numChunks; ++ii)
+		{
+			const RenderItemChunk& chunk = _frame->m_renderItemChunk[ii];
+			const RenderItemPage*  page  = _frame->m_renderItemPage[chunk.m_begin >> RenderItemPage::kShift];
+
+			for (uint32_t jj = 0; jj < chunk.m_num; ++jj)
+			{
+				const uint32_t item = (chunk.m_begin+jj) & RenderItemPage::kMask;
+
+				if (!isRenderItemValid(_frame, page->m_sortKey[item], page->m_renderItem[item], page->m_renderItemBind[item], _uniformBufferSize, _numUniformBuffers) )
+				{
+					return false;
+				}
+			}
+		}
+
+		for (uint32_t ii = 0, num = _frame->m_numBlitItems; ii < num; ++ii)
+		{
+			if (!isBlitItemValid(_frame->m_blitKeys[ii], _frame->m_blitItem[ii], num) )
+			{
+				return false;
+			}
+		}
+
+		const UniformCacheFrame& uniformCacheFrame = _frame->m_uniformCacheFrame;
+
+		for (uint32_t ii = 0, num = uniformCacheFrame.m_numItems; ii < num; ++ii)
+		{
+			UniformCacheKey key;
+			key.decode(uniformCacheFrame.m_keys[ii]);
+
+			if (key.m_handle >= g_caps.limits.maxUniforms
+			||  key.m_offset + key.m_size > _uniformCacheDataSize)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	static TransientIndexBuffer* createReplayTransientIndexBuffer(uint32_t _size)
+	{
+		const uint32_t size = 0
+			+ bx::alignUp<uint32_t>(sizeof(TransientIndexBuffer), 16)
+			+ bx::alignUp(_size, 16)
+			;
+		TransientIndexBuffer* tib = (TransientIndexBuffer*)bx::alignedAlloc(g_allocator, size, 16);
+		tib->data       = (uint8_t*)tib + bx::alignUp(sizeof(TransientIndexBuffer), 16);
+		tib->size       = _size;
+		tib->startIndex = 0;
+		tib->handle     = BGFX_INVALID_HANDLE;
+		tib->isIndex16  = true;
+
+		return tib;
+	}
+
+	static TransientVertexBuffer* createReplayTransientVertexBuffer(uint32_t _size)
+	{
+		const uint32_t size = 0
+			+ bx::alignUp<uint32_t>(sizeof(TransientVertexBuffer), 16)
+			+ bx::alignUp(_size, 16)
+			;
+		TransientVertexBuffer* tvb = (TransientVertexBuffer*)bx::alignedAlloc(g_allocator, size, 16);
+		tvb->data         = (uint8_t*)tvb + bx::alignUp(sizeof(TransientVertexBuffer), 16);
+		tvb->size         = _size;
+		tvb->startVertex  = 0;
+		tvb->stride       = 0;
+		tvb->handle       = BGFX_INVALID_HANDLE;
+		tvb->layoutHandle = BGFX_INVALID_HANDLE;
+
+		return tvb;
+	}
+
+	void frameCaptureWrite(bx::WriterI* _writer, const Frame* _frame, bx::Error* _err)
+	{
+		BX_ERROR_SCOPE(_err, "Frame capture");
+
+		const uint32_t numUniformBuffers = g_caps.limits.maxEncoders;
+
+		uint64_t*        keys   = (uint64_t*)bx::alloc(g_allocator, bx::max(_frame->m_numRenderItems, 1u)*sizeof(uint64_t) );
+		RenderItemCount* values = (RenderItemCount*)bx::alloc(g_allocator, bx::max(_frame->m_numRenderItems, 1u)*sizeof(RenderItemCount) );
+		const uint32_t numRenderItems = getRenderItems(_frame, keys, values);
+
+		// Uniform buffer position is rewound when encoder finishes, used size is where last render
+		// item's uniforms end.
+		uint32_t* uniformBufferSize = (uint32_t*)BX_STACK_ALLOC(numUniformBuffers*sizeof(uint32_t) );
+		bx::memSet(uniformBufferSize, 0, numUniformBuffers*sizeof(uint32_t) );
+
+		for (uint32_t ii = 0; ii < numRenderItems; ++ii)
+		{
+			const RenderItem& renderItem = _frame->getRenderItem(values[ii]);
+			const bool isDraw = 0 != (keys[ii] & kSortKeyDrawBit);
+
+			const uint8_t  uniformIdx = isDraw ? renderItem.draw.m_uniformIdx : renderItem.compute.m_uniformIdx;
+			const uint32_t uniformEnd = isDraw ? renderItem.draw.m_uniformEnd : renderItem.compute.m_uniformEnd;
+
+			if (uniformIdx < numUniformBuffers)
+			{
+				uniformBufferSize[uniformIdx] = bx::max(uniformBufferSize[uniformIdx], uniformEnd);
+			}
+		}
+
+		for (uint32_t ii = 0; ii < numUniformBuffers; ++ii)
+		{
+			if (uniformBufferSize[ii] > BGFX_CONFIG_FRAME_CAPTURE_MAX_UNIFORM_BUFFER_SIZE)
+			{
+				bx::free(g_allocator, keys);
+				bx::free(g_allocator, values);
+
+				BX_ERROR_SET(_err, BGFX_ERROR_FRAME_CAPTURE_VALIDATION, "Uniform buffer is larger than frame capture limit.");
+				return;
+			}
+		}
+
+		const UniformCacheFrame& uniformCacheFrame = _frame->m_uniformCacheFrame;
+		const FrameCache&        frameCache        = _frame->m_frameCache;
+
+		FrameCaptureHeader header;
+		bx::memSet(&header, 0, sizeof(header) );
+		initLayout(header.layout);
+		header.frameNum             = _frame->m_frameNum;
+		header.debug                = _frame->m_debug;
+		header.numRenderItems       = numRenderItems;
+		header.numBlitItems         = _frame->m_numBlitItems;
+		header.numUniformBuffers    = numUniformBuffers;
+		header.numUniformCacheItems = uniformCacheFrame.m_numItems;
+		header.uniformCacheDataSize = getUniformCacheDataSize(uniformCacheFrame);
+		header.uniformCacheSorted   = uniformCacheFrame.m_sorted;
+		header.numMatrices          = frameCache.m_matrixCache.m_num;
+		header.numRects             = frameCache.m_rectCache.m_num;
+		header.transientIbPageSize  = g_caps.limits.maxTransientIbSize;
+		header.transientVbPageSize  = g_caps.limits.maxTransientVbSize;
+		header.iboffset             = _frame->m_iboffset;
+		header.vboffset             = _frame->m_vboffset;
+
+		bx::write(_writer, header, _err);
+
+		bx::write(_writer, _frame->m_resolution, _err);
+		bx::write(_writer, _frame->m_viewRemap,    sizeof(_frame->m_viewRemap),    _err);
+		bx::write(_writer, _frame->m_colorPalette, sizeof(_frame->m_colorPalette), _err);
+		bx::write(_writer, _frame->m_view,         sizeof(_frame->m_view),         _err);
+		bx::write(_writer, _frame->m_occlusion,    sizeof(_frame->m_occlusion),    _err);
+
+		for (uint32_t ii = 0; ii < numRenderItems && _err->isOk(); ++ii)
+		{
+			bx::write(_writer, keys[ii], _err);
+			bx::write(_writer, &_frame->getRenderItem(values[ii]),     sizeof(RenderItem), _err);
+			bx::write(_writer, &_frame->getRenderItemBind(values[ii]), sizeof(RenderBind), _err);
+		}
+
+		bx::free(g_allocator, keys);
+		bx::free(g_allocator, values);
+
+		bx::write(_writer, uniformBufferSize, numUniformBuffers*sizeof(uint32_t), _err);
+
+		for (uint32_t ii = 0; ii < numUniformBuffers; ++ii)
+		{
+			bx::write(_writer, _frame->m_uniformBuffer[ii]->getData(), uniformBufferSize[ii], _err);
+		}
+
+		bx::write(_writer, _frame->m_blitKeys, header.numBlitItems*sizeof(uint32_t), _err);
+		bx::write(_writer, _frame->m_blitItem, header.numBlitItems*sizeof(BlitItem), _err);
+
+		bx::write(_writer, uniformCacheFrame.m_keys, header.numUniformCacheItems*sizeof(uint64_t), _err);
+		bx::write(_writer, uniformCacheFrame.m_data, header.uniformCacheDataSize, _err);
+
+		bx::write(_writer, frameCache.m_matrixCache.m_cache, header.numMatrices*sizeof(Matrix4), _err);
+		bx::write(_writer, frameCache.m_rectCache.m_cache,   header.numRects*sizeof(Rect),      _err);
+
+		// Page creation can fail, nothing is allocated from page that doesn't exist.
+		for (uint32_t ii = 0, num = _frame->getNumTransientIbPages(); ii < num; ++ii)
+		{
+			const TransientIndexBuffer* tib = _frame->m_transientIb[ii];
+			const uint32_t used = NULL != tib ? _frame->getTransientIbPageUsed(ii) : 0;
+
+			bx::write(_writer, used, _err);
+
+			if (0 < used)
+			{
+				bx::write(_writer, tib->data, used, _err);
+			}
+		}
+
+		for (uint32_t ii = 0, num = _frame->getNumTransientVbPages(); ii < num; ++ii)
+		{
+			const TransientVertexBuffer* tvb = _frame->m_transientVb[ii];
+			const uint32_t used = NULL != tvb ? _frame->getTransientVbPageUsed(ii) : 0;
+
+			bx::write(_writer, used, _err);
+
+			if (0 < used)
+			{
+				bx::write(_writer, tvb->data, used, _err);
+			}
+		}
+	}
+
+	void frameCaptureSave(const Frame* _frame)
+	{
+		char filePath[bx::kMaxFilePath];
+		bx::snprintf(filePath, BX_COUNTOF(filePath), "%s-%d.bgfxframe", BGFX_CONFIG_FRAME_CAPTURE_FILEPATH, _frame->m_frameNum);
+
+		const bx::FilePath fp(filePath);
+		bx::makeAll(fp.getPath() );
+
+		bx::Error err;
+		bx::FileWriter writer;
+		if (bx::open(&writer, fp, false, &err) )
+		{
+			frameCaptureWrite(&writer, _frame, &err);
+			bx::close(&writer);
+		}
+
+		BX_WARN(err.isOk(), "Failed to write frame capture '%s'.", filePath);
+	}
+
+	bool frameCaptureRead(bx::ReaderI* _reader, Frame* _frame, bx::Error* _err)
+	{
+		BX_ERROR_SCOPE(_err, "Frame capture");
+
+		FrameCaptureHeader header;
+		bx::read(_reader, header, _err);
+
+		if (!_err->isOk() )
+		{
+			return false;
+		}
+
+		FrameCaptureLayout layout;
+		initLayout(layout);
+
+		if (0 != bx::memCmp(&layout, &header.layout, sizeof(layout) ) )
+		{
+			BX_ERROR_SET(_err, BGFX_ERROR_FRAME_CAPTURE_VALIDATION, "Frame capture was written by incompatible bgfx build.");
+			return false;
+		}
+
+		// Uniform cache has at most one item per uniform per view, and frame uniforms. Data size is
+		// limited by offset and size encodable in UniformCacheKey.
+		const uint32_t maxUniformCacheItems    = g_caps.limits.maxUniforms*(BGFX_CONFIG_MAX_VIEWS+1);
+		const uint32_t maxUniformCacheDataSize = 0
+			+ ( (uint32_t(UniformCacheKey::kOffsetMask>>UniformCacheKey::kOffsetShift) + 1)<<4)
+			+ ( (uint32_t(UniformCacheKey::kSizeMask  >>UniformCacheKey::kSizeShift  ) + 1)<<4)
+			;
+
+		if (header.numRenderItems       > g_caps.limits.maxDrawCalls
+		||  header.numBlitItems         > BGFX_CONFIG_MAX_BLIT_ITEMS
+		||  header.numUniformBuffers    > g_caps.limits.maxEncoders
+		||  header.numUniformCacheItems > maxUniformCacheItems
+		||  header.uniformCacheDataSize > maxUniformCacheDataSize
+		||  header.numMatrices          > _frame->m_frameCache.m_matrixCache.m_capacity
+		||  header.numRects             > BGFX_CONFIG_MAX_RECT_CACHE
+		||  header.transientIbPageSize != g_caps.limits.maxTransientIbSize
+		||  header.transientVbPageSize != g_caps.limits.maxTransientVbSize
+		||  header.iboffset             > _frame->m_transientIbMax
+		||  header.vboffset             > _frame->m_transientVbMax)
+		{
+			BX_ERROR_SET(_err, BGFX_ERROR_FRAME_CAPTURE_VALIDATION, "Frame capture doesn't fit into limits bgfx is initialized with.");
+			return false;
+		}
+
+		_frame->m_frameNum = header.frameNum;
+		_frame->m_debug    = header.debug;
+
+		bx::read(_reader, _frame->m_resolution, _err);
+		bx::read(_reader, _frame->m_viewRemap,    sizeof(_frame->m_viewRemap),    _err);
+		bx::read(_reader, _frame->m_colorPalette, sizeof(_frame->m_colorPalette), _err);
+		bx::read(_reader, _frame->m_view,         sizeof(_frame->m_view),         _err);
+		bx::read(_reader, _frame->m_occlusion,    sizeof(_frame->m_occlusion),    _err);
+
+		// Frame buffers don't exist when capture is replayed, views render into backbuffer.
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+		{
+			_frame->m_view[ii].m_fbh = BGFX_INVALID_HANDLE;
+		}
+
+		for (uint32_t ii = 0, num = header.numRenderItems; ii < num && _err->isOk();)
+		{
+			uint32_t begin;
+			const uint32_t reserved = bx::min(_frame->reserveRenderItems(begin), num - ii);
+
+			RenderItemPage* page = _frame->getRenderItemPage(begin);
+
+			for (uint32_t jj = 0; jj < reserved; ++jj)
+			{
+				const uint32_t item = (begin+jj) & RenderItemPage::kMask;
+
+				bx::read(_reader, page->m_sortKey[item], _err);
+				bx::read(_reader, &page->m_renderItem[item],     sizeof(RenderItem), _err);
+				bx::read(_reader, &page->m_renderItemBind[item], sizeof(RenderBind), _err);
+			}
+
+			_frame->commitRenderItems(begin, reserved);
+			ii += reserved;
+		}
+
+		if (!_err->isOk() )
+		{
+			return false;
+		}
+
+		uint32_t* uniformBufferSize = (uint32_t*)BX_STACK_ALLOC(header.numUniformBuffers*sizeof(uint32_t) );
+		bx::read(_reader, uniformBufferSize, header.numUniformBuffers*sizeof(uint32_t), _err);
+
+		for (uint32_t ii = 0, num = header.numUniformBuffers; ii < num && _err->isOk(); ++ii)
+		{
+			if (uniformBufferSize[ii] > header.layout.maxUniformBufferSize)
+			{
+				BX_ERROR_SET(_err, BGFX_ERROR_FRAME_CAPTURE_VALIDATION, "Frame capture uniform buffer size is out of range.");
+				return false;
+			}
+		}
+
+		for (uint32_t ii = 0, num = header.numUniformBuffers; ii < num && _err->isOk(); ++ii)
+		{
+			const uint32_t size = uniformBufferSize[ii];
+
+			if (0 < size)
+			{
+				void* data = bx::alloc(g_allocator, size);
+				bx::read(_reader, data, size, _err);
+
+				UniformBuffer::destroy(_frame->m_uniformBuffer[ii]);
+				UniformBuffer* uniformBuffer = UniformBuffer::create(bx::max(g_caps.limits.minUniformBufferSize, size + 16) );
+				uniformBuffer->write(data, size);
+				uniformBuffer->finish();
+				_frame->m_uniformBuffer[ii] = uniformBuffer;
+
+				bx::free(g_allocator, data);
+			}
+		}
+
+		_frame->m_numBlitItems = header.numBlitItems;
+		bx::read(_reader, _frame->m_blitKeys, header.numBlitItems*sizeof(uint32_t), _err);
+		bx::read(_reader, _frame->m_blitItem, header.numBlitItems*sizeof(BlitItem), _err);
+
+		UniformCacheFrame& uniformCacheFrame = _frame->m_uniformCacheFrame;
+		uniformCacheFrame.resize(header.numUniformCacheItems, header.uniformCacheDataSize);
+		uniformCacheFrame.m_numItems = header.numUniformCacheItems;
+		uniformCacheFrame.m_sorted   = 0 != header.uniformCacheSorted;
+		bx::read(_reader, uniformCacheFrame.m_keys, header.numUniformCacheItems*sizeof(uint64_t), _err);
+		bx::read(_reader, uniformCacheFrame.m_data, header.uniformCacheDataSize, _err);
+
+		FrameCache& frameCache = _frame->m_frameCache;
+		frameCache.m_matrixCache.m_num = header.numMatrices;
+		frameCache.m_rectCache.m_num   = header.numRects;
+		bx::read(_reader, frameCache.m_matrixCache.m_cache, header.numMatrices*sizeof(Matrix4), _err);
+		bx::read(_reader, frameCache.m_rectCache.m_cache,   header.numRects*sizeof(Rect),      _err);
+
+		if (!_err->isOk() )
+		{
+			return false;
+		}
+
+		if (!isFrameValid(_frame, uniformBufferSize, header.numUniformBuffers, header.uniformCacheDataSize) )
+		{
+			BX_ERROR_SET(_err, BGFX_ERROR_FRAME_CAPTURE_VALIDATION, "Frame capture contains render item, blit item or uniform out of range.");
+			return false;
+		}
+
+		_frame->m_iboffset = header.iboffset;
+		_frame->m_vboffset = header.vboffset;
+
+		for (uint32_t ii = 0, num = _frame->getNumTransientIbPages(); ii < num && _err->isOk(); ++ii)
+		{
+			uint32_t used;
+			bx::read(_reader, used, _err);
+
+			if (used > _frame->getTransientIbPageUsed(ii) )
+			{
+				BX_ERROR_SET(_err, BGFX_ERROR_FRAME_CAPTURE_VALIDATION, "Frame capture transient index buffer page size is out of range.");
+				return false;
+			}
+
+			if (0 < used)
+			{
+				_frame->m_transientIb[ii] = createReplayTransientIndexBuffer(header.transientIbPageSize);
+				bx::read(_reader, _frame->m_transientIb[ii]->data, used, _err);
+			}
+		}
+
+		for (uint32_t ii = 0, num = _frame->getNumTransientVbPages(); ii < num && _err->isOk(); ++ii)
+		{
+			uint32_t used;
+			bx::read(_reader, used, _err);
+
+			if (used > _frame->getTransientVbPageUsed(ii) )
+			{
+				BX_ERROR_SET(_err, BGFX_ERROR_FRAME_CAPTURE_VALIDATION, "Frame capture transient vertex buffer page size is out of range.");
+				return false;
+			}
+
+			if (0 < used)
+			{
+				_frame->m_transientVb[ii] = createReplayTransientVertexBuffer(header.transientVbPageSize);
+				bx::read(_reader, _frame->m_transientVb[ii]->data, used, _err);
+			}
+		}
+
+		return _err->isOk();
+	}
+
+	void frameCaptureFree(Frame* _frame)
+	{
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_TRANSIENT_BUFFER_PAGES; ++ii)
+		{
+			if (NULL != _frame->m_transientIb[ii])
+			{
+				bx::alignedFree(g_allocator, _frame->m_transientIb[ii], 16);
+				_frame->m_transientIb[ii] = NULL;
+			}
+
+			if (NULL != _frame->m_transientVb[ii])
+			{
+				bx::alignedFree(g_allocator, _frame->m_transientVb[ii], 16);
+				_frame->m_transientVb[ii] = NULL;
+			}
+		}
+
+		_frame->m_iboffset = 0;
+		_frame->m_vboffset = 0;
+	}
+
+} // namespace bgfx
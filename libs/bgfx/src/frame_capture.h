@@ -0,0 +1,50 @@
+/*
+ * Copyright 2011-2026 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef BGFX_FRAME_CAPTURE_H_HEADER_GUARD
+#define BGFX_FRAME_CAPTURE_H_HEADER_GUARD
+
+#include <bx/readerwriter.h>
+
+BX_ERROR_RESULT(BGFX_ERROR_FRAME_CAPTURE_VALIDATION, BX_MAKEFOURCC('b', 'g', 0, 4) );
+
+namespace bgfx
+{
+	struct Frame;
+
+	/// Replay timings, summed over all iterations.
+	struct FrameReplayStats
+	{
+		uint32_t frameNum;       //!< Frame number of captured frame.
+		uint32_t numRenderItems; //!< Number of draw and compute items in captured frame.
+		uint32_t numBlitItems;   //!< Number of blit items in captured frame.
+		uint32_t numIterations;  //!< Number of times frame was replayed.
+		int64_t  sortTime;       //!< Time spent in Frame::sort.
+		int64_t  submitTime;     //!< Time spent in renderer submit.
+		int64_t  timerFreq;      //!< Timer frequency for sort and submit times.
+	};
+
+	/// Writes frame state consumed by renderer submit into binary capture. Command buffers and debug
+	/// text are not captured, resources referenced by frame must be recreated by whoever replays it.
+	void frameCaptureWrite(bx::WriterI* _writer, const Frame* _frame, bx::Error* _err);
+
+	/// Reads binary capture into frame created with Frame::create. Frame buffers referenced by views
+	/// are dropped, and transient buffers are created without renderer buffers.
+	bool frameCaptureRead(bx::ReaderI* _reader, Frame* _frame, bx::Error* _err);
+
+	/// Releases transient buffers allocated by frameCaptureRead.
+	void frameCaptureFree(Frame* _frame);
+
+	/// Writes frame to BGFX_CONFIG_FRAME_CAPTURE_FILEPATH-<frame number>.bgfxframe file.
+	void frameCaptureSave(const Frame* _frame);
+
+	/// Reads binary capture and submits it to renderer _numIterations times, each time sorting frame
+	/// again. Must be called on API thread in single-threaded mode, with Noop renderer, since
+	/// resources referenced by captured frame don't exist.
+	bool frameReplay(bx::ReaderI* _reader, uint32_t _numIterations, FrameReplayStats* _stats, bx::Error* _err);
+
+} // namespace bgfx
+
+#endif // BGFX_FRAME_CAPTURE_H_HEADER_GUARD
@@ -4941,12 +4941,13 @@ namespace bgfx { namespace d3d11
 		const bool convert = m_textureFormat != m_requestedFormat;
 
 		uint8_t* data = _mem->data;
+		bx::AllocatorI* allocator = getFrameAllocator();
 		uint8_t* temp = NULL;
 
 		if (convert)
 		{
-			temp = (uint8_t*)bx::alloc(g_allocator, slicepitch);
-			bimg::imageDecodeToBgra8(g_allocator, temp, data, _rect.m_width, _rect.m_height, srcpitch, bimg::TextureFormat::Enum(m_requestedFormat) );
+			temp = (uint8_t*)bx::alloc(allocator, slicepitch);
+			bimg::imageDecodeToBgra8(allocator, temp, data, _rect.m_width, _rect.m_height, srcpitch, bimg::TextureFormat::Enum(m_requestedFormat) );
 			data = temp;
 
 			box.right  = bx::max(1u, m_width  >> _mip);
@@ -4964,7 +4965,7 @@ namespace bgfx { namespace d3d11
 
 		if (NULL != temp)
 		{
-			bx::free(g_allocator, temp);
+			bx::free(allocator, temp);
 		}
 	}
 
@@ -5752,18 +5753,24 @@ namespace bgfx { namespace d3d11
 			frameQueryIdx = m_gpuTimer.begin(BGFX_CONFIG_MAX_VIEWS, _render->m_frameNum);
 		}
 
-		if (0 < _render->m_iboffset)
+		for (uint32_t ii = 0, num = _render->getNumTransientIbPages(); ii < num; ++ii)
 		{
 			BGFX_PROFILER_SCOPE("bgfx/Update transient index buffer", kColorResource);
-			TransientIndexBuffer* ib = _render->m_transientIb;
-			m_indexBuffers[ib->handle.idx].update(0, _render->m_iboffset, ib->data, true);
+			TransientIndexBuffer* ib = _render->m_transientIb[ii];
+			if (NULL != ib)
+			{
+				m_indexBuffers[ib->handle.idx].update(0, _render->getTransientIbPageUsed(ii), ib->data, true);
+			}
 		}
 
-		if (0 < _render->m_vboffset)
+		for (uint32_t ii = 0, num = _render->getNumTransientVbPages(); ii < num; ++ii)
 		{
 			BGFX_PROFILER_SCOPE("bgfx/Update transient vertex buffer", kColorResource);
-			TransientVertexBuffer* vb = _render->m_transientVb;
-			m_vertexBuffers[vb->handle.idx].update(0, _render->m_vboffset, vb->data, true);
+			TransientVertexBuffer* vb = _render->m_transientVb[ii];
+			if (NULL != vb)
+			{
+				m_vertexBuffers[vb->handle.idx].update(0, _render->getTransientVbPageUsed(ii), vb->data, true);
+			}
 		}
 
 		_render->sort();
@@ -5843,8 +5850,8 @@ namespace bgfx { namespace d3d11
 					;
 
 				const uint32_t itemIdx       = _render->m_sortValues[item];
-				const RenderItem& renderItem = _render->m_renderItem[itemIdx];
-				const RenderBind& renderBind = _render->m_renderItemBind[itemIdx];
+				const RenderItem& renderItem = _render->getRenderItem(itemIdx);
+				const RenderBind& renderBind = _render->getRenderItemBind(itemIdx);
 				++item;
 
 				if (viewChanged)
@@ -6211,8 +6218,7 @@ namespace bgfx { namespace d3d11
 				}
 
 				bool programChanged = false;
-				bool constantsChanged = draw.m_uniformBegin < draw.m_uniformEnd;
-				rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd);
+				bool constantsChanged = rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd);
 
 				if (key.m_program.idx != currentProgram.idx)
 				{
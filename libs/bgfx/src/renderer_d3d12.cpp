@@ -6003,12 +6003,13 @@ namespace bgfx { namespace d3d12
 		const uint32_t subres = _mip + ((layer + _side) * m_numMips);
 
 		uint8_t* srcData = _mem->data;
+		bx::AllocatorI* allocator = getFrameAllocator();
 		uint8_t* temp = NULL;
 
 		if (convert)
 		{
-			temp = (uint8_t*)bx::alloc(g_allocator, slicepitch);
-			bimg::imageDecodeToBgra8(g_allocator, temp, srcData, _rect.m_width, _rect.m_height, srcpitch, bimg::TextureFormat::Enum(m_requestedFormat) );
+			temp = (uint8_t*)bx::alloc(allocator, slicepitch);
+			bimg::imageDecodeToBgra8(allocator, temp, srcData, _rect.m_width, _rect.m_height, srcpitch, bimg::TextureFormat::Enum(m_requestedFormat) );
 			srcData = temp;
 
 			box.right  = bx::max(1u, m_width  >> _mip);
@@ -6045,7 +6046,7 @@ namespace bgfx { namespace d3d12
 
 		if (NULL != temp)
 		{
-			bx::free(g_allocator, temp);
+			bx::free(allocator, temp);
 		}
 
 		D3D12_RANGE writeRange = { 0, numRows*rowPitch };
@@ -6882,18 +6883,24 @@ namespace bgfx { namespace d3d12
 
 		uint32_t frameQueryIdx = m_gpuTimer.begin(BGFX_CONFIG_MAX_VIEWS, _render->m_frameNum);
 
-		if (0 < _render->m_iboffset)
+		for (uint32_t ii = 0, num = _render->getNumTransientIbPages(); ii < num; ++ii)
 		{
 			BGFX_PROFILER_SCOPE("bgfx/Update transient index buffer", kColorResource);
-			TransientIndexBuffer* ib = _render->m_transientIb;
-			m_indexBuffers[ib->handle.idx].update(m_commandList, 0, _render->m_iboffset, ib->data);
+			TransientIndexBuffer* ib = _render->m_transientIb[ii];
+			if (NULL != ib)
+			{
+				m_indexBuffers[ib->handle.idx].update(m_commandList, 0, _render->getTransientIbPageUsed(ii), ib->data);
+			}
 		}
 
-		if (0 < _render->m_vboffset)
+		for (uint32_t ii = 0, num = _render->getNumTransientVbPages(); ii < num; ++ii)
 		{
 			BGFX_PROFILER_SCOPE("bgfx/Update transient vertex buffer", kColorResource);
-			TransientVertexBuffer* vb = _render->m_transientVb;
-			m_vertexBuffers[vb->handle.idx].update(m_commandList, 0, _render->m_vboffset, vb->data);
+			TransientVertexBuffer* vb = _render->m_transientVb[ii];
+			if (NULL != vb)
+			{
+				m_vertexBuffers[vb->handle.idx].update(m_commandList, 0, _render->getTransientVbPageUsed(ii), vb->data);
+			}
 		}
 
 		_render->sort();
@@ -7018,8 +7025,8 @@ namespace bgfx { namespace d3d12
 					;
 
 				const uint32_t itemIdx       = _render->m_sortValues[item];
-				const RenderItem& renderItem = _render->m_renderItem[itemIdx];
-				const RenderBind& renderBind = _render->m_renderItemBind[itemIdx];
+				const RenderItem& renderItem = _render->getRenderItem(itemIdx);
+				const RenderBind& renderBind = _render->getRenderItemBind(itemIdx);
 				++item;
 
 				if (viewChanged)
@@ -7373,8 +7380,7 @@ namespace bgfx { namespace d3d12
 						primIndex = uint8_t(pt>>BGFX_STATE_PT_SHIFT);
 					}
 
-					bool constantsChanged = draw.m_uniformBegin < draw.m_uniformEnd;
-					rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd);
+					bool constantsChanged = rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd);
 
 					currentState.m_streamMask             = draw.m_streamMask;
 					currentState.m_instanceDataBuffer.idx = draw.m_instanceDataBuffer.idx;
@@ -7604,6 +7610,8 @@ namespace bgfx { namespace d3d12
 							scissorRect.setIntersect(viewScissorRect, _render->m_frameCache.m_rectCache.m_cache[scissor]);
 							if (scissorRect.isZeroArea() )
 							{
+								// Uniforms were applied but not committed.
+								rendererResetUniforms();
 								continue;
 							}
 
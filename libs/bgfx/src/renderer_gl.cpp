@@ -6022,11 +6022,12 @@ namespace bgfx { namespace gl
 		uint32_t width  = rect.m_width;
 		uint32_t height = rect.m_height;
 
+		bx::AllocatorI* allocator = getFrameAllocator();
 		uint8_t* temp = NULL;
 		if (convert
 		||  !unpackRowLength)
 		{
-			temp = (uint8_t*)bx::alloc(g_allocator, rectpitch*height);
+			temp = (uint8_t*)bx::alloc(allocator, rectpitch*height);
 		}
 		else if (unpackRowLength)
 		{
@@ -6066,7 +6067,7 @@ namespace bgfx { namespace gl
 
 			if (convert)
 			{
-				bimg::imageDecodeToRgba8(g_allocator, temp, data, width, height, srcpitch, bimg::TextureFormat::Enum(m_requestedFormat) );
+				bimg::imageDecodeToRgba8(allocator, temp, data, width, height, srcpitch, bimg::TextureFormat::Enum(m_requestedFormat) );
 				data = temp;
 				srcpitch = rectpitch;
 			}
@@ -6101,7 +6102,7 @@ namespace bgfx { namespace gl
 
 		if (NULL != temp)
 		{
-			bx::free(g_allocator, temp);
+			bx::free(allocator, temp);
 		}
 	}
 
@@ -7528,18 +7529,24 @@ namespace bgfx { namespace gl
 			frameQueryIdx = m_gpuTimer.begin(BGFX_CONFIG_MAX_VIEWS, _render->m_frameNum);
 		}
 
-		if (0 < _render->m_iboffset)
+		for (uint32_t ii = 0, num = _render->getNumTransientIbPages(); ii < num; ++ii)
 		{
 			BGFX_PROFILER_SCOPE("bgfx/Update transient index buffer", kColorResource);
-			TransientIndexBuffer* ib = _render->m_transientIb;
-			m_indexBuffers[ib->handle.idx].update(0, _render->m_iboffset, ib->data, true);
+			TransientIndexBuffer* ib = _render->m_transientIb[ii];
+			if (NULL != ib)
+			{
+				m_indexBuffers[ib->handle.idx].update(0, _render->getTransientIbPageUsed(ii), ib->data, true);
+			}
 		}
 
-		if (0 < _render->m_vboffset)
+		for (uint32_t ii = 0, num = _render->getNumTransientVbPages(); ii < num; ++ii)
 		{
 			BGFX_PROFILER_SCOPE("bgfx/Update transient vertex buffer", kColorResource);
-			TransientVertexBuffer* vb = _render->m_transientVb;
-			m_vertexBuffers[vb->handle.idx].update(0, _render->m_vboffset, vb->data, true);
+			TransientVertexBuffer* vb = _render->m_transientVb[ii];
+			if (NULL != vb)
+			{
+				m_vertexBuffers[vb->handle.idx].update(0, _render->getTransientVbPageUsed(ii), vb->data, true);
+			}
 		}
 
 		_render->sort();
@@ -7630,8 +7637,8 @@ namespace bgfx { namespace gl
 					;
 
 				const uint32_t itemIdx       = _render->m_sortValues[item];
-				const RenderItem& renderItem = _render->m_renderItem[itemIdx];
-				const RenderBind& renderBind = _render->m_renderItemBind[itemIdx];
+				const RenderItem& renderItem = _render->getRenderItem(itemIdx);
+				const RenderBind& renderBind = _render->getRenderItemBind(itemIdx);
 				++item;
 
 				if (viewChanged)
@@ -8191,9 +8198,8 @@ namespace bgfx { namespace gl
 				}
 
 				bool programChanged = false;
-				bool constantsChanged = draw.m_uniformBegin < draw.m_uniformEnd;
+				bool constantsChanged = rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd);
 				bool bindAttribs = false;
-				rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd);
 
 				if (key.m_program.idx != currentProgram.idx)
 				{
@@ -3328,13 +3328,14 @@ static_assert(BX_COUNTOF(s_accessNames) == Access::Count, "Invalid s_accessNames
 		const bool convert = m_textureFormat != m_requestedFormat;
 
 		uint8_t* data = _mem->data;
+		bx::AllocatorI* allocator = getFrameAllocator();
 		uint8_t* temp = NULL;
 
 		if (convert)
 		{
-			temp = (uint8_t*)bx::alloc(g_allocator, rectpitch*_rect.m_height);
+			temp = (uint8_t*)bx::alloc(allocator, rectpitch*_rect.m_height);
 			bimg::imageDecodeToBgra8(
-				  g_allocator
+				  allocator
 				, temp
 				, data
 				, _rect.m_width
@@ -3401,7 +3402,7 @@ static_assert(BX_COUNTOF(s_accessNames) == Access::Count, "Invalid s_accessNames
 
 		if (NULL != temp)
 		{
-			bx::free(g_allocator, temp);
+			bx::free(allocator, temp);
 		}
 	}
 
@@ -4315,18 +4316,24 @@ static_assert(BX_COUNTOF(s_accessNames) == Access::Count, "Invalid s_accessNames
 		m_uniformBufferVertexOffset = 0;
 		m_uniformBufferFragmentOffset = 0;
 
-		if (0 < _render->m_iboffset)
+		for (uint32_t ii = 0, num = _render->getNumTransientIbPages(); ii < num; ++ii)
 		{
 			BGFX_PROFILER_SCOPE("bgfx/Update transient index buffer", kColorResource);
-			TransientIndexBuffer* ib = _render->m_transientIb;
-			m_indexBuffers[ib->handle.idx].update(0, bx::strideAlign(_render->m_iboffset,4), ib->data, true);
+			TransientIndexBuffer* ib = _render->m_transientIb[ii];
+			if (NULL != ib)
+			{
+				m_indexBuffers[ib->handle.idx].update(0, bx::strideAlign(_render->getTransientIbPageUsed(ii),4), ib->data, true);
+			}
 		}
 
-		if (0 < _render->m_vboffset)
+		for (uint32_t ii = 0, num = _render->getNumTransientVbPages(); ii < num; ++ii)
 		{
 			BGFX_PROFILER_SCOPE("bgfx/Update transient vertex buffer", kColorResource);
-			TransientVertexBuffer* vb = _render->m_transientVb;
-			m_vertexBuffers[vb->handle.idx].update(0, bx::strideAlign(_render->m_vboffset,4), vb->data, true);
+			TransientVertexBuffer* vb = _render->m_transientVb[ii];
+			if (NULL != vb)
+			{
+				m_vertexBuffers[vb->handle.idx].update(0, bx::strideAlign(_render->getTransientVbPageUsed(ii),4), vb->data, true);
+			}
 		}
 
 		_render->sort();
@@ -4399,8 +4406,8 @@ static_assert(BX_COUNTOF(s_accessNames) == Access::Count, "Invalid s_accessNames
 					;
 
 				const uint32_t itemIdx       = _render->m_sortValues[item];
-				const RenderItem& renderItem = _render->m_renderItem[itemIdx];
-				const RenderBind& renderBind = _render->m_renderItemBind[itemIdx];
+				const RenderItem& renderItem = _render->getRenderItem(itemIdx);
+				const RenderBind& renderBind = _render->getRenderItemBind(itemIdx);
 				++item;
 
 				if (viewChanged
@@ -4,9 +4,34 @@
  */
 
 #include "bgfx_p.h"
+#include "renderer.h"
 
 namespace bgfx { namespace noop
 {
+	struct PrimInfo
+	{
+		uint32_t m_min;
+		uint32_t m_div;
+		uint32_t m_sub;
+	};
+
+	static const PrimInfo s_primInfo[] =
+	{
+		{ 3, 3, 0 },
+		{ 3, 1, 2 },
+		{ 2, 2, 0 },
+		{ 2, 1, 1 },
+		{ 1, 1, 0 },
+		{ 0, 0, 0 },
+	};
+	static_assert(Topology::Count == BX_COUNTOF(s_primInfo)-1);
+
+	struct BufferNOOP
+	{
+		uint32_t m_size;
+		VertexLayoutHandle m_layoutHandle;
+	};
+
 	struct RendererContextNOOP : public RendererContextI
 	{
 		RendererContextNOOP()
@@ -75,6 +100,10 @@ namespace bgfx { namespace noop
 			g_caps.limits.maxComputeBindings = g_caps.limits.maxTextureSamplers;
 			g_caps.limits.maxFBAttachments   = BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS;
 			g_caps.limits.maxVertexStreams   = BGFX_CONFIG_MAX_VERTEX_STREAMS;
+
+			bx::memSet(m_indexBuffers,       0, sizeof(m_indexBuffers) );
+			bx::memSet(m_vertexBuffers,      0, sizeof(m_vertexBuffers) );
+			bx::memSet(m_vertexLayoutStride, 0, sizeof(m_vertexLayoutStride) );
 		}
 
 		~RendererContextNOOP()
@@ -100,52 +129,65 @@ namespace bgfx { namespace noop
 		{
 		}
 
-		void createIndexBuffer(IndexBufferHandle /*_handle*/, const Memory* /*_mem*/, uint16_t /*_flags*/) override
+		void createIndexBuffer(IndexBufferHandle _handle, const Memory* _mem, uint16_t /*_flags*/) override
 		{
+			m_indexBuffers[_handle.idx].m_size = _mem->size;
 		}
 
-		void destroyIndexBuffer(IndexBufferHandle /*_handle*/) override
+		void destroyIndexBuffer(IndexBufferHandle _handle) override
 		{
+			m_indexBuffers[_handle.idx].m_size = 0;
 		}
 
-		void createVertexLayout(VertexLayoutHandle /*_handle*/, const VertexLayout& /*_layout*/) override
+		void createVertexLayout(VertexLayoutHandle _handle, const VertexLayout& _layout) override
 		{
+			m_vertexLayoutStride[_handle.idx] = _layout.m_stride;
 		}
 
 		void destroyVertexLayout(VertexLayoutHandle /*_handle*/) override
 		{
 		}
 
-		void createVertexBuffer(VertexBufferHandle /*_handle*/, const Memory* /*_mem*/, VertexLayoutHandle /*_layoutHandle*/, uint16_t /*_flags*/) override
+		void createVertexBuffer(VertexBufferHandle _handle, const Memory* _mem, VertexLayoutHandle _layoutHandle, uint16_t /*_flags*/) override
 		{
+			BufferNOOP& vb = m_vertexBuffers[_handle.idx];
+			vb.m_size         = _mem->size;
+			vb.m_layoutHandle = _layoutHandle;
 		}
 
-		void destroyVertexBuffer(VertexBufferHandle /*_handle*/) override
+		void destroyVertexBuffer(VertexBufferHandle _handle) override
 		{
+			m_vertexBuffers[_handle.idx].m_size = 0;
 		}
 
-		void createDynamicIndexBuffer(IndexBufferHandle /*_handle*/, uint32_t /*_size*/, uint16_t /*_flags*/) override
+		void createDynamicIndexBuffer(IndexBufferHandle _handle, uint32_t _size, uint16_t /*_flags*/) override
 		{
+			m_indexBuffers[_handle.idx].m_size = _size;
 		}
 
 		void updateDynamicIndexBuffer(IndexBufferHandle /*_handle*/, uint32_t /*_offset*/, uint32_t /*_size*/, const Memory* /*_mem*/) override
 		{
 		}
 
-		void destroyDynamicIndexBuffer(IndexBufferHandle /*_handle*/) override
+		void destroyDynamicIndexBuffer(IndexBufferHandle _handle) override
 		{
+			m_indexBuffers[_handle.idx].m_size = 0;
 		}
 
-		void createDynamicVertexBuffer(VertexBufferHandle /*_handle*/, uint32_t /*_size*/, uint16_t /*_flags*/) override
+		void createDynamicVertexBuffer(VertexBufferHandle _handle, uint32_t _size, uint16_t /*_flags*/) override
 		{
+			BufferNOOP& vb = m_vertexBuffers[_handle.idx];
+			vb.m_size         = _size;
+			vb.m_layoutHandle = BGFX_INVALID_HANDLE;
 		}
 
 		void updateDynamicVertexBuffer(VertexBufferHandle /*_handle*/, uint32_t /*_offset*/, uint32_t /*_size*/, const Memory* /*_mem*/) override
 		{
 		}
 
-		void destroyDynamicVertexBuffer(VertexBufferHandle /*_handle*/) override
+		void destroyDynamicVertexBuffer(VertexBufferHandle _handle) override
 		{
+			m_vertexBuffers[_handle.idx].m_size = 0;
 		}
 
 		void createShader(ShaderHandle /*_handle*/, const Memory* /*_mem*/) override
@@ -244,8 +286,27 @@ namespace bgfx { namespace noop
 			const int64_t timeBegin = bx::getHPCounter();
 
 			Stats& perfStats = _render->m_perfStats;
+
+			if (BX_ENABLED(BGFX_CONFIG_NOOP_WALK_FRAME) )
+			{
+				walkFrame(_render, perfStats);
+			}
+			else
+			{
+				// Counters are filled only by walking frame, report zero instead of stale values.
+				perfStats.numDraw           = 0;
+				perfStats.numCompute        = 0;
+				perfStats.numBlit           = 0;
+				perfStats.numStateChanges   = 0;
+				perfStats.numProgramChanges = 0;
+				perfStats.numTextureChanges = 0;
+				perfStats.numBufferChanges  = 0;
+				perfStats.numUniformUpdates = 0;
+				bx::memSet(perfStats.numPrims, 0, sizeof(perfStats.numPrims) );
+			}
+
 			perfStats.cpuTimeBegin  = timeBegin;
-			perfStats.cpuTimeEnd    = timeBegin;
+			perfStats.cpuTimeEnd    = bx::getHPCounter();
 			perfStats.cpuTimerFreq  = timerFreq;
 
 			perfStats.gpuTimeBegin  = 0;
@@ -253,8 +314,6 @@ namespace bgfx { namespace noop
 			perfStats.gpuTimerFreq  = 1000000000;
 			perfStats.gpuFrameNum   = 0;
 
-			bx::memSet(perfStats.numPrims, 0, sizeof(perfStats.numPrims) );
-
 			perfStats.gpuMemoryMax  = -INT64_MAX;
 			perfStats.gpuMemoryUsed = -INT64_MAX;
 		}
@@ -270,6 +329,342 @@ namespace bgfx { namespace noop
 		void dbgTextRenderEnd(TextVideoMemBlitter& /*_blitter*/) override
 		{
 		}
+
+		uint32_t submitUniformCache(UniformCacheState& _ucs, uint16_t _view)
+		{
+			uint32_t num = 0;
+
+			while (_ucs.hasItem(_view) )
+			{
+				const UniformCacheItem& uci = _ucs.advance();
+				updateUniform(uci.m_handle, &_ucs.m_frame->m_uniformCacheFrame.m_data[uci.m_offset], uci.m_size);
+				++num;
+			}
+
+			return num;
+		}
+
+		void submitBlit(BlitState& _bs, uint16_t _view)
+		{
+			while (_bs.hasItem(_view) )
+			{
+				_bs.advance();
+			}
+		}
+
+		uint32_t getNumVertices(const RenderDraw& _draw) const
+		{
+			uint32_t numVertices = _draw.m_numVertices;
+
+			if (UINT32_MAX == numVertices)
+			{
+				for (BitMaskToIndexIteratorT it(_draw.m_streamMask); !it.isDone(); it.next() )
+				{
+					const uint8_t idx = it.idx;
+					const BufferNOOP& vb = m_vertexBuffers[_draw.m_stream[idx].m_handle.idx];
+					const VertexLayoutHandle layoutHandle = isValid(_draw.m_stream[idx].m_layoutHandle)
+						? _draw.m_stream[idx].m_layoutHandle
+						: vb.m_layoutHandle
+						;
+
+					// Stream without any layout can't be drawn.
+					const uint16_t stride = isValid(layoutHandle) ? m_vertexLayoutStride[layoutHandle.idx] : 0;
+					numVertices = bx::uint32_min(numVertices, 0 == stride ? 0 : vb.m_size/stride);
+				}
+			}
+
+			return numVertices;
+		}
+
+		// Walks sorted frame the same way GL and Vulkan renderers do, tracking the same state and
+		// binding changes, and decoding uniforms, but without issuing any GPU calls.
+		void walkFrame(Frame* _render, Stats& _perfStats)
+		{
+			_render->sort();
+
+			RenderDraw currentState;
+			currentState.clear();
+			currentState.m_stateFlags = BGFX_STATE_NONE;
+			currentState.m_stencil    = packStencil(BGFX_STENCIL_NONE, BGFX_STENCIL_NONE);
+
+			RenderBind currentBind;
+			currentBind.clear();
+
+			ProgramHandle currentProgram = BGFX_INVALID_HANDLE;
+			SortKey key;
+			uint16_t view = UINT16_MAX;
+
+			UniformCacheState ucs(_render);
+			BlitState bs(_render);
+
+			uint32_t blendFactor = 0;
+
+			uint8_t primIndex;
+			{
+				const uint64_t pt = 0;
+				primIndex = uint8_t(pt>>BGFX_STATE_PT_SHIFT);
+			}
+			PrimInfo prim = s_primInfo[primIndex];
+
+			bool wasCompute = false;
+			Rect viewScissorRect;
+			viewScissorRect.clear();
+
+			uint32_t statsNumPrimsRendered[BX_COUNTOF(s_primInfo)] = {};
+			uint32_t statsKeyType[2] = {};
+			uint32_t statsNumStateChanges   = 0;
+			uint32_t statsNumProgramChanges = 0;
+			uint32_t statsNumTextureChanges = 0;
+			uint32_t statsNumBufferChanges  = 0;
+			uint32_t statsNumUniformUpdates = 0;
+
+			if (0 == (_render->m_debug&BGFX_DEBUG_IFH) )
+			{
+				for (uint32_t item = 0, numItems = _render->m_numRenderItems; item < numItems;)
+				{
+					const uint64_t encodedKey = _render->m_sortKeys[item];
+					const bool isCompute = key.decode(encodedKey, _render->m_viewRemap);
+					statsKeyType[isCompute]++;
+
+					const bool viewChanged = key.m_view != view;
+
+					const uint32_t itemIdx       = _render->m_sortValues[item];
+					const RenderItem& renderItem = _render->getRenderItem(itemIdx);
+					const RenderBind& renderBind = _render->getRenderItemBind(itemIdx);
+					++item;
+
+					if (viewChanged)
+					{
+						view = key.m_view;
+						currentProgram = BGFX_INVALID_HANDLE;
+
+						const Rect& scissorRect = _render->m_view[view].m_scissor;
+						viewScissorRect = scissorRect.isZero() ? _render->m_view[view].m_rect : scissorRect;
+
+						statsNumUniformUpdates += submitUniformCache(ucs, view);
+						submitBlit(bs, view);
+					}
+
+					if (isCompute)
+					{
+						wasCompute = true;
+
+						const RenderCompute& compute = renderItem.compute;
+
+						if (key.m_program.idx != currentProgram.idx)
+						{
+							currentProgram = key.m_program;
+							++statsNumProgramChanges;
+						}
+
+						for (uint32_t ii = 0, num = g_caps.limits.maxComputeBindings; ii < num; ++ii)
+						{
+							statsNumTextureChanges += kInvalidHandle != renderBind.m_bind[ii].m_idx;
+						}
+
+						statsNumUniformUpdates += rendererUpdateUniforms(this, _render->m_uniformBuffer[compute.m_uniformIdx], compute.m_uniformBegin, compute.m_uniformEnd);
+						continue;
+					}
+
+					const bool resetState = viewChanged || wasCompute;
+					wasCompute = false;
+
+					const RenderDraw& draw = renderItem.draw;
+
+					const bool hasOcclusionQuery = 0 != (draw.m_stateFlags & BGFX_STATE_INTERNAL_OCCLUSION_QUERY);
+					{
+						const bool occluded = true
+							&& isValid(draw.m_occlusionQuery)
+							&& !hasOcclusionQuery
+							&& (0 != (draw.m_submitFlags&BGFX_SUBMIT_INTERNAL_OCCLUSION_VISIBLE) ) != (0 != _render->m_occlusion[draw.m_occlusionQuery.idx])
+							;
+
+						if (occluded
+						||  _render->m_frameCache.isZeroArea(viewScissorRect, draw.m_scissor) )
+						{
+							if (resetState)
+							{
+								currentState.clear();
+								currentState.m_scissor = !draw.m_scissor;
+								currentBind.clear();
+							}
+
+							continue;
+						}
+					}
+
+					const uint64_t newFlags = draw.m_stateFlags;
+					uint64_t changedFlags = currentState.m_stateFlags ^ draw.m_stateFlags;
+					currentState.m_stateFlags = newFlags;
+
+					const uint64_t newStencil = draw.m_stencil;
+					uint64_t changedStencil = currentState.m_stencil ^ draw.m_stencil;
+					currentState.m_stencil = newStencil;
+
+					if (resetState)
+					{
+						currentState.clear();
+						currentState.m_scissor = !draw.m_scissor;
+						changedFlags   = BGFX_STATE_MASK;
+						changedStencil = packStencil(BGFX_STENCIL_MASK, BGFX_STENCIL_MASK);
+						currentState.m_stateFlags = newFlags;
+						currentState.m_stencil    = newStencil;
+
+						currentBind.clear();
+					}
+
+					const bool scissorChanged = currentState.m_scissor != draw.m_scissor;
+					currentState.m_scissor = draw.m_scissor;
+
+					if ( ( (0
+						 | BGFX_STATE_ALPHA_REF_MASK
+						 | BGFX_STATE_BLEND_ALPHA_TO_COVERAGE
+						 | BGFX_STATE_BLEND_EQUATION_MASK
+						 | BGFX_STATE_BLEND_INDEPENDENT
+						 | BGFX_STATE_BLEND_MASK
+						 | BGFX_STATE_CONSERVATIVE_RASTER
+						 | BGFX_STATE_CULL_MASK
+						 | BGFX_STATE_FRONT_CCW
+						 | BGFX_STATE_DEPTH_TEST_MASK
+						 | BGFX_STATE_LINEAA
+						 | BGFX_STATE_MSAA
+						 | BGFX_STATE_POINT_SIZE_MASK
+						 | BGFX_STATE_PT_MASK
+						 | BGFX_STATE_WRITE_A
+						 | BGFX_STATE_WRITE_RGB
+						 | BGFX_STATE_WRITE_Z
+						 ) & changedFlags)
+					||  0 != changedStencil
+					||  scissorChanged
+					||  blendFactor != draw.m_rgba)
+					{
+						++statsNumStateChanges;
+
+						blendFactor = draw.m_rgba;
+
+						const uint64_t pt = newFlags&BGFX_STATE_PT_MASK;
+						primIndex = uint8_t(pt>>BGFX_STATE_PT_SHIFT);
+						prim = s_primInfo[primIndex];
+					}
+
+					bool programChanged = false;
+					statsNumUniformUpdates += rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd);
+
+					if (key.m_program.idx != currentProgram.idx)
+					{
+						currentProgram = key.m_program;
+						programChanged = true;
+						++statsNumProgramChanges;
+					}
+
+					if (!isValid(currentProgram) )
+					{
+						continue;
+					}
+
+					for (uint32_t stage = 0; stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++stage)
+					{
+						const Binding& bind = renderBind.m_bind[stage];
+						Binding& current = currentBind.m_bind[stage];
+
+						if (current.m_idx          != bind.m_idx
+						||  current.m_type         != bind.m_type
+						||  current.m_samplerFlags != bind.m_samplerFlags
+						||  programChanged)
+						{
+							statsNumTextureChanges += kInvalidHandle != bind.m_idx;
+						}
+
+						current = bind;
+					}
+
+					bool bindAttribs = false;
+
+					for (BitMaskToIndexIteratorT it(draw.m_streamMask); !it.isDone(); it.next() )
+					{
+						const uint8_t idx = it.idx;
+
+						if (currentState.m_stream[idx].m_handle.idx  != draw.m_stream[idx].m_handle.idx
+						||  currentState.m_stream[idx].m_startVertex != draw.m_stream[idx].m_startVertex)
+						{
+							currentState.m_stream[idx].m_handle      = draw.m_stream[idx].m_handle;
+							currentState.m_stream[idx].m_startVertex = draw.m_stream[idx].m_startVertex;
+							bindAttribs = true;
+						}
+					}
+
+					if (currentState.m_streamMask             != draw.m_streamMask
+					||  currentState.m_instanceDataBuffer.idx != draw.m_instanceDataBuffer.idx
+					||  currentState.m_instanceDataOffset     != draw.m_instanceDataOffset
+					||  currentState.m_instanceDataStride     != draw.m_instanceDataStride)
+					{
+						currentState.m_streamMask         = draw.m_streamMask;
+						currentState.m_instanceDataBuffer = draw.m_instanceDataBuffer;
+						currentState.m_instanceDataOffset = draw.m_instanceDataOffset;
+						currentState.m_instanceDataStride = draw.m_instanceDataStride;
+						bindAttribs = true;
+					}
+
+					statsNumBufferChanges += bindAttribs;
+
+					if (currentState.m_indexBuffer.idx != draw.m_indexBuffer.idx)
+					{
+						currentState.m_indexBuffer = draw.m_indexBuffer;
+						++statsNumBufferChanges;
+					}
+
+					if (0 == currentState.m_streamMask
+					||  isValid(draw.m_indirectBuffer) )
+					{
+						continue;
+					}
+
+					uint32_t numPrimsSubmitted = 0;
+
+					if (isValid(draw.m_indexBuffer) )
+					{
+						const uint32_t indexSize  = draw.isIndex16() ? 2 : 4;
+						const uint32_t numIndices = UINT32_MAX == draw.m_numIndices
+							? m_indexBuffers[draw.m_indexBuffer.idx].m_size/indexSize
+							: draw.m_numIndices
+							;
+
+						if (prim.m_min <= numIndices)
+						{
+							numPrimsSubmitted = numIndices/prim.m_div - prim.m_sub;
+						}
+					}
+					else
+					{
+						const uint32_t numVertices = getNumVertices(draw);
+
+						if (prim.m_min <= numVertices)
+						{
+							numPrimsSubmitted = numVertices/prim.m_div - prim.m_sub;
+						}
+					}
+
+					statsNumPrimsRendered[primIndex] += numPrimsSubmitted*draw.m_numInstances;
+				}
+			}
+
+			statsNumUniformUpdates += submitUniformCache(ucs, BGFX_CONFIG_MAX_VIEWS);
+			submitBlit(bs, BGFX_CONFIG_MAX_VIEWS);
+
+			_perfStats.numDraw           = statsKeyType[0];
+			_perfStats.numCompute        = statsKeyType[1];
+			_perfStats.numBlit           = _render->m_numBlitItems;
+			_perfStats.numStateChanges   = statsNumStateChanges;
+			_perfStats.numProgramChanges = statsNumProgramChanges;
+			_perfStats.numTextureChanges = statsNumTextureChanges;
+			_perfStats.numBufferChanges  = statsNumBufferChanges;
+			_perfStats.numUniformUpdates = statsNumUniformUpdates;
+			bx::memCopy(_perfStats.numPrims, statsNumPrimsRendered, sizeof(_perfStats.numPrims) );
+		}
+
+		BufferNOOP m_indexBuffers[BGFX_CONFIG_MAX_INDEX_BUFFERS];
+		BufferNOOP m_vertexBuffers[BGFX_CONFIG_MAX_VERTEX_BUFFERS];
+		uint16_t   m_vertexLayoutStride[BGFX_CONFIG_MAX_VERTEX_LAYOUTS];
 	};
 
 	static RendererContextNOOP* s_renderNOOP;
@@ -6897,12 +6897,13 @@ retry:
 		region.imageExtent = { _rect.m_width, _rect.m_height, _depth };
 
 		uint8_t* data = _mem->data;
+		bx::AllocatorI* allocator = getFrameAllocator();
 		uint8_t* temp = NULL;
 
 		if (convert)
 		{
-			temp = (uint8_t*)bx::alloc(g_allocator, slicepitch);
-			bimg::imageDecodeToBgra8(g_allocator, temp, data, _rect.m_width, _rect.m_height, srcpitch, bimg::TextureFormat::Enum(m_requestedFormat) );
+			temp = (uint8_t*)bx::alloc(allocator, slicepitch);
+			bimg::imageDecodeToBgra8(allocator, temp, data, _rect.m_width, _rect.m_height, srcpitch, bimg::TextureFormat::Enum(m_requestedFormat) );
 			data = temp;
 
 			region.imageExtent =
@@ -6943,7 +6944,7 @@ retry:
 
 		if (NULL != temp)
 		{
-			bx::free(g_allocator, temp);
+			bx::free(allocator, temp);
 		}
 	}
 
@@ -9064,20 +9065,26 @@ retry:
 			frameQueryIdx = m_gpuTimer.begin(BGFX_CONFIG_MAX_VIEWS, _render->m_frameNum);
 		}
 
-		if (0 < _render->m_iboffset)
+		for (uint32_t ii = 0, num = _render->getNumTransientIbPages(); ii < num; ++ii)
 		{
 			BGFX_PROFILER_SCOPE("bgfx/Update transient index buffer", kColorResource);
 
-			TransientIndexBuffer* ib = _render->m_transientIb;
-			m_indexBuffers[ib->handle.idx].update(m_commandBuffer, 0, _render->m_iboffset, ib->data);
+			TransientIndexBuffer* ib = _render->m_transientIb[ii];
+			if (NULL != ib)
+			{
+				m_indexBuffers[ib->handle.idx].update(m_commandBuffer, 0, _render->getTransientIbPageUsed(ii), ib->data);
+			}
 		}
 
-		if (0 < _render->m_vboffset)
+		for (uint32_t ii = 0, num = _render->getNumTransientVbPages(); ii < num; ++ii)
 		{
 			BGFX_PROFILER_SCOPE("bgfx/Update transient vertex buffer", kColorResource);
 
-			TransientVertexBuffer* vb = _render->m_transientVb;
-			m_vertexBuffers[vb->handle.idx].update(m_commandBuffer, 0, _render->m_vboffset, vb->data);
+			TransientVertexBuffer* vb = _render->m_transientVb[ii];
+			if (NULL != vb)
+			{
+				m_vertexBuffers[vb->handle.idx].update(m_commandBuffer, 0, _render->getTransientVbPageUsed(ii), vb->data);
+			}
 		}
 
 		_render->sort();
@@ -9176,8 +9183,8 @@ retry:
 					;
 
 				const uint32_t itemIdx       = _render->m_sortValues[item];
-				const RenderItem& renderItem = _render->m_renderItem[itemIdx];
-				const RenderBind& renderBind = _render->m_renderItemBind[itemIdx];
+				const RenderItem& renderItem = _render->getRenderItem(itemIdx);
+				const RenderBind& renderBind = _render->getRenderItemBind(itemIdx);
 				++item;
 
 				if (viewChanged)
@@ -9558,7 +9565,7 @@ retry:
 
 				const RenderDraw& draw = renderItem.draw;
 
-				rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd);
+				const bool uniformsChanged = rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd);
 
 				const bool hasOcclusionQuery = 0 != (draw.m_stateFlags & BGFX_STATE_INTERNAL_OCCLUSION_QUERY);
 				{
@@ -9573,6 +9580,8 @@ retry:
 					||  0 == draw.m_streamMask
 					||  _render->m_frameCache.isZeroArea(viewScissorRect, draw.m_scissor) )
 					{
+						// Uniforms were applied but not committed.
+						rendererResetUniforms();
 						continue;
 					}
 				}
@@ -9732,7 +9741,7 @@ retry:
 					}
 
 					bool constantsChanged = false;
-					if (draw.m_uniformBegin < draw.m_uniformEnd
+					if (uniformsChanged
 					||  currentProgram.idx != key.m_program.idx
 					||  BGFX_STATE_ALPHA_REF_MASK & changedFlags)
 					{
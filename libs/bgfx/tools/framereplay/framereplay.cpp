@@ -0,0 +1,139 @@
+/*
+ * Copyright 2011-2026 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include <bgfx/bgfx.h>
+#include <bgfx/platform.h>
+#include <bx/commandline.h>
+#include <bx/file.h>
+
+#include "../../src/frame_capture.h"
+
+namespace bgfx
+{
+	void help(const char* _error = NULL)
+	{
+		if (NULL != _error)
+		{
+			bx::printf("Error:\n%s\n\n", _error);
+		}
+
+		bx::printf(
+			  "framereplay, bgfx frame capture replay tool, version %d.\n"
+			  "Copyright 2011-2026 Branimir Karadzic. All rights reserved.\n"
+			  "License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE\n\n"
+			, BGFX_API_VERSION
+			);
+
+		bx::printf(
+			  "Usage: framereplay -f <in>\n"
+
+			  "\n"
+			  "Frame capture is written by bgfx built with BGFX_CONFIG_FRAME_CAPTURE=1 for frames submitted\n"
+			  "with BGFX_FRAME_DEBUG_CAPTURE flag. Frame is replayed on Noop renderer, limits must match\n"
+			  "limits of application that captured frame.\n"
+
+			  "\n"
+			  "Options:\n"
+			  "  -h, --help                    Display this help and exit.\n"
+			  "  -f <file path>                Frame capture file path.\n"
+			  "  -n <iterations>               Number of times frame is replayed. Default is 100.\n"
+			  "      --max-draw-calls <num>    Maximum number of draw calls.\n"
+			  "      --max-encoders <num>      Maximum number of encoders.\n"
+			  "      --transient-vb-size <num> Transient vertex buffer page size.\n"
+			  "      --transient-ib-size <num> Transient index buffer page size.\n"
+
+			  "\n"
+			  "For additional information, see https://github.com/bkaradzic/bgfx\n"
+			);
+	}
+
+	int replayFrame(int _argc, const char* _argv[])
+	{
+		bx::CommandLine cmdLine(_argc, _argv);
+
+		if (cmdLine.hasArg('h', "help") )
+		{
+			help();
+			return bx::kExitFailure;
+		}
+
+		const char* filePath = cmdLine.findOption('f');
+		if (NULL == filePath)
+		{
+			help("Frame capture file path must be specified.");
+			return bx::kExitFailure;
+		}
+
+		uint32_t numIterations = 100;
+		cmdLine.hasArg(numIterations, 'n');
+		numIterations = bx::max<uint32_t>(numIterations, 1);
+
+		Init init;
+		init.type = RendererType::Noop;
+		cmdLine.hasArg(init.limits.maxDrawCalls,       '\0', "max-draw-calls");
+		cmdLine.hasArg(init.limits.maxTransientVbSize, '\0', "transient-vb-size");
+		cmdLine.hasArg(init.limits.maxTransientIbSize, '\0', "transient-ib-size");
+
+		uint32_t maxEncoders;
+		if (cmdLine.hasArg(maxEncoders, '\0', "max-encoders") )
+		{
+			init.limits.maxEncoders = uint16_t(maxEncoders);
+		}
+
+		bx::FileReader reader;
+		bx::Error err;
+
+		if (!bx::open(&reader, filePath, &err) )
+		{
+			bx::printf("Unable to open frame capture '%s'.\n", filePath);
+			return bx::kExitFailure;
+		}
+
+		// Calling renderFrame before init makes bgfx single-threaded, replay runs renderer submit on
+		// this thread.
+		renderFrame();
+
+		if (!bgfx::init(init) )
+		{
+			bx::close(&reader);
+			bx::printf("Failed to initialize bgfx.\n");
+			return bx::kExitFailure;
+		}
+
+		FrameReplayStats stats;
+		const bool replayed = frameReplay(&reader, numIterations, &stats, &err);
+
+		bx::close(&reader);
+		shutdown();
+
+		if (!replayed)
+		{
+			bx::printf("Failed to replay frame capture '%s': %s\n"
+				, filePath
+				, err.getMessage().getCPtr()
+				);
+			return bx::kExitFailure;
+		}
+
+		const double toUs = 1000000.0/double(stats.timerFreq)/double(stats.numIterations);
+
+		bx::printf("Frame %d: %d render items, %d blit items, %d iterations.\n"
+			, stats.frameNum
+			, stats.numRenderItems
+			, stats.numBlitItems
+			, stats.numIterations
+			);
+		bx::printf("  sort   %10.3f us/frame\n", double(stats.sortTime)*toUs);
+		bx::printf("  submit %10.3f us/frame\n", double(stats.submitTime)*toUs);
+
+		return bx::kExitSuccess;
+	}
+
+} // namespace bgfx
+
+int main(int _argc, const char* _argv[])
+{
+	return bgfx::replayFrame(_argc, _argv);
+}
@@ -18,9 +18,6 @@ extern "C"
 #define BGFX_CHUNK_MAGIC_FSH BX_MAKEFOURCC('F', 'S', 'H', BGFX_SHADER_BIN_VERSION)
 #define BGFX_CHUNK_MAGIC_VSH BX_MAKEFOURCC('V', 'S', 'H', BGFX_SHADER_BIN_VERSION)
 
-#define BGFX_SHADERC_VERSION_MAJOR 1
-#define BGFX_SHADERC_VERSION_MINOR 19
-
 namespace bgfx
 {
 	bool g_verbose = false;
@@ -390,6 +387,7 @@ namespace bgfx
 		, keepIntermediate(false)
 		, optimize(false)
 		, optimizationLevel(3)
+		, cacheMaxSize(UINT64_C(256)<<20)
 	{
 	}
 
@@ -416,6 +414,8 @@ namespace bgfx
 			"\t  keepIntermediate: %s\n"
 			"\t  optimize: %s\n"
 			"\t  optimizationLevel: %d\n"
+			"\t  cacheDir: %s\n"
+			"\t  cacheMaxSize: %u MiB\n"
 
 			, shaderType
 			, platform.c_str()
@@ -437,6 +437,8 @@ namespace bgfx
 			, keepIntermediate ? "true" : "false"
 			, optimize ? "true" : "false"
 			, optimizationLevel
+			, cacheDir.c_str()
+			, uint32_t(cacheMaxSize>>20)
 			);
 
 		for (size_t ii = 0; ii < includeDirs.size(); ++ii)
@@ -1211,6 +1213,9 @@ namespace bgfx
 			  "      --type <type>             Shader type. Can be 'vertex', 'fragment, or 'compute'.\n"
 			  "      --varyingdef <file path>  varying.def.sc's file path.\n"
 			  "      --verbose                 Be verbose.\n"
+			  "      --cache <dir>             Content-addressed cache of compiled shaders.\n"
+			  "      --cache-max-size <MiB>    Cache size limit, oldest entries are evicted. (default 256)\n"
+			  "      --server                  Compile framed requests from stdin, write framed results to stdout.\n"
 
 			  "\n"
 			  "(Vulkan, DirectX and Metal):\n"
@@ -1259,12 +1264,14 @@ namespace bgfx
 			if (profileId == count)
 			{
 				bx::write(_messageWriter, &messageErr, "Unknown profile: %S\n", &profileOpt);
+				delete [] _shader;
 				return false;
 			}
 		}
 		else
 		{
 			bx::write(_messageWriter, &messageErr, "Shader profile must be specified.\n");
+			delete [] _shader;
 			return false;
 		}
 
@@ -1496,6 +1503,7 @@ namespace bgfx
 
 		default:
 			bx::write(_messageWriter, &messageErr, "Unknown type: %c?!", _options.shaderType);
+			delete [] _shader;
 			return false;
 		}
 
@@ -1838,6 +1846,7 @@ namespace bgfx
 							, &err
 							);
 
+						delete [] data;
 						return true;
 					}
 
@@ -2369,6 +2378,7 @@ namespace bgfx
 							, &err
 							);
 
+						delete [] data;
 						return true;
 					}
 
@@ -2821,6 +2831,112 @@ namespace bgfx
 		return compiled;
 	}
 
+	char* allocShaderSource(const void* _data, uint32_t& _inOutSize)
+	{
+		const char* data = (const char*)_data;
+		uint32_t size = _inOutSize;
+
+		// Trim UTF-8 BOM
+		if (size >= 3
+		&&  data[0] == '\xef'
+		&&  data[1] == '\xbb'
+		&&  data[2] == '\xbf')
+		{
+			data += 3;
+			size -= 3;
+		}
+
+		char* shader = new char[size + kShaderSourcePadding];
+		bx::memCopy(shader, data, size);
+
+		// Compiler generates "error X3000: syntax error: unexpected end of file"
+		// if input doesn't have empty line at EOF.
+		shader[size] = '\n';
+		bx::memSet(&shader[size+1], 0, kShaderSourcePadding-1);
+
+		_inOutSize = size;
+		return shader;
+	}
+
+	void parseOptions(const bx::CommandLine& _cmdLine, Options& _options)
+	{
+		_options.disasm = _cmdLine.hasArg('\0', "disasm");
+
+		const char* platform = _cmdLine.findOption('\0', "platform");
+		if (NULL == platform)
+		{
+			platform = "";
+		}
+
+		_options.platform = platform;
+
+		_options.raw = _cmdLine.hasArg('\0', "raw");
+
+		const char* profile = _cmdLine.findOption('p', "profile");
+
+		if ( NULL != profile)
+		{
+			_options.profile = profile;
+		}
+
+		{
+			_options.debugInformation       = _cmdLine.hasArg('\0', "debug");
+			_options.avoidFlowControl       = _cmdLine.hasArg('\0', "avoid-flow-control");
+			_options.noPreshader            = _cmdLine.hasArg('\0', "no-preshader");
+			_options.partialPrecision       = _cmdLine.hasArg('\0', "partial-precision");
+			_options.preferFlowControl      = _cmdLine.hasArg('\0', "prefer-flow-control");
+			_options.backwardsCompatibility = _cmdLine.hasArg('\0', "backwards-compatibility");
+			_options.warningsAreErrors      = _cmdLine.hasArg('\0', "Werror");
+			_options.keepIntermediate       = _cmdLine.hasArg('\0', "keep-intermediate");
+
+			uint32_t optimization = 3;
+			if (_cmdLine.hasArg(optimization, 'O') )
+			{
+				_options.optimize = true;
+				_options.optimizationLevel = optimization;
+			}
+		}
+
+		const char* cacheDir = _cmdLine.findOption("cache");
+		if (NULL != cacheDir)
+		{
+			_options.cacheDir = cacheDir;
+
+			uint32_t cacheMaxSize = 0;
+			if (_cmdLine.hasArg(cacheMaxSize, '\0', "cache-max-size") )
+			{
+				_options.cacheMaxSize = uint64_t(cacheMaxSize)<<20;
+			}
+		}
+
+		_options.depends = _cmdLine.hasArg("depends");
+		_options.preprocessOnly = _cmdLine.hasArg("preprocess");
+		_options.keepComments = _cmdLine.hasArg("keepcomments");
+		const char* includeDir = _cmdLine.findOption('i');
+
+		BX_TRACE("depends: %d", _options.depends);
+		BX_TRACE("preprocessOnly: %d", _options.preprocessOnly);
+		BX_TRACE("keepComments: %d", _options.keepComments);
+		BX_TRACE("includeDir: %s", includeDir);
+
+		for (int ii = 1; NULL != includeDir; ++ii)
+		{
+			_options.includeDirs.push_back(includeDir);
+			includeDir = _cmdLine.findOption(ii, 'i');
+		}
+
+		const char* defines = _cmdLine.findOption("define");
+		while (NULL != defines
+		&&    '\0'  != *defines)
+		{
+			defines = bx::strLTrimSpace(defines).getPtr();
+			bx::StringView eol = bx::strFind(defines, ';');
+			std::string define(defines, eol.getPtr() );
+			_options.defines.push_back(define.c_str() );
+			defines = ';' == *eol.getPtr() ? eol.getPtr()+1 : eol.getPtr();
+		}
+	}
+
 	int compileShader(int _argc, const char* _argv[])
 	{
 		bx::CommandLine cmdLine(_argc, _argv);
@@ -2844,6 +2960,11 @@ namespace bgfx
 
 		g_verbose = cmdLine.hasArg("verbose");
 
+		if (cmdLine.hasArg("server") )
+		{
+			return compileShaderServer();
+		}
+
 		const char* filePath = cmdLine.findOption('f');
 		if (NULL == filePath)
 		{
@@ -2872,42 +2993,7 @@ namespace bgfx
 		options.outputFilePath = consoleOut ? "" : outFilePath;
 		options.shaderType = bx::toLower(type[0]);
 
-		options.disasm = cmdLine.hasArg('\0', "disasm");
-
-		const char* platform = cmdLine.findOption('\0', "platform");
-		if (NULL == platform)
-		{
-			platform = "";
-		}
-
-		options.platform = platform;
-
-		options.raw = cmdLine.hasArg('\0', "raw");
-
-		const char* profile = cmdLine.findOption('p', "profile");
-
-		if ( NULL != profile)
-		{
-			options.profile = profile;
-		}
-
-		{
-			options.debugInformation       = cmdLine.hasArg('\0', "debug");
-			options.avoidFlowControl       = cmdLine.hasArg('\0', "avoid-flow-control");
-			options.noPreshader            = cmdLine.hasArg('\0', "no-preshader");
-			options.partialPrecision       = cmdLine.hasArg('\0', "partial-precision");
-			options.preferFlowControl      = cmdLine.hasArg('\0', "prefer-flow-control");
-			options.backwardsCompatibility = cmdLine.hasArg('\0', "backwards-compatibility");
-			options.warningsAreErrors      = cmdLine.hasArg('\0', "Werror");
-			options.keepIntermediate       = cmdLine.hasArg('\0', "keep-intermediate");
-
-			uint32_t optimization = 3;
-			if (cmdLine.hasArg(optimization, 'O') )
-			{
-				options.optimize = true;
-				options.optimizationLevel = optimization;
-			}
-		}
+		parseOptions(cmdLine, options);
 
 		bx::StringView bin2c;
 		if (cmdLine.hasArg("bin2c") )
@@ -2943,22 +3029,6 @@ namespace bgfx
 			}
 		}
 
-		options.depends = cmdLine.hasArg("depends");
-		options.preprocessOnly = cmdLine.hasArg("preprocess");
-		options.keepComments = cmdLine.hasArg("keepcomments");
-		const char* includeDir = cmdLine.findOption('i');
-
-		BX_TRACE("depends: %d", options.depends);
-		BX_TRACE("preprocessOnly: %d", options.preprocessOnly);
-		BX_TRACE("keepComments: %d", options.keepComments);
-		BX_TRACE("includeDir: %s", includeDir);
-
-		for (int ii = 1; NULL != includeDir; ++ii)
-		{
-			options.includeDirs.push_back(includeDir);
-			includeDir = cmdLine.findOption(ii, 'i');
-		}
-
 		std::string dir;
 		{
 			bx::FilePath fp(filePath);
@@ -2968,17 +3038,6 @@ namespace bgfx
 			options.includeDirs.push_back(dir);
 		}
 
-		const char* defines = cmdLine.findOption("define");
-		while (NULL != defines
-		&&    '\0'  != *defines)
-		{
-			defines = bx::strLTrimSpace(defines).getPtr();
-			bx::StringView eol = bx::strFind(defines, ';');
-			std::string define(defines, eol.getPtr() );
-			options.defines.push_back(define.c_str() );
-			defines = ';' == *eol.getPtr() ? eol.getPtr()+1 : eol.getPtr();
-		}
-
 		std::string commandLineComment = "// shaderc command line:\n//";
 		for (int32_t ii = 0, num = cmdLine.getNum(); ii < num; ++ii)
 		{
@@ -3018,7 +3077,7 @@ namespace bgfx
 			}
 
 			int32_t size = (int32_t)bx::getSize(&reader);
-			const int32_t total = size + 16384;
+			const int32_t total = size + kShaderSourcePadding;
 			char* data = new char[total];
 			size = bx::read(&reader, data, size, bx::ErrorAssert{});
 
@@ -3075,7 +3134,7 @@ namespace bgfx
 					}
 				}
 
-				compiled = compileShader(
+				compiled = compileShaderCached(
 						  varying
 						, commandLineComment.c_str()
 						, data
@@ -3106,7 +3165,9 @@ namespace bgfx
 
 } // namespace bgfx
 
+#if !SHADERC_CONFIG_LIBRARY
 int main(int _argc, const char* _argv[])
 {
 	return bgfx::compileShader(_argc, _argv);
 }
+#endif // !SHADERC_CONFIG_LIBRARY
@@ -60,6 +60,11 @@ namespace bgfx
 #	endif
 #endif
 
+// Build shaderc as library (no `main`, see src/shaderc_lib.cpp).
+#ifndef SHADERC_CONFIG_LIBRARY
+#	define SHADERC_CONFIG_LIBRARY 0
+#endif // SHADERC_CONFIG_LIBRARY
+
 #ifndef SHADERC_CONFIG_HAS_GLSL_OPTIMIZER
 #	if __has_include("glsl_optimizer.h")
 #		define SHADERC_CONFIG_HAS_GLSL_OPTIMIZER 1
@@ -83,10 +88,16 @@ namespace bgfx
 #include <vector>
 #include <unordered_map>
 
+#define BGFX_SHADERC_VERSION_MAJOR 1
+#define BGFX_SHADERC_VERSION_MINOR 19
+
 namespace bgfx
 {
 	extern bool g_verbose;
 
+	/// Free space required after shader source passed to `compileShader`.
+	constexpr uint32_t kShaderSourcePadding = 16384;
+
 	bx::StringView nextWord(bx::StringView& _parse);
 
 	constexpr uint16_t kAccessRead  = 0x8000;
@@ -168,6 +179,17 @@ namespace bgfx
 
 		bool optimize;
 		uint32_t optimizationLevel;
+
+		std::string cacheDir;
+		uint64_t cacheMaxSize;
+	};
+
+	struct ShaderCacheStats
+	{
+		uint32_t hits;
+		uint32_t misses;
+		uint32_t stores;
+		uint32_t evictions;
 	};
 
 	typedef std::vector<Uniform> UniformArray;
@@ -177,6 +199,24 @@ namespace bgfx
 	int32_t writef(bx::WriterI* _writer, const char* _format, ...);
 	void writeFile(const char* _filePath, const void* _data, int32_t _size);
 
+	/// Note: `_shader` must be allocated with `new char[]` and is released by this function.
+	bool compileShader(const char* _varying, const char* _comment, char* _shader, uint32_t _shaderLen, const Options& _options, bx::WriterI* _shaderWriter, bx::WriterI* _messageWriter);
+
+	/// Copy shader source to buffer for `compileShader` (UTF-8 BOM trimmed, "\n" at EOF and padding).
+	char* allocShaderSource(const void* _data, uint32_t& _inOutSize);
+
+	/// Parse compile options shared by command line and server requests.
+	void parseOptions(const bx::CommandLine& _cmdLine, Options& _options);
+
+	/// Run compile server over stdin/stdout, see shaderc_server.cpp for protocol.
+	int compileShaderServer();
+
+	/// Same as `compileShader`, but looks up compiled output in `_options.cacheDir` first.
+	bool compileShaderCached(const char* _varying, const char* _comment, char* _shader, uint32_t _shaderLen, const Options& _options, bx::WriterI* _shaderWriter, bx::WriterI* _messageWriter);
+
+	///
+	void getShaderCacheStats(ShaderCacheStats& _outStats);
+
 	bool compileGLSLShader(const Options& _options, uint32_t _version, const std::string& _code, bx::WriterI* _writer, bx::WriterI* _messages);
 	bool compileHLSLShader(const Options& _options, uint32_t _version, const std::string& _code, bx::WriterI* _writer, bx::WriterI* _messages);
 	bool compileDxilShader(const Options& _options, uint32_t _version, const std::string& _code, bx::WriterI* _writer, bx::WriterI* _messages);
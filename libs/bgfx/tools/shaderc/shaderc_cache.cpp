@@ -0,0 +1,468 @@
+/*
+ * Copyright 2011-2026 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include "shaderc.h"
+#include <bx/cpu.h>
+#include <bx/filepath.h>
+#include <bx/mutex.h>
+#include <bx/timer.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <sys/stat.h>
+
+#if BX_PLATFORM_WINDOWS
+#	include <sys/utime.h>
+#else
+#	include <utime.h>
+#endif // BX_PLATFORM_WINDOWS
+
+namespace bgfx
+{
+	// Bump when compiled output for the same input changes (shaderc or compiler backend update).
+	constexpr uint32_t kShaderCacheVersion   = 1;
+	constexpr uint32_t kShaderCacheMagic     = BX_MAKEFOURCC('S', 'H', 'C', '0');
+	constexpr uint32_t kShaderCacheSizeMagic = BX_MAKEFOURCC('S', 'H', 'C', 'S');
+
+	struct ShaderCacheHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint32_t size;
+		uint32_t crc;
+	};
+
+	// Stored in `cache.size` file next to entries.
+	struct ShaderCacheSize
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint64_t total;
+	};
+
+	struct ShaderCacheKey
+	{
+		uint64_t hash[2];
+	};
+
+	struct ShaderCacheEntry
+	{
+		bx::FilePath filePath;
+		uint64_t size;
+		int64_t  time;
+	};
+
+	static uint32_t s_shaderCacheHits;
+	static uint32_t s_shaderCacheMisses;
+	static uint32_t s_shaderCacheStores;
+	static uint32_t s_shaderCacheEvictions;
+
+	static bx::Mutex s_shaderCacheSizeMutex;
+
+	struct NullWriter : public bx::WriterI
+	{
+		virtual int32_t write(const void* /*_data*/, int32_t _size, bx::Error* /*_err*/) override
+		{
+			return _size;
+		}
+	};
+
+	struct TeeWriter : public bx::WriterI
+	{
+		TeeWriter(bx::WriterI* _writer)
+			: m_writer(_writer)
+		{
+		}
+
+		virtual int32_t write(const void* _data, int32_t _size, bx::Error* _err) override
+		{
+			const uint8_t* data = (const uint8_t*)_data;
+			m_data.insert(m_data.end(), data, data + _size);
+
+			return NULL != m_writer
+				? m_writer->write(_data, _size, _err)
+				: _size
+				;
+		}
+
+		bx::WriterI* m_writer;
+		std::vector<uint8_t> m_data;
+	};
+
+	static void hashString(bx::HashMurmur3_64& _hash, const std::string& _str)
+	{
+		_hash.add(uint32_t(_str.size() ) );
+		_hash.add(_str.c_str(), int32_t(_str.size() ) );
+	}
+
+	static uint64_t shaderCacheHash(uint64_t _seed, const char* _varying, const char* _comment, const std::string& _preprocessed, const Options& _options)
+	{
+		bx::HashMurmur3_64 hash;
+		hash.begin(_seed);
+		hash.add(kShaderCacheVersion);
+		hash.add(uint32_t(BGFX_SHADERC_VERSION_MAJOR) );
+		hash.add(uint32_t(BGFX_SHADERC_VERSION_MINOR) );
+		hash.add(uint32_t(BGFX_API_VERSION) );
+
+		hash.add(_options.shaderType);
+		hashString(hash, _options.platform);
+		hashString(hash, _options.profile);
+
+		const uint8_t flags[] =
+		{
+			_options.keepComments,
+			_options.debugInformation,
+			_options.avoidFlowControl,
+			_options.noPreshader,
+			_options.partialPrecision,
+			_options.preferFlowControl,
+			_options.backwardsCompatibility,
+			_options.warningsAreErrors,
+			_options.optimize,
+		};
+		hash.add(flags, sizeof(flags) );
+		hash.add(_options.optimizationLevel);
+
+		hashString(hash, NULL != _varying ? std::string(_varying) : std::string() );
+		hashString(hash, NULL != _comment ? std::string(_comment) : std::string() ); // Prepended to source of text output.
+		hashString(hash, _preprocessed);
+
+		return hash.end();
+	}
+
+	static void shaderCacheFilePath(bx::FilePath& _outFilePath, const Options& _options, const ShaderCacheKey& _key)
+	{
+		char name[64];
+		bx::snprintf(name, sizeof(name), "%016" PRIx64 "%016" PRIx64 ".bin", _key.hash[0], _key.hash[1]);
+
+		_outFilePath.set(_options.cacheDir.c_str() );
+		_outFilePath.join(name);
+	}
+
+	static bool shaderCacheRead(const bx::FilePath& _filePath, std::vector<uint8_t>& _outData)
+	{
+		bx::FileReader reader;
+		if (!bx::open(&reader, _filePath) )
+		{
+			return false;
+		}
+
+		bx::Error err;
+
+		ShaderCacheHeader header;
+		bx::read(&reader, header, &err);
+
+		bool valid = err.isOk()
+			&& kShaderCacheMagic   == header.magic
+			&& kShaderCacheVersion == header.version
+			&& uint64_t(header.size) + sizeof(ShaderCacheHeader) == uint64_t(bx::getSize(&reader) )
+			;
+
+		if (valid)
+		{
+			_outData.resize(header.size);
+			bx::read(&reader, _outData.data(), int32_t(header.size), &err);
+
+			valid = err.isOk()
+				&& header.crc == bx::hash<bx::HashCrc32>(_outData.data(), header.size)
+				;
+		}
+
+		bx::close(&reader);
+
+		if (!valid)
+		{
+			// Truncated or stale entry, drop it so it's recompiled and stored again.
+			bx::remove(_filePath);
+			return false;
+		}
+
+		// Modification time is used as last access time for eviction.
+		utime(_filePath.getCPtr(), NULL);
+
+		return true;
+	}
+
+	static void shaderCacheSizeFilePath(bx::FilePath& _outFilePath, const Options& _options)
+	{
+		_outFilePath.set(_options.cacheDir.c_str() );
+		_outFilePath.join("cache.size");
+	}
+
+	static bool shaderCacheSizeRead(const Options& _options, uint64_t& _outTotal)
+	{
+		bx::FilePath filePath;
+		shaderCacheSizeFilePath(filePath, _options);
+
+		bx::FileReader reader;
+		if (!bx::open(&reader, filePath) )
+		{
+			return false;
+		}
+
+		bx::Error err;
+
+		ShaderCacheSize size;
+		bx::read(&reader, size, &err);
+		bx::close(&reader);
+
+		_outTotal = size.total;
+
+		return err.isOk()
+			&& kShaderCacheSizeMagic == size.magic
+			&& kShaderCacheVersion   == size.version
+			;
+	}
+
+	static void shaderCacheSizeWrite(const Options& _options, uint64_t _total)
+	{
+		bx::FilePath filePath;
+		shaderCacheSizeFilePath(filePath, _options);
+
+		bx::FileWriter writer;
+		if (!bx::open(&writer, filePath) )
+		{
+			return;
+		}
+
+		ShaderCacheSize size;
+		size.magic   = kShaderCacheSizeMagic;
+		size.version = kShaderCacheVersion;
+		size.total   = _total;
+
+		bx::Error err;
+		bx::write(&writer, size, &err);
+		bx::close(&writer);
+	}
+
+	// Scans cache directory, evicts least recently used entries when cache is above size limit, and
+	// resyncs tracked total size.
+	static void shaderCacheTrim(const Options& _options)
+	{
+		bx::DirectoryReader dr;
+		if (!bx::open(&dr, _options.cacheDir.c_str() ) )
+		{
+			return;
+		}
+
+		std::vector<ShaderCacheEntry> entries;
+		uint64_t total = 0;
+
+		bx::FileInfo fi;
+		bx::Error err;
+		while (sizeof(fi) == bx::read(&dr, fi, &err) )
+		{
+			const bx::StringView ext = fi.filePath.getExt();
+
+			if (bx::FileType::File != fi.type
+			||  0 != bx::strCmp(ext, ".bin") )
+			{
+				continue;
+			}
+
+			ShaderCacheEntry entry;
+			entry.filePath.set(_options.cacheDir.c_str() );
+			entry.filePath.join(fi.filePath);
+
+			struct stat st;
+			if (0 != stat(entry.filePath.getCPtr(), &st) )
+			{
+				continue;
+			}
+
+			entry.size = uint64_t(st.st_size);
+			entry.time = int64_t(st.st_mtime);
+			total += entry.size;
+
+			entries.push_back(entry);
+		}
+
+		bx::close(&dr);
+
+		if (total <= _options.cacheMaxSize)
+		{
+			shaderCacheSizeWrite(_options, total);
+			return;
+		}
+
+		std::sort(entries.begin(), entries.end(), [](const ShaderCacheEntry& _lhs, const ShaderCacheEntry& _rhs)
+			{
+				return _lhs.time < _rhs.time;
+			});
+
+		// Trim below limit, so not every store after reaching limit has to evict.
+		const uint64_t target = _options.cacheMaxSize - _options.cacheMaxSize/8;
+
+		for (size_t ii = 0, num = entries.size(); ii < num && total > target; ++ii)
+		{
+			if (bx::remove(entries[ii].filePath) )
+			{
+				total -= entries[ii].size;
+				bx::atomicFetchAndAdd<uint32_t>(&s_shaderCacheEvictions, 1);
+			}
+		}
+
+		shaderCacheSizeWrite(_options, total);
+	}
+
+	static void shaderCacheStore(const bx::FilePath& _filePath, const Options& _options, const ShaderCacheKey& _key, const std::vector<uint8_t>& _data)
+	{
+		if (!bx::makeAll(_options.cacheDir.c_str() ) )
+		{
+			bx::FileInfo fi;
+			if (!bx::stat(fi, _options.cacheDir.c_str() )
+			||  bx::FileType::Dir != fi.type)
+			{
+				return;
+			}
+		}
+
+		// Write to unique temp file and rename it, so concurrent shaderc processes never see partial entry.
+		char tmpName[bx::kMaxFilePath];
+		bx::snprintf(tmpName, sizeof(tmpName), "%s.%016" PRIx64 ".tmp"
+			, _filePath.getCPtr()
+			, uint64_t(bx::getHPCounter() ) ^ _key.hash[1]
+			);
+
+		ShaderCacheHeader header;
+		header.magic   = kShaderCacheMagic;
+		header.version = kShaderCacheVersion;
+		header.size    = uint32_t(_data.size() );
+		header.crc     = bx::hash<bx::HashCrc32>(_data.data(), header.size);
+
+		bx::FileWriter writer;
+		if (!bx::open(&writer, tmpName) )
+		{
+			return;
+		}
+
+		bx::Error err;
+		bx::write(&writer, header, &err);
+		bx::write(&writer, _data.data(), int32_t(_data.size() ), &err);
+		bx::close(&writer);
+
+		if (!err.isOk()
+		||  0 != rename(tmpName, _filePath.getCPtr() ) )
+		{
+			// On Windows rename fails when other process already stored same entry.
+			bx::remove(tmpName);
+			return;
+		}
+
+		bx::atomicFetchAndAdd<uint32_t>(&s_shaderCacheStores, 1);
+
+		// Total size is tracked incrementally, directory is scanned only when size file is missing or
+		// size limit is exceeded. Concurrent shaderc processes may lose updates, every scan resyncs it.
+		bx::MutexScope scope(s_shaderCacheSizeMutex);
+
+		uint64_t total;
+		if (!shaderCacheSizeRead(_options, total) )
+		{
+			shaderCacheTrim(_options);
+			return;
+		}
+
+		total += sizeof(ShaderCacheHeader) + _data.size();
+
+		if (total > _options.cacheMaxSize)
+		{
+			shaderCacheTrim(_options);
+			return;
+		}
+
+		shaderCacheSizeWrite(_options, total);
+	}
+
+	static bool shaderCacheable(const Options& _options)
+	{
+		// Options with side effects besides compiled output (extra files) always go through compiler.
+		return !_options.cacheDir.empty()
+			&& !_options.raw
+			&& !_options.preprocessOnly
+			&& !_options.depends
+			&& !_options.disasm
+			&& !_options.keepIntermediate
+			;
+	}
+
+	bool compileShaderCached(const char* _varying, const char* _comment, char* _shader, uint32_t _shaderLen, const Options& _options, bx::WriterI* _shaderWriter, bx::WriterI* _messageWriter)
+	{
+		if (!shaderCacheable(_options) )
+		{
+			return compileShader(_varying, _comment, _shader, _shaderLen, _options, _shaderWriter, _messageWriter);
+		}
+
+		// Cache key is hash of fully preprocessed source (all includes and defines resolved), comment, and all
+		// options that affect compiled output. Preprocessing is cheap compared to glslang/spirv-opt/backend compile.
+		std::string preprocessed;
+		{
+			char* shader = new char[_shaderLen + kShaderSourcePadding];
+			bx::memCopy(shader, _shader, _shaderLen + 1);
+			bx::memSet(&shader[_shaderLen + 1], 0, kShaderSourcePadding - 1);
+
+			Options options = _options;
+			options.preprocessOnly = true;
+
+			TeeWriter writer(NULL);
+			NullWriter messageWriter;
+
+			if (compileShader(_varying, _comment, shader, _shaderLen, options, &writer, &messageWriter) )
+			{
+				preprocessed.assign((const char*)writer.m_data.data(), writer.m_data.size() );
+			}
+		}
+
+		if (preprocessed.empty() )
+		{
+			// Let compiler report preprocessor errors.
+			return compileShader(_varying, _comment, _shader, _shaderLen, _options, _shaderWriter, _messageWriter);
+		}
+
+		ShaderCacheKey key;
+		key.hash[0] = shaderCacheHash(0,                     _varying, _comment, preprocessed, _options);
+		key.hash[1] = shaderCacheHash(UINT64_C(0x9e3779b97f4a7c15), _varying, _comment, preprocessed, _options);
+
+		bx::FilePath filePath;
+		shaderCacheFilePath(filePath, _options, key);
+
+		std::vector<uint8_t> data;
+		if (shaderCacheRead(filePath, data) )
+		{
+			bx::atomicFetchAndAdd<uint32_t>(&s_shaderCacheHits, 1);
+
+			if (g_verbose)
+			{
+				bx::printf("Shader cache hit: %s\n", filePath.getCPtr() );
+			}
+
+			delete [] _shader;
+
+			bx::Error err;
+			bx::write(_shaderWriter, data.data(), int32_t(data.size() ), &err);
+			return err.isOk();
+		}
+
+		bx::atomicFetchAndAdd<uint32_t>(&s_shaderCacheMisses, 1);
+
+		TeeWriter writer(_shaderWriter);
+		const bool compiled = compileShader(_varying, _comment, _shader, _shaderLen, _options, &writer, _messageWriter);
+
+		if (compiled)
+		{
+			shaderCacheStore(filePath, _options, key, writer.m_data);
+		}
+
+		return compiled;
+	}
+
+	void getShaderCacheStats(ShaderCacheStats& _outStats)
+	{
+		_outStats.hits      = bx::atomicFetchAndAdd<uint32_t>(&s_shaderCacheHits, 0);
+		_outStats.misses    = bx::atomicFetchAndAdd<uint32_t>(&s_shaderCacheMisses, 0);
+		_outStats.stores    = bx::atomicFetchAndAdd<uint32_t>(&s_shaderCacheStores, 0);
+		_outStats.evictions = bx::atomicFetchAndAdd<uint32_t>(&s_shaderCacheEvictions, 0);
+	}
+
+} // namespace bgfx
@@ -0,0 +1,216 @@
+/*
+ * Copyright 2011-2026 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include "shaderc.h"
+
+#include <stdio.h>
+
+#if BX_PLATFORM_WINDOWS
+#	include <fcntl.h>
+#	include <io.h>
+#else
+#	include <unistd.h>
+#endif // BX_PLATFORM_WINDOWS
+
+#if SHADERC_CONFIG_HAS_GLSLANG
+#	include <ShaderLang.h>
+#endif // SHADERC_CONFIG_HAS_GLSLANG
+
+// Server protocol, all values are little-endian uint32_t:
+//
+//   Request:  ServerRequestHeader, args, varying, source
+//   Response: ServerResponseHeader, compiled shader, messages
+//
+// Args are '\0' separated command line options (same as shaderc command line, except -o, --stdout,
+// --varyingdef, --bin2c). `-f <name>` is optional and used only as source name and include dir.
+// Server exits on EOF of stdin.
+
+namespace bgfx
+{
+	constexpr uint32_t kServerRequestMagic  = BX_MAKEFOURCC('S', 'H', 'C', 'Q');
+	constexpr uint32_t kServerResponseMagic = BX_MAKEFOURCC('S', 'H', 'C', 'A');
+
+	struct ServerRequestHeader
+	{
+		uint32_t magic;
+		uint32_t id;
+		uint32_t argsSize;
+		uint32_t varyingSize;
+		uint32_t sourceSize;
+	};
+
+	struct ServerResponseHeader
+	{
+		uint32_t magic;
+		uint32_t id;
+		uint32_t compiled;
+		uint32_t shaderSize;
+		uint32_t messagesSize;
+	};
+
+	struct StringWriter : public bx::WriterI
+	{
+		virtual int32_t write(const void* _data, int32_t _size, bx::Error* /*_err*/) override
+		{
+			m_data.append( (const char*)_data, _size);
+			return _size;
+		}
+
+		std::string m_data;
+	};
+
+	static bool readExact(FILE* _file, void* _data, uint32_t _size)
+	{
+		return 0 == _size
+			|| 1 == fread(_data, _size, 1, _file)
+			;
+	}
+
+	static bool compileRequest(const std::vector<char>& _args, const std::string& _varying, const std::string& _source, bx::WriterI* _shaderWriter, bx::WriterI* _messageWriter)
+	{
+		std::vector<const char*> argv;
+		argv.push_back("shaderc");
+
+		for (size_t pos = 0, num = _args.size(); pos < num; pos += bx::strLen(&_args[pos]) + 1)
+		{
+			argv.push_back(&_args[pos]);
+		}
+
+		bx::CommandLine cmdLine(int32_t(argv.size() ), argv.data() );
+
+		bx::ErrorAssert messageErr;
+
+		const char* type = cmdLine.findOption('\0', "type");
+		if (NULL == type)
+		{
+			bx::write(_messageWriter, &messageErr, "Must specify shader type.\n");
+			return false;
+		}
+
+		const char* filePath = cmdLine.findOption('f');
+
+		Options options;
+		options.inputFilePath = NULL != filePath ? filePath : "server.sc";
+		options.shaderType = bx::toLower(type[0]);
+
+		parseOptions(cmdLine, options);
+
+		if (NULL != filePath)
+		{
+			bx::FilePath fp(filePath);
+			bx::StringView path(fp.getPath() );
+			options.includeDirs.push_back(std::string(path.getPtr(), path.getTerm() ) );
+		}
+
+		uint32_t size = uint32_t(_source.size() );
+		char* shader = allocShaderSource(_source.c_str(), size);
+
+		return compileShaderCached(
+			  'c' != options.shaderType && !_varying.empty() ? _varying.c_str() : NULL
+			, ""
+			, shader
+			, size
+			, options
+			, _shaderWriter
+			, _messageWriter
+			);
+	}
+
+	int compileShaderServer()
+	{
+		// Responses go to private copy of stdout. Stdout itself is redirected to stderr, so diagnostic
+		// prints from compilers (printCode, verbose, ...) can't corrupt response stream.
+		const int outFd = dup(fileno(stdout) );
+		dup2(fileno(stderr), fileno(stdout) );
+
+#if BX_PLATFORM_WINDOWS
+		_setmode(_fileno(stdin), _O_BINARY);
+		_setmode(outFd, _O_BINARY);
+#endif // BX_PLATFORM_WINDOWS
+
+		FILE* out = fdopen(outFd, "wb");
+		if (NULL == out)
+		{
+			bx::printf("Unable to open server output.\n");
+			return bx::kExitFailure;
+		}
+
+#if SHADERC_CONFIG_HAS_GLSLANG
+		// Keep glslang initialized for server lifetime, backends init/finalize is ref counted.
+		glslang::InitializeProcess();
+#endif // SHADERC_CONFIG_HAS_GLSLANG
+
+		std::vector<char> args;
+		std::string varying;
+		std::string source;
+
+		int result = bx::kExitSuccess;
+
+		for (;;)
+		{
+			ServerRequestHeader request;
+			if (!readExact(stdin, &request, sizeof(request) ) )
+			{
+				break;
+			}
+
+			if (kServerRequestMagic != request.magic)
+			{
+				bx::printf("Invalid server request.\n");
+				result = bx::kExitFailure;
+				break;
+			}
+
+			args.resize(request.argsSize);
+			varying.resize(request.varyingSize);
+			source.resize(request.sourceSize);
+
+			if (!readExact(stdin, args.data(), request.argsSize)
+			||  !readExact(stdin, varying.data(), request.varyingSize)
+			||  !readExact(stdin, source.data(), request.sourceSize) )
+			{
+				bx::printf("Truncated server request.\n");
+				result = bx::kExitFailure;
+				break;
+			}
+
+			if (!args.empty()
+			&&  '\0' != args.back() )
+			{
+				args.push_back('\0');
+			}
+
+			StringWriter shaderWriter;
+			StringWriter messageWriter;
+			const bool compiled = compileRequest(args, varying, source, &shaderWriter, &messageWriter);
+
+			ServerResponseHeader response;
+			response.magic        = kServerResponseMagic;
+			response.id           = request.id;
+			response.compiled     = compiled;
+			response.shaderSize   = compiled ? uint32_t(shaderWriter.m_data.size() ) : 0;
+			response.messagesSize = uint32_t(messageWriter.m_data.size() );
+
+			fwrite(&response, sizeof(response), 1, out);
+			fwrite(shaderWriter.m_data.c_str(), response.shaderSize, 1, out);
+			fwrite(messageWriter.m_data.c_str(), response.messagesSize, 1, out);
+
+			if (0 != fflush(out) )
+			{
+				result = bx::kExitFailure;
+				break;
+			}
+		}
+
+#if SHADERC_CONFIG_HAS_GLSLANG
+		glslang::FinalizeProcess();
+#endif // SHADERC_CONFIG_HAS_GLSLANG
+
+		fclose(out);
+
+		return result;
+	}
+
+} // namespace bgfx
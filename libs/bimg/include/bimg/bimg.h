@@ -586,6 +586,18 @@ namespace bimg
 		, bx::Error* _err = NULL
 		);
 
+	/// Parses DDS, KTX or PVR3 image without copying image data. Returned image container points
+	/// into _src, which must outlive it, and imageFree releases only container. Mips keep layout
+	/// of source file, and must be accessed with imageGetRawData passing container m_data and
+	/// m_size.
+	///
+	ImageContainer* imageParseRef(
+		  bx::AllocatorI* _allocator
+		, const void* _src
+		, uint32_t _size
+		, bx::Error* _err = NULL
+		);
+
 	///
 	ImageContainer* imageParseDds(
 		  bx::AllocatorI* _allocator
@@ -674,6 +686,53 @@ namespace bimg
 		, ImageMip& _mip
 		);
 
+	/// Reads single mip into _dst from stream that image container was parsed from with
+	/// imageParse, mips are loaded on demand instead of reading whole file into memory.
+	///
+	bool imageReadRawData(
+		  const ImageContainer& _imageContainer
+		, uint16_t _side
+		, uint8_t _lod
+		, bx::ReaderSeekerI* _reader
+		, void* _dst
+		, uint32_t _dstSize
+		, ImageMip& _mip
+		, bx::Error* _err = NULL
+		);
+
+	/// Job function, called by job scheduler for each job index.
+	typedef void (*JobFn)(void* _userData, uint32_t _index);
+
+	/// Job scheduler interface, used by image encoders to split work into independent jobs.
+	///
+	struct JobSchedulerI
+	{
+		///
+		virtual ~JobSchedulerI() = 0;
+
+		/// Returns number of jobs that can run concurrently, including calling thread.
+		virtual uint32_t getConcurrency() const = 0;
+
+		/// Calls _fn for each index in range [0, _num), and returns once all calls are finished.
+		/// Calls can run concurrently on any thread, including the calling one.
+		virtual void parallelFor(JobFn _fn, void* _userData, uint32_t _num) = 0;
+	};
+
+	/// Sets job scheduler used by image functions. When NULL (default) all work is done on
+	/// calling thread.
+	void setJobScheduler(JobSchedulerI* _jobScheduler);
+
+	///
+	JobSchedulerI* getJobScheduler();
+
+	/// Creates job scheduler with _numThreads worker threads. Calling thread also runs jobs, so up
+	/// to _numThreads+1 jobs run concurrently. Concurrent calls to parallelFor from different threads
+	/// share worker threads, and each call waits only for its own jobs.
+	JobSchedulerI* createJobScheduler(bx::AllocatorI* _allocator, uint32_t _numThreads);
+
+	///
+	void destroyJobScheduler(JobSchedulerI* _jobScheduler);
+
 } // namespace bimg
 
 #endif // BIMG_IMAGE_H_HEADER_GUARD
@@ -123,6 +123,14 @@ namespace bimg
 		, bx::Error* _err
 		);
 
+	/// Returns number of jobs that can run concurrently on job scheduler set with
+	/// setJobScheduler, or 1 when there is none.
+	uint32_t getConcurrency();
+
+	/// Runs jobs on job scheduler set with setJobScheduler, or on calling thread when there is
+	/// none.
+	void parallelFor(JobFn _fn, void* _userData, uint32_t _num);
+
 } // namespace bimg
 
 #endif // BIMG_P_H_HEADER_GUARD
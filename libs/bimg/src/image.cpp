@@ -4,6 +4,7 @@
  */
 
 #include "bimg_p.h"
+#include <bx/cpu.h>
 #include <bx/hash.h>
 
 #include <astcenc.h>
@@ -1223,8 +1224,315 @@ namespace bimg
 		}
 	}
 
+	typedef void (*ConvertRowFn)(void* _dst, const void* _src, uint32_t _width);
+
+	// Same as generic path, but with pack/unpack inlined.
+	template<UnpackFn unpackT, uint32_t srcBppT, PackFn packT, uint32_t dstBppT>
+	static void convertRow(void* _dst, const void* _src, uint32_t _width)
+	{
+		const uint8_t* src = (const uint8_t*)_src;
+		uint8_t* dst = (uint8_t*)_dst;
+
+		for (uint32_t xx = 0; xx < _width; ++xx, src += srcBppT/8, dst += dstBppT/8)
+		{
+			float rgba[4];
+			unpackT(rgba, src);
+			packT(dst, rgba);
+		}
+	}
+
+	// Matches bx::toUnorm, since for non-negative values truncation gives same result as
+	// bx::round, but compiler can vectorize it.
+	BX_FORCE_INLINE uint32_t toUnormTrunc(float _value, float _scale)
+	{
+		return uint32_t(bx::clamp(_value, 0.0f, 1.0f) * _scale + 0.5f);
+	}
+
+	// Channel conversion tables for formats with small integer channels, computed with same
+	// functions as generic path.
+	struct UnormLut
+	{
+		UnormLut()
+		{
+			for (uint32_t ii = 0; ii < 256; ++ii)
+			{
+				const float value = bx::fromUnorm(ii, 255.0f);
+				unorm8ToF32[ii]     = value;
+				unorm8ToF16[ii]     = bx::halfFromFloat(value);
+				unorm8ToUnorm10[ii] = uint16_t(bx::toUnorm(value, 1023.0f) );
+				unorm8ToUnorm2[ii]  = uint8_t(bx::toUnorm(value, 3.0f) );
+			}
+
+			for (uint32_t ii = 0; ii < 1024; ++ii)
+			{
+				const float value = float(ii) / 1023.0f;
+				unorm10ToF32[ii]   = value;
+				unorm10ToUnorm8[ii] = uint8_t(bx::toUnorm(value, 255.0f) );
+			}
+
+			for (uint32_t ii = 0; ii < 4; ++ii)
+			{
+				const float value = float(ii) / 3.0f;
+				unorm2ToF32[ii]    = value;
+				unorm2ToUnorm8[ii] = uint8_t(bx::toUnorm(value, 255.0f) );
+			}
+		}
+
+		float    unorm8ToF32[256];
+		uint16_t unorm8ToF16[256];
+		uint16_t unorm8ToUnorm10[256];
+		uint8_t  unorm8ToUnorm2[256];
+		float    unorm10ToF32[1024];
+		uint8_t  unorm10ToUnorm8[1024];
+		float    unorm2ToF32[4];
+		uint8_t  unorm2ToUnorm8[4];
+	};
+
+	static const UnormLut s_unormLut;
+
+	// Half float conversion tables are 320KB, they are built on first use.
+	struct HalfLut
+	{
+		HalfLut()
+		{
+			for (uint32_t ii = 0; ii < 65536; ++ii)
+			{
+				const float value = bx::halfToFloat(uint16_t(ii) );
+				f16ToF32[ii]    = value;
+				f16ToUnorm8[ii] = uint8_t(bx::toUnorm(value, 255.0f) );
+			}
+		}
+
+		float   f16ToF32[65536];
+		uint8_t f16ToUnorm8[65536];
+	};
+
+	static const HalfLut& getHalfLut()
+	{
+		static const HalfLut s_halfLut;
+		return s_halfLut;
+	}
+
+	static void convertRowRgba8Bgra8(void* _dst, const void* _src, uint32_t _width)
+	{
+		const uint32_t* src = (const uint32_t*)_src;
+		uint32_t* dst = (uint32_t*)_dst;
+
+		for (uint32_t xx = 0; xx < _width; ++xx)
+		{
+			const uint32_t abgr = src[xx];
+			dst[xx] = 0
+				| ( abgr      & 0xff00ff00)
+				| ((abgr>>16) & 0x000000ff)
+				| ((abgr<<16) & 0x00ff0000)
+				;
+		}
+	}
+
+	static void convertRowR8Rgba8(void* _dst, const void* _src, uint32_t _width)
+	{
+		const uint8_t* src = (const uint8_t*)_src;
+		uint32_t* dst = (uint32_t*)_dst;
+
+		for (uint32_t xx = 0; xx < _width; ++xx)
+		{
+			dst[xx] = 0xff000000 | src[xx];
+		}
+	}
+
+	static void convertRowRgba8R8(void* _dst, const void* _src, uint32_t _width)
+	{
+		const uint8_t* src = (const uint8_t*)_src;
+		uint8_t* dst = (uint8_t*)_dst;
+
+		for (uint32_t xx = 0; xx < _width; ++xx)
+		{
+			dst[xx] = src[xx*4];
+		}
+	}
+
+	static void convertRowRgba8Rgba32f(void* _dst, const void* _src, uint32_t _width)
+	{
+		const uint8_t* src = (const uint8_t*)_src;
+		float* dst = (float*)_dst;
+
+		for (uint32_t xx = 0, num = _width*4; xx < num; ++xx)
+		{
+			dst[xx] = s_unormLut.unorm8ToF32[src[xx] ];
+		}
+	}
+
+	static void convertRowRgba8Rgba16f(void* _dst, const void* _src, uint32_t _width)
+	{
+		const uint8_t* src = (const uint8_t*)_src;
+		uint16_t* dst = (uint16_t*)_dst;
+
+		for (uint32_t xx = 0, num = _width*4; xx < num; ++xx)
+		{
+			dst[xx] = s_unormLut.unorm8ToF16[src[xx] ];
+		}
+	}
+
+	template<bool bgraT>
+	static void convertRowRgba32fRgba8(void* _dst, const void* _src, uint32_t _width)
+	{
+		const float* src = (const float*)_src;
+		uint8_t* dst = (uint8_t*)_dst;
+
+		for (uint32_t xx = 0; xx < _width; ++xx, src += 4, dst += 4)
+		{
+			dst[bgraT ? 2 : 0] = uint8_t(toUnormTrunc(src[0], 255.0f) );
+			dst[1]             = uint8_t(toUnormTrunc(src[1], 255.0f) );
+			dst[bgraT ? 0 : 2] = uint8_t(toUnormTrunc(src[2], 255.0f) );
+			dst[3]             = uint8_t(toUnormTrunc(src[3], 255.0f) );
+		}
+	}
+
+	static void convertRowRgba16fRgba8(void* _dst, const void* _src, uint32_t _width)
+	{
+		const HalfLut& lut = getHalfLut();
+		const uint16_t* src = (const uint16_t*)_src;
+		uint8_t* dst = (uint8_t*)_dst;
+
+		for (uint32_t xx = 0, num = _width*4; xx < num; ++xx)
+		{
+			dst[xx] = lut.f16ToUnorm8[src[xx] ];
+		}
+	}
+
+	static void convertRowRgba16fRgba32f(void* _dst, const void* _src, uint32_t _width)
+	{
+		const HalfLut& lut = getHalfLut();
+		const uint16_t* src = (const uint16_t*)_src;
+		float* dst = (float*)_dst;
+
+		for (uint32_t xx = 0, num = _width*4; xx < num; ++xx)
+		{
+			dst[xx] = lut.f16ToF32[src[xx] ];
+		}
+	}
+
+	static void convertRowRgba8Rgb10a2(void* _dst, const void* _src, uint32_t _width)
+	{
+		const uint8_t* src = (const uint8_t*)_src;
+		uint32_t* dst = (uint32_t*)_dst;
+
+		for (uint32_t xx = 0; xx < _width; ++xx, src += 4)
+		{
+			dst[xx] = 0
+				| (uint32_t(s_unormLut.unorm8ToUnorm10[src[0] ])    )
+				| (uint32_t(s_unormLut.unorm8ToUnorm10[src[1] ])<<10)
+				| (uint32_t(s_unormLut.unorm8ToUnorm10[src[2] ])<<20)
+				| (uint32_t(s_unormLut.unorm8ToUnorm2 [src[3] ])<<30)
+				;
+		}
+	}
+
+	static void convertRowRgb10a2Rgba8(void* _dst, const void* _src, uint32_t _width)
+	{
+		const uint32_t* src = (const uint32_t*)_src;
+		uint8_t* dst = (uint8_t*)_dst;
+
+		for (uint32_t xx = 0; xx < _width; ++xx, dst += 4)
+		{
+			const uint32_t packed = src[xx];
+			dst[0] = s_unormLut.unorm10ToUnorm8[(packed    ) & 0x3ff];
+			dst[1] = s_unormLut.unorm10ToUnorm8[(packed>>10) & 0x3ff];
+			dst[2] = s_unormLut.unorm10ToUnorm8[(packed>>20) & 0x3ff];
+			dst[3] = s_unormLut.unorm2ToUnorm8 [(packed>>30)        ];
+		}
+	}
+
+	static void convertRowRgb10a2Rgba32f(void* _dst, const void* _src, uint32_t _width)
+	{
+		const uint32_t* src = (const uint32_t*)_src;
+		float* dst = (float*)_dst;
+
+		for (uint32_t xx = 0; xx < _width; ++xx, dst += 4)
+		{
+			const uint32_t packed = src[xx];
+			dst[0] = s_unormLut.unorm10ToF32[(packed    ) & 0x3ff];
+			dst[1] = s_unormLut.unorm10ToF32[(packed>>10) & 0x3ff];
+			dst[2] = s_unormLut.unorm10ToF32[(packed>>20) & 0x3ff];
+			dst[3] = s_unormLut.unorm2ToF32 [(packed>>30)        ];
+		}
+	}
+
+	static void convertRowRgba32fRgb10a2(void* _dst, const void* _src, uint32_t _width)
+	{
+		const float* src = (const float*)_src;
+		uint32_t* dst = (uint32_t*)_dst;
+
+		for (uint32_t xx = 0; xx < _width; ++xx, src += 4)
+		{
+			dst[xx] = 0
+				| (toUnormTrunc(src[0], 1023.0f)    )
+				| (toUnormTrunc(src[1], 1023.0f)<<10)
+				| (toUnormTrunc(src[2], 1023.0f)<<20)
+				| (toUnormTrunc(src[3],    3.0f)<<30)
+				;
+		}
+	}
+
+	struct ConvertRow
+	{
+		TextureFormat::Enum dstFormat;
+		TextureFormat::Enum srcFormat;
+		ConvertRowFn fn;
+	};
+
+	// Fast paths for common format pairs, output matches generic unpack/pack path bit for bit.
+	static const ConvertRow s_convertRow[] =
+	{
+		{ TextureFormat::BGRA8,   TextureFormat::RGBA8,   convertRowRgba8Bgra8                                           },
+		{ TextureFormat::RGBA8,   TextureFormat::BGRA8,   convertRowRgba8Bgra8                                           },
+		{ TextureFormat::RGBA8,   TextureFormat::R8,      convertRowR8Rgba8                                              },
+		{ TextureFormat::R8,      TextureFormat::RGBA8,   convertRowRgba8R8                                              },
+		{ TextureFormat::RGBA32F, TextureFormat::RGBA8,   convertRowRgba8Rgba32f                                         },
+		{ TextureFormat::RGBA8,   TextureFormat::RGBA32F, convertRowRgba32fRgba8<false>                                  },
+		{ TextureFormat::BGRA8,   TextureFormat::RGBA32F, convertRowRgba32fRgba8<true>                                   },
+		{ TextureFormat::RGBA16F, TextureFormat::RGBA8,   convertRowRgba8Rgba16f                                         },
+		{ TextureFormat::RGBA8,   TextureFormat::RGBA16F, convertRowRgba16fRgba8                                         },
+		{ TextureFormat::RGBA32F, TextureFormat::RGBA16F, convertRowRgba16fRgba32f                                       },
+		{ TextureFormat::RGBA16F, TextureFormat::RGBA32F, convertRow<bx::unpackRgba32F, 128, bx::packRgba16F, 64>        },
+		{ TextureFormat::RGB10A2, TextureFormat::RGBA8,   convertRowRgba8Rgb10a2                                         },
+		{ TextureFormat::RGBA8,   TextureFormat::RGB10A2, convertRowRgb10a2Rgba8                                         },
+		{ TextureFormat::RGB10A2, TextureFormat::RGBA32F, convertRowRgba32fRgb10a2                                       },
+		{ TextureFormat::RGBA32F, TextureFormat::RGB10A2, convertRowRgb10a2Rgba32f                                       },
+	};
+
+	static ConvertRowFn findConvertRow(TextureFormat::Enum _dstFormat, TextureFormat::Enum _srcFormat)
+	{
+		for (uint32_t ii = 0; ii < BX_COUNTOF(s_convertRow); ++ii)
+		{
+			const ConvertRow& convert = s_convertRow[ii];
+
+			if (convert.dstFormat == _dstFormat
+			&&  convert.srcFormat == _srcFormat)
+			{
+				return convert.fn;
+			}
+		}
+
+		return NULL;
+	}
+
 	bool imageConvert(bx::AllocatorI* _allocator, void* _dst, TextureFormat::Enum _dstFormat, const void* _src, TextureFormat::Enum _srcFormat, uint32_t _width, uint32_t _height, uint32_t _depth, uint32_t _srcPitch, uint32_t _dstPitch)
 	{
+		ConvertRowFn convertRowFn = findConvertRow(_dstFormat, _srcFormat);
+		if (NULL != convertRowFn)
+		{
+			const uint8_t* src = (const uint8_t*)_src;
+			uint8_t* dst = (uint8_t*)_dst;
+
+			for (uint32_t yy = 0, num = _height*_depth; yy < num; ++yy, src += _srcPitch, dst += _dstPitch)
+			{
+				convertRowFn(dst, src, _width);
+			}
+
+			return true;
+		}
+
 		UnpackFn unpack = s_packUnpack[_srcFormat].unpack;
 		PackFn   pack   = s_packUnpack[_dstFormat].pack;
 		if (NULL == pack
@@ -1428,118 +1736,224 @@ namespace bimg
 		}
 	}
 
-	static void decodeBlockDxt1(uint8_t _dst[16*4], const uint8_t _src[8])
+	static void decodeBlockDxt23A(uint8_t _dst[16*4], const uint8_t _src[8])
 	{
-		if (!BX_ENABLED(BIMG_CONFIG_DECODE_BC1 || BIMG_CONFIG_DECODE_BC2 || BIMG_CONFIG_DECODE_BC3) )
+		if (!BX_ENABLED(BIMG_CONFIG_DECODE_BC2) )
 		{
 			return;
 		}
 
-		uint8_t colors[4*4];
-
-		uint32_t c0 = _src[0] | (_src[1] << 8);
-		colors[0] = bitRangeConvert( (c0>> 0)&0x1f, 5, 8);
-		colors[1] = bitRangeConvert( (c0>> 5)&0x3f, 6, 8);
-		colors[2] = bitRangeConvert( (c0>>11)&0x1f, 5, 8);
-		colors[3] = 255;
+		for (uint32_t ii = 0, next = 0; ii < 16*4; ii += 4, next += 4)
+		{
+			uint32_t c0 = (_src[next>>3] >> (next&7) ) & 0xf;
+			_dst[ii] = bitRangeConvert(c0, 4, 8);
+		}
+	}
 
-		uint32_t c1 = _src[2] | (_src[3] << 8);
-		colors[4] = bitRangeConvert( (c1>> 0)&0x1f, 5, 8);
-		colors[5] = bitRangeConvert( (c1>> 5)&0x3f, 6, 8);
-		colors[6] = bitRangeConvert( (c1>>11)&0x1f, 5, 8);
-		colors[7] = 255;
+	static void decodeBlockDxtAlphaPalette(uint8_t _alpha[8], const uint8_t _src[2])
+	{
+		_alpha[0] = _src[0];
+		_alpha[1] = _src[1];
 
-		if (c0 > c1)
+		if (_alpha[0] > _alpha[1])
 		{
-			colors[ 8] = (2*colors[0] + colors[4]) / 3;
-			colors[ 9] = (2*colors[1] + colors[5]) / 3;
-			colors[10] = (2*colors[2] + colors[6]) / 3;
-			colors[11] = 255;
-
-			colors[12] = (colors[0] + 2*colors[4]) / 3;
-			colors[13] = (colors[1] + 2*colors[5]) / 3;
-			colors[14] = (colors[2] + 2*colors[6]) / 3;
-			colors[15] = 255;
+			_alpha[2] = (6*_alpha[0] + 1*_alpha[1]) / 7;
+			_alpha[3] = (5*_alpha[0] + 2*_alpha[1]) / 7;
+			_alpha[4] = (4*_alpha[0] + 3*_alpha[1]) / 7;
+			_alpha[5] = (3*_alpha[0] + 4*_alpha[1]) / 7;
+			_alpha[6] = (2*_alpha[0] + 5*_alpha[1]) / 7;
+			_alpha[7] = (1*_alpha[0] + 6*_alpha[1]) / 7;
 		}
 		else
 		{
-			colors[ 8] = (colors[0] + colors[4]) / 2;
-			colors[ 9] = (colors[1] + colors[5]) / 2;
-			colors[10] = (colors[2] + colors[6]) / 2;
-			colors[11] = 255;
+			_alpha[2] = (4*_alpha[0] + 1*_alpha[1]) / 5;
+			_alpha[3] = (3*_alpha[0] + 2*_alpha[1]) / 5;
+			_alpha[4] = (2*_alpha[0] + 3*_alpha[1]) / 5;
+			_alpha[5] = (1*_alpha[0] + 4*_alpha[1]) / 5;
+			_alpha[6] = 0;
+			_alpha[7] = 255;
+		}
+	}
 
-			colors[12] = 0;
-			colors[13] = 0;
-			colors[14] = 0;
-			colors[15] = 0;
+	static uint64_t decodeBlockDxtAlphaIndices(const uint8_t _src[8])
+	{
+		return 0
+			| (uint64_t(_src[2])      )
+			| (uint64_t(_src[3]) <<  8)
+			| (uint64_t(_src[4]) << 16)
+			| (uint64_t(_src[5]) << 24)
+			| (uint64_t(_src[6]) << 32)
+			| (uint64_t(_src[7]) << 40)
+			;
+	}
+
+	static void decodeBlockDxt45A(uint8_t _dst[16*4], const uint8_t _src[8])
+	{
+		if (!BX_ENABLED(BIMG_CONFIG_DECODE_BC3 || BIMG_CONFIG_DECODE_BC4 || BIMG_CONFIG_DECODE_BC5) )
+		{
+			return;
 		}
 
-		for (uint32_t ii = 0, next = 8*4; ii < 16*4; ii += 4, next += 2)
+		uint8_t alpha[8];
+		decodeBlockDxtAlphaPalette(alpha, _src);
+
+		uint64_t indices = decodeBlockDxtAlphaIndices(_src);
+		for (uint32_t ii = 0; ii < 16*4; ii += 4, indices >>= 3)
 		{
-			int idx = ( (_src[next>>3] >> (next & 7) ) & 3) * 4;
-			_dst[ii+0] = colors[idx+0];
-			_dst[ii+1] = colors[idx+1];
-			_dst[ii+2] = colors[idx+2];
-			_dst[ii+3] = colors[idx+3];
+			_dst[ii] = alpha[indices&7];
 		}
 	}
 
-	static void decodeBlockDxt23A(uint8_t _dst[16*4], const uint8_t _src[8])
+	// Palette entries are packed as BGRA8, with alpha left zero for four color blocks.
+	static void decodeBlockDxtColorPalette(uint32_t _colors[4], const uint8_t _src[8], bool _punchThrough)
 	{
-		if (!BX_ENABLED(BIMG_CONFIG_DECODE_BC2) )
+		const uint32_t c0 = _src[0] | (_src[1] << 8);
+		const uint32_t b0 = bitRangeConvert( (c0>> 0)&0x1f, 5, 8);
+		const uint32_t g0 = bitRangeConvert( (c0>> 5)&0x3f, 6, 8);
+		const uint32_t r0 = bitRangeConvert( (c0>>11)&0x1f, 5, 8);
+
+		const uint32_t c1 = _src[2] | (_src[3] << 8);
+		const uint32_t b1 = bitRangeConvert( (c1>> 0)&0x1f, 5, 8);
+		const uint32_t g1 = bitRangeConvert( (c1>> 5)&0x3f, 6, 8);
+		const uint32_t r1 = bitRangeConvert( (c1>>11)&0x1f, 5, 8);
+
+		const uint32_t alpha = _punchThrough ? UINT32_C(0xff000000) : 0;
+
+		_colors[0] = b0 | (g0 << 8) | (r0 << 16) | alpha;
+		_colors[1] = b1 | (g1 << 8) | (r1 << 16) | alpha;
+
+		if (!_punchThrough
+		||  c0 > c1)
 		{
-			return;
+			_colors[2] = ( (2*b0 + b1) / 3) | ( ( (2*g0 + g1) / 3) << 8) | ( ( (2*r0 + r1) / 3) << 16) | alpha;
+			_colors[3] = ( (b0 + 2*b1) / 3) | ( ( (g0 + 2*g1) / 3) << 8) | ( ( (r0 + 2*r1) / 3) << 16) | alpha;
 		}
-
-		for (uint32_t ii = 0, next = 0; ii < 16*4; ii += 4, next += 4)
+		else
 		{
-			uint32_t c0 = (_src[next>>3] >> (next&7) ) & 0xf;
-			_dst[ii] = bitRangeConvert(c0, 4, 8);
+			_colors[2] = ( (b0 + b1) / 2) | ( ( (g0 + g1) / 2) << 8) | ( ( (r0 + r1) / 2) << 16) | alpha;
+			_colors[3] = 0;
 		}
 	}
 
-	static void decodeBlockDxt45A(uint8_t _dst[16*4], const uint8_t _src[8])
+	static uint32_t decodeBlockDxtColorIndices(const uint8_t _src[8])
 	{
-		if (!BX_ENABLED(BIMG_CONFIG_DECODE_BC3 || BIMG_CONFIG_DECODE_BC4 || BIMG_CONFIG_DECODE_BC5) )
+		return 0
+			| (uint32_t(_src[4])      )
+			| (uint32_t(_src[5]) <<  8)
+			| (uint32_t(_src[6]) << 16)
+			| (uint32_t(_src[7]) << 24)
+			;
+	}
+
+	// BC1, BC3, BC4 and BC5 decoders below write BGRA8 block directly into destination rows,
+	// instead of going through 4x4 temporary block.
+	static void decodeBlockBc1Bgra8(uint8_t* _dst, uint32_t _dstPitch, const uint8_t _src[8])
+	{
+		uint32_t colors[4];
+		decodeBlockDxtColorPalette(colors, _src, true);
+
+		uint32_t indices = decodeBlockDxtColorIndices(_src);
+		for (uint32_t yy = 0; yy < 4; ++yy, indices >>= 8)
 		{
-			return;
+			uint32_t* dst = (uint32_t*)&_dst[yy*_dstPitch];
+			dst[0] = colors[(indices   )&3];
+			dst[1] = colors[(indices>>2)&3];
+			dst[2] = colors[(indices>>4)&3];
+			dst[3] = colors[(indices>>6)&3];
 		}
+	}
 
+	static void decodeBlockBc3Bgra8(uint8_t* _dst, uint32_t _dstPitch, const uint8_t _src[16])
+	{
 		uint8_t alpha[8];
-		alpha[0] = _src[0];
-		alpha[1] = _src[1];
+		decodeBlockDxtAlphaPalette(alpha, _src);
 
-		if (alpha[0] > alpha[1])
+		uint32_t colors[4];
+		decodeBlockDxtColorPalette(colors, _src+8, false);
+
+		uint64_t alphaIndices = decodeBlockDxtAlphaIndices(_src);
+		uint32_t colorIndices = decodeBlockDxtColorIndices(_src+8);
+		for (uint32_t yy = 0; yy < 4; ++yy)
 		{
-			alpha[2] = (6*alpha[0] + 1*alpha[1]) / 7;
-			alpha[3] = (5*alpha[0] + 2*alpha[1]) / 7;
-			alpha[4] = (4*alpha[0] + 3*alpha[1]) / 7;
-			alpha[5] = (3*alpha[0] + 4*alpha[1]) / 7;
-			alpha[6] = (2*alpha[0] + 5*alpha[1]) / 7;
-			alpha[7] = (1*alpha[0] + 6*alpha[1]) / 7;
+			uint32_t* dst = (uint32_t*)&_dst[yy*_dstPitch];
+
+			for (uint32_t xx = 0; xx < 4; ++xx, alphaIndices >>= 3, colorIndices >>= 2)
+			{
+				dst[xx] = colors[colorIndices&3] | (uint32_t(alpha[alphaIndices&7]) << 24);
+			}
 		}
-		else
+	}
+
+	static void decodeBlockBc4Bgra8(uint8_t* _dst, uint32_t _dstPitch, const uint8_t _src[8])
+	{
+		uint8_t red[8];
+		decodeBlockDxtAlphaPalette(red, _src);
+
+		uint64_t indices = decodeBlockDxtAlphaIndices(_src);
+		for (uint32_t yy = 0; yy < 4; ++yy)
+		{
+			uint32_t* dst = (uint32_t*)&_dst[yy*_dstPitch];
+
+			for (uint32_t xx = 0; xx < 4; ++xx, indices >>= 3)
+			{
+				dst[xx] = red[indices&7] | UINT32_C(0xff000000);
+			}
+		}
+	}
+
+	static void decodeBlockBc5Bgra8(uint8_t* _dst, uint32_t _dstPitch, const uint8_t _src[16])
+	{
+		uint8_t red[8];
+		decodeBlockDxtAlphaPalette(red, _src);
+
+		uint8_t green[8];
+		decodeBlockDxtAlphaPalette(green, _src+8);
+
+		float nx[8];
+		float ny[8];
+		for (uint32_t ii = 0; ii < 8; ++ii)
 		{
-			alpha[2] = (4*alpha[0] + 1*alpha[1]) / 5;
-			alpha[3] = (3*alpha[0] + 2*alpha[1]) / 5;
-			alpha[4] = (2*alpha[0] + 3*alpha[1]) / 5;
-			alpha[5] = (1*alpha[0] + 4*alpha[1]) / 5;
-			alpha[6] = 0;
-			alpha[7] = 255;
+			nx[ii] = red[ii]  *2.0f/255.0f - 1.0f;
+			ny[ii] = green[ii]*2.0f/255.0f - 1.0f;
 		}
 
-		uint32_t idx0 = _src[2];
-		uint32_t idx1 = _src[5];
-		idx0 |= uint32_t(_src[3])<<8;
-		idx1 |= uint32_t(_src[6])<<8;
-		idx0 |= uint32_t(_src[4])<<16;
-		idx1 |= uint32_t(_src[7])<<16;
-		for (uint32_t ii = 0; ii < 8*4; ii += 4)
+		uint64_t redIndices   = decodeBlockDxtAlphaIndices(_src);
+		uint64_t greenIndices = decodeBlockDxtAlphaIndices(_src+8);
+
+		using namespace bx;
+		const simd128_t zero  = simd_zero();
+		const simd128_t one   = simd_splat(1.0f);
+		const simd128_t half  = simd_splat(0.5f);
+		const simd128_t unorm = simd_splat(255.0f);
+
+		for (uint32_t yy = 0; yy < 4; ++yy)
 		{
-			_dst[ii]    = alpha[idx0&7];
-			_dst[ii+32] = alpha[idx1&7];
-			idx0 >>= 3;
-			idx1 >>= 3;
+			uint32_t ri[4];
+			uint32_t gi[4];
+
+			for (uint32_t xx = 0; xx < 4; ++xx, redIndices >>= 3, greenIndices >>= 3)
+			{
+				ri[xx] = uint32_t(redIndices&7);
+				gi[xx] = uint32_t(greenIndices&7);
+			}
+
+			// Reconstructs normal z for one row of block, z is clamped to zero outside of unit circle.
+			const simd128_t vx  = simd_ld(nx[ri[0] ], nx[ri[1] ], nx[ri[2] ], nx[ri[3] ]);
+			const simd128_t vy  = simd_ld(ny[gi[0] ], ny[gi[1] ], ny[gi[2] ], ny[gi[3] ]);
+			const simd128_t vxx = simd_mul(vx, vx);
+			const simd128_t vyy = simd_mul(vy, vy);
+			const simd128_t vzz = simd_sub(simd_sub(one, vxx), vyy);
+			const simd128_t vz  = simd_sqrt(simd_max(vzz, zero) );
+			const simd128_t vb  = simd_mul(simd_mul(simd_add(vz, one), unorm), half);
+
+			BX_ALIGN_DECL_16(float) bb[4];
+			simd_st(bb, vb);
+
+			uint32_t* dst = (uint32_t*)&_dst[yy*_dstPitch];
+			for (uint32_t xx = 0; xx < 4; ++xx)
+			{
+				dst[xx] = uint8_t(bb[xx]) | (uint32_t(green[gi[xx] ]) << 8) | (uint32_t(red[ri[xx] ]) << 16);
+			}
 		}
 	}
 
@@ -2599,6 +3013,11 @@ namespace bimg
 			colors[ 6] = colors[10] - colors[14] / 4;
 		}
 
+		colors[ 3] = 255;
+		colors[ 7] = 255;
+		colors[11] = 255;
+		colors[15] = 255;
+
 		for (uint32_t ii = 0, next = 8*4; ii < 16*4; ii += 4, next += 2)
 		{
 			int32_t idx = ( (_src[next>>3] >> (next & 7) ) & 3) * 4;
@@ -4527,6 +4946,30 @@ namespace bimg
 		return imageParse(_imageContainer, &reader, _err);
 	}
 
+	ImageContainer* imageParseRef(bx::AllocatorI* _allocator, const void* _src, uint32_t _size, bx::Error* _err)
+	{
+		BX_ERROR_SCOPE(_err);
+
+		ImageContainer imageContainer;
+		if (!imageParse(imageContainer, _src, _size, _err) )
+		{
+			return NULL;
+		}
+
+		ImageContainer* output = (ImageContainer*)bx::alignedAlloc(_allocator, sizeof(ImageContainer), 16);
+		bx::memCopy(output, &imageContainer, sizeof(ImageContainer) );
+
+		output->m_allocator = _allocator;
+
+		if (UINT32_MAX != imageContainer.m_offset)
+		{
+			output->m_data = const_cast<void*>(_src);
+			output->m_size = _size;
+		}
+
+		return output;
+	}
+
 	void imageDecodeToR8(bx::AllocatorI* _allocator, void* _dst, const void* _src, uint32_t _width, uint32_t _height, uint32_t _depth, uint32_t _dstPitch, TextureFormat::Enum _srcFormat)
 	{
 		const uint8_t* src = (const uint8_t*)_src;
@@ -4552,35 +4995,179 @@ namespace bimg
 		}
 	}
 
-	void imageDecodeToBgra8(bx::AllocatorI* _allocator, void* _dst, const void* _src, uint32_t _width, uint32_t _height, uint32_t _dstPitch, TextureFormat::Enum _srcFormat)
+	struct DecodeBlockRows
 	{
-		const uint8_t* src = (const uint8_t*)_src;
-		uint8_t* dst = (uint8_t*)_dst;
+		const uint8_t* src;
+		uint8_t* dst;
+		uint32_t width;
+		uint32_t height;
+		uint32_t srcPitch;
+		uint32_t dstPitch;
+		TextureFormat::Enum format;
+	};
 
-		uint32_t width  = _width/4;
-		uint32_t height = _height/4;
+	// Decodes one row of 4x4 blocks, rows are independent and can be decoded in parallel.
+	static void decodeBlockRowBgra8(void* _userData, uint32_t _index)
+	{
+		const DecodeBlockRows& rows = *(const DecodeBlockRows*)_userData;
+
+		const uint32_t blockSize = s_imageBlockInfo[rows.format].blockSize;
+		const uint32_t dstPitch  = rows.dstPitch;
+
+		const uint8_t* src = &rows.src[_index*rows.srcPitch];
+		uint8_t* dst = &rows.dst[_index*dstPitch*4];
 
 		uint8_t temp[16*4];
 
-		switch (_srcFormat)
+		for (uint32_t xx = 0; xx < rows.width; ++xx, src += blockSize, dst += 16)
 		{
-		case TextureFormat::BC1:
-			if (BX_ENABLED(BIMG_CONFIG_DECODE_BC1) )
+			switch (rows.format)
 			{
-				for (uint32_t yy = 0; yy < height; ++yy)
+			case TextureFormat::BC1:
+				decodeBlockBc1Bgra8(dst, dstPitch, src);
+				continue;
+
+			case TextureFormat::BC3:
+				decodeBlockBc3Bgra8(dst, dstPitch, src);
+				continue;
+
+			case TextureFormat::BC4:
+				decodeBlockBc4Bgra8(dst, dstPitch, src);
+				continue;
+
+			case TextureFormat::BC5:
+				decodeBlockBc5Bgra8(dst, dstPitch, src);
+				continue;
+
+			case TextureFormat::BC2:
+				decodeBlockDxt23A(temp+3, src);
+				decodeBlockDxt(temp, src+8);
+				break;
+
+			case TextureFormat::BC7:
+				decodeBlockBc7(temp, src);
+				break;
+
+			case TextureFormat::ETC1:
+			case TextureFormat::ETC2:
+				decodeBlockEtc12(temp, src);
+				break;
+
+			case TextureFormat::ETC2A:
+				decodeBlockEtc12(temp, src+8);
+				decodeBlockEtc2Alpha(temp, src);
+				break;
+
+			case TextureFormat::PTC14:
+				decodeBlockPtc14(temp, rows.src, xx, _index, rows.width, rows.height);
+				break;
+
+			case TextureFormat::PTC14A:
+				decodeBlockPtc14A(temp, rows.src, xx, _index, rows.width, rows.height);
+				break;
+
+			case TextureFormat::ATC:
+				decodeBlockATC(temp, src);
+				break;
+
+			case TextureFormat::ATCE:
+				decodeBlockATC(temp, src+8);
+				decodeBlockDxt23A(temp+3, src);
+				break;
+
+			case TextureFormat::ATCI:
+				decodeBlockATC(temp, src+8);
+				decodeBlockDxt45A(temp+3, src);
+				break;
+
+			default:
+				BX_ASSERT(false, "Unexpected format %d.", rows.format);
+				return;
+			}
+
+			bx::memCopy(&dst[0*dstPitch], &temp[ 0], 16);
+			bx::memCopy(&dst[1*dstPitch], &temp[16], 16);
+			bx::memCopy(&dst[2*dstPitch], &temp[32], 16);
+			bx::memCopy(&dst[3*dstPitch], &temp[48], 16);
+		}
+	}
+
+	static void decodeBlockRowRgba32f(void* _userData, uint32_t _index)
+	{
+		const DecodeBlockRows& rows = *(const DecodeBlockRows*)_userData;
+
+		const uint32_t blockSize = s_imageBlockInfo[rows.format].blockSize;
+		const uint32_t dstPitch  = rows.dstPitch;
+
+		const uint8_t* src = &rows.src[_index*rows.srcPitch];
+		uint8_t* dst = &rows.dst[_index*dstPitch*4];
+
+		float tmp[16*4];
+
+		for (uint32_t xx = 0; xx < rows.width; ++xx, src += blockSize, dst += 64)
+		{
+			switch (rows.format)
+			{
+			case TextureFormat::BC5:
 				{
-					for (uint32_t xx = 0; xx < width; ++xx)
+					uint8_t temp[16*4];
+					decodeBlockDxt45A(temp+2, src);
+					decodeBlockDxt45A(temp+1, src+8);
+
+					for (uint32_t ii = 0; ii < 16; ++ii)
 					{
-						decodeBlockDxt1(temp, src);
-						src += 8;
-
-						uint8_t* block = &dst[yy*_dstPitch*4 + xx*16];
-						bx::memCopy(&block[0*_dstPitch], &temp[ 0], 16);
-						bx::memCopy(&block[1*_dstPitch], &temp[16], 16);
-						bx::memCopy(&block[2*_dstPitch], &temp[32], 16);
-						bx::memCopy(&block[3*_dstPitch], &temp[48], 16);
+						float nx = temp[ii*4+2]*2.0f/255.0f - 1.0f;
+						float ny = temp[ii*4+1]*2.0f/255.0f - 1.0f;
+
+						// Same as BGRA8 path, z is clamped to zero outside of unit circle.
+						float nz = bx::sqrt(bx::max(1.0f - nx*nx - ny*ny, 0.0f) );
+
+						tmp[ii*4+0] = nx;
+						tmp[ii*4+1] = ny;
+						tmp[ii*4+2] = nz;
+						tmp[ii*4+3] = 0.0f;
 					}
 				}
+				break;
+
+			case TextureFormat::BC6H:
+				decodeBlockBc6h(tmp, src);
+				break;
+
+			default:
+				BX_ASSERT(false, "Unexpected format %d.", rows.format);
+				return;
+			}
+
+			bx::memCopy(&dst[0*dstPitch], &tmp[ 0], 64);
+			bx::memCopy(&dst[1*dstPitch], &tmp[16], 64);
+			bx::memCopy(&dst[2*dstPitch], &tmp[32], 64);
+			bx::memCopy(&dst[3*dstPitch], &tmp[48], 64);
+		}
+	}
+
+	static void imageDecodeBlocks(JobFn _fn, void* _dst, uint32_t _dstPitch, const void* _src, uint32_t _width, uint32_t _height, TextureFormat::Enum _srcFormat)
+	{
+		DecodeBlockRows rows;
+		rows.src      = (const uint8_t*)_src;
+		rows.dst      = (uint8_t*)_dst;
+		rows.width    = _width/4;
+		rows.height   = _height/4;
+		rows.srcPitch = rows.width*s_imageBlockInfo[_srcFormat].blockSize;
+		rows.dstPitch = _dstPitch;
+		rows.format   = _srcFormat;
+
+		parallelFor(_fn, &rows, rows.height);
+	}
+
+	void imageDecodeToBgra8(bx::AllocatorI* _allocator, void* _dst, const void* _src, uint32_t _width, uint32_t _height, uint32_t _dstPitch, TextureFormat::Enum _srcFormat)
+	{
+		switch (_srcFormat)
+		{
+		case TextureFormat::BC1:
+			if (BX_ENABLED(BIMG_CONFIG_DECODE_BC1) )
+			{
+				imageDecodeBlocks(decodeBlockRowBgra8, _dst, _dstPitch, _src, _width, _height, _srcFormat);
 			}
 			else
 			{
@@ -4592,22 +5179,7 @@ namespace bimg
 		case TextureFormat::BC2:
 			if (BX_ENABLED(BIMG_CONFIG_DECODE_BC2) )
 			{
-				for (uint32_t yy = 0; yy < height; ++yy)
-				{
-					for (uint32_t xx = 0; xx < width; ++xx)
-					{
-						decodeBlockDxt23A(temp+3, src);
-						src += 8;
-						decodeBlockDxt(temp, src);
-						src += 8;
-
-						uint8_t* block = &dst[yy*_dstPitch*4 + xx*16];
-						bx::memCopy(&block[0*_dstPitch], &temp[ 0], 16);
-						bx::memCopy(&block[1*_dstPitch], &temp[16], 16);
-						bx::memCopy(&block[2*_dstPitch], &temp[32], 16);
-						bx::memCopy(&block[3*_dstPitch], &temp[48], 16);
-					}
-				}
+				imageDecodeBlocks(decodeBlockRowBgra8, _dst, _dstPitch, _src, _width, _height, _srcFormat);
 			}
 			else
 			{
@@ -4619,22 +5191,7 @@ namespace bimg
 		case TextureFormat::BC3:
 			if (BX_ENABLED(BIMG_CONFIG_DECODE_BC3) )
 			{
-				for (uint32_t yy = 0; yy < height; ++yy)
-				{
-					for (uint32_t xx = 0; xx < width; ++xx)
-					{
-						decodeBlockDxt45A(temp+3, src);
-						src += 8;
-						decodeBlockDxt(temp, src);
-						src += 8;
-
-						uint8_t* block = &dst[yy*_dstPitch*4 + xx*16];
-						bx::memCopy(&block[0*_dstPitch], &temp[ 0], 16);
-						bx::memCopy(&block[1*_dstPitch], &temp[16], 16);
-						bx::memCopy(&block[2*_dstPitch], &temp[32], 16);
-						bx::memCopy(&block[3*_dstPitch], &temp[48], 16);
-					}
-				}
+				imageDecodeBlocks(decodeBlockRowBgra8, _dst, _dstPitch, _src, _width, _height, _srcFormat);
 			}
 			else
 			{
@@ -4646,20 +5203,7 @@ namespace bimg
 		case TextureFormat::BC4:
 			if (BX_ENABLED(BIMG_CONFIG_DECODE_BC4) )
 			{
-				for (uint32_t yy = 0; yy < height; ++yy)
-				{
-					for (uint32_t xx = 0; xx < width; ++xx)
-					{
-						decodeBlockDxt45A(temp, src);
-						src += 8;
-
-						uint8_t* block = &dst[yy*_dstPitch*4 + xx*16];
-						bx::memCopy(&block[0*_dstPitch], &temp[ 0], 16);
-						bx::memCopy(&block[1*_dstPitch], &temp[16], 16);
-						bx::memCopy(&block[2*_dstPitch], &temp[32], 16);
-						bx::memCopy(&block[3*_dstPitch], &temp[48], 16);
-					}
-				}
+				imageDecodeBlocks(decodeBlockRowBgra8, _dst, _dstPitch, _src, _width, _height, _srcFormat);
 			}
 			else
 			{
@@ -4671,31 +5215,7 @@ namespace bimg
 		case TextureFormat::BC5:
 			if (BX_ENABLED(BIMG_CONFIG_DECODE_BC5) )
 			{
-				for (uint32_t yy = 0; yy < height; ++yy)
-				{
-					for (uint32_t xx = 0; xx < width; ++xx)
-					{
-						decodeBlockDxt45A(temp+2, src);
-						src += 8;
-						decodeBlockDxt45A(temp+1, src);
-						src += 8;
-
-						for (uint32_t ii = 0; ii < 16; ++ii)
-						{
-							float nx = temp[ii*4+2]*2.0f/255.0f - 1.0f;
-							float ny = temp[ii*4+1]*2.0f/255.0f - 1.0f;
-							float nz = bx::sqrt(1.0f - nx*nx - ny*ny);
-							temp[ii*4+0] = uint8_t( (nz + 1.0f)*255.0f/2.0f);
-							temp[ii*4+3] = 0;
-						}
-
-						uint8_t* block = &dst[yy*_dstPitch*4 + xx*16];
-						bx::memCopy(&block[0*_dstPitch], &temp[ 0], 16);
-						bx::memCopy(&block[1*_dstPitch], &temp[16], 16);
-						bx::memCopy(&block[2*_dstPitch], &temp[32], 16);
-						bx::memCopy(&block[3*_dstPitch], &temp[48], 16);
-					}
-				}
+				imageDecodeBlocks(decodeBlockRowBgra8, _dst, _dstPitch, _src, _width, _height, _srcFormat);
 			}
 			else
 			{
@@ -4730,20 +5250,7 @@ namespace bimg
 		case TextureFormat::BC7:
 			if (BX_ENABLED(BIMG_CONFIG_DECODE_BC7) )
 			{
-				for (uint32_t yy = 0; yy < height; ++yy)
-				{
-					for (uint32_t xx = 0; xx < width; ++xx)
-					{
-						decodeBlockBc7(temp, src);
-						src += 16;
-
-						uint8_t* block = &dst[yy*_dstPitch*4 + xx*16];
-						bx::memCopy(&block[0*_dstPitch], &temp[ 0], 16);
-						bx::memCopy(&block[1*_dstPitch], &temp[16], 16);
-						bx::memCopy(&block[2*_dstPitch], &temp[32], 16);
-						bx::memCopy(&block[3*_dstPitch], &temp[48], 16);
-					}
-				}
+				imageDecodeBlocks(decodeBlockRowBgra8, _dst, _dstPitch, _src, _width, _height, _srcFormat);
 			}
 			else
 			{
@@ -4756,20 +5263,7 @@ namespace bimg
 		case TextureFormat::ETC2:
 			if (BX_ENABLED(BIMG_CONFIG_DECODE_ETC1 || BIMG_CONFIG_DECODE_ETC2) )
 			{
-				for (uint32_t yy = 0; yy < height; ++yy)
-				{
-					for (uint32_t xx = 0; xx < width; ++xx)
-					{
-						decodeBlockEtc12(temp, src);
-						src += 8;
-
-						uint8_t* block = &dst[yy*_dstPitch*4 + xx*16];
-						bx::memCopy(&block[0*_dstPitch], &temp[ 0], 16);
-						bx::memCopy(&block[1*_dstPitch], &temp[16], 16);
-						bx::memCopy(&block[2*_dstPitch], &temp[32], 16);
-						bx::memCopy(&block[3*_dstPitch], &temp[48], 16);
-					}
-				}
+				imageDecodeBlocks(decodeBlockRowBgra8, _dst, _dstPitch, _src, _width, _height, _srcFormat);
 			}
 			else
 			{
@@ -4779,29 +5273,14 @@ namespace bimg
 			break;
 
 		case TextureFormat::ETC2A:
-			if (BX_ENABLED(BIMG_CONFIG_DECODE_ETC2))
+			if (BX_ENABLED(BIMG_CONFIG_DECODE_ETC2) )
 			{
-				for (uint32_t yy = 0; yy < height; ++yy)
-				{
-					for (uint32_t xx = 0; xx < width; ++xx)
-					{
-						decodeBlockEtc12(temp, src + 8);
-						decodeBlockEtc2Alpha(temp, src);
-
-						src += 16;
-
-						uint8_t* block = &dst[yy*_dstPitch * 4 + xx * 16];
-						bx::memCopy(&block[0 * _dstPitch], &temp[0], 16);
-						bx::memCopy(&block[1 * _dstPitch], &temp[16], 16);
-						bx::memCopy(&block[2 * _dstPitch], &temp[32], 16);
-						bx::memCopy(&block[3 * _dstPitch], &temp[48], 16);
-					}
-				}
+				imageDecodeBlocks(decodeBlockRowBgra8, _dst, _dstPitch, _src, _width, _height, _srcFormat);
 			}
 			else
 			{
 				BX_WARN(false, "ETC2 decoder is disabled (BIMG_CONFIG_DECODE_ETC2).");
-				imageCheckerboard(_dst, _width, _height, 16, UINT32_C(0xff000000), UINT32_C(0xff00ff00));
+				imageCheckerboard(_dst, _width, _height, 16, UINT32_C(0xff000000), UINT32_C(0xff00ff00) );
 			}
 			break;
 
@@ -4821,35 +5300,8 @@ namespace bimg
 			break;
 
 		case TextureFormat::PTC14:
-			for (uint32_t yy = 0; yy < height; ++yy)
-			{
-				for (uint32_t xx = 0; xx < width; ++xx)
-				{
-					decodeBlockPtc14(temp, src, xx, yy, width, height);
-
-					uint8_t* block = &dst[yy*_dstPitch*4 + xx*16];
-					bx::memCopy(&block[0*_dstPitch], &temp[ 0], 16);
-					bx::memCopy(&block[1*_dstPitch], &temp[16], 16);
-					bx::memCopy(&block[2*_dstPitch], &temp[32], 16);
-					bx::memCopy(&block[3*_dstPitch], &temp[48], 16);
-				}
-			}
-			break;
-
 		case TextureFormat::PTC14A:
-			for (uint32_t yy = 0; yy < height; ++yy)
-			{
-				for (uint32_t xx = 0; xx < width; ++xx)
-				{
-					decodeBlockPtc14A(temp, src, xx, yy, width, height);
-
-					uint8_t* block = &dst[yy*_dstPitch*4 + xx*16];
-					bx::memCopy(&block[0*_dstPitch], &temp[ 0], 16);
-					bx::memCopy(&block[1*_dstPitch], &temp[16], 16);
-					bx::memCopy(&block[2*_dstPitch], &temp[32], 16);
-					bx::memCopy(&block[3*_dstPitch], &temp[48], 16);
-				}
-			}
+			imageDecodeBlocks(decodeBlockRowBgra8, _dst, _dstPitch, _src, _width, _height, _srcFormat);
 			break;
 
 		case TextureFormat::PTC22:
@@ -4863,58 +5315,9 @@ namespace bimg
 			break;
 
 		case TextureFormat::ATC:
-			for (uint32_t yy = 0; yy < height; ++yy)
-			{
-				for (uint32_t xx = 0; xx < width; ++xx)
-				{
-					decodeBlockATC(temp, src);
-					src += 8;
-
-					uint8_t* block = &dst[(yy*_dstPitch+xx*4)*4];
-					bx::memCopy(&block[0*_dstPitch], &temp[ 0], 16);
-					bx::memCopy(&block[1*_dstPitch], &temp[16], 16);
-					bx::memCopy(&block[2*_dstPitch], &temp[32], 16);
-					bx::memCopy(&block[3*_dstPitch], &temp[48], 16);
-				}
-			}
-			break;
-
 		case TextureFormat::ATCE:
-			for (uint32_t yy = 0; yy < height; ++yy)
-			{
-				for (uint32_t xx = 0; xx < width; ++xx)
-				{
-					decodeBlockDxt23A(temp+3, src);
-					src += 8;
-					decodeBlockATC(temp, src);
-					src += 8;
-
-					uint8_t* block = &dst[(yy*_dstPitch+xx*4)*4];
-					bx::memCopy(&block[0*_dstPitch], &temp[ 0], 16);
-					bx::memCopy(&block[1*_dstPitch], &temp[16], 16);
-					bx::memCopy(&block[2*_dstPitch], &temp[32], 16);
-					bx::memCopy(&block[3*_dstPitch], &temp[48], 16);
-				}
-			}
-			break;
-
 		case TextureFormat::ATCI:
-			for (uint32_t yy = 0; yy < height; ++yy)
-			{
-				for (uint32_t xx = 0; xx < width; ++xx)
-				{
-					decodeBlockDxt45A(temp+3, src);
-					src += 8;
-					decodeBlockATC(temp, src);
-					src += 8;
-
-					uint8_t* block = &dst[(yy*_dstPitch+xx*4)*4];
-					bx::memCopy(&block[0*_dstPitch], &temp[ 0], 16);
-					bx::memCopy(&block[1*_dstPitch], &temp[16], 16);
-					bx::memCopy(&block[2*_dstPitch], &temp[32], 16);
-					bx::memCopy(&block[3*_dstPitch], &temp[48], 16);
-				}
-			}
+			imageDecodeBlocks(decodeBlockRowBgra8, _dst, _dstPitch, _src, _width, _height, _srcFormat);
 			break;
 
 		case TextureFormat::ASTC4x4:
@@ -4964,6 +5367,29 @@ namespace bimg
 		}
 	}
 
+	struct DecodeAstc
+	{
+		astcenc_context* context;
+		const uint8_t* src;
+		size_t srcSize;
+		astcenc_image* image;
+		const astcenc_swizzle* swizzle;
+		volatile uint32_t numErrors;
+	};
+
+	static void decodeAstc(void* _userData, uint32_t _index)
+	{
+		DecodeAstc& astc = *(DecodeAstc*)_userData;
+
+		const astcenc_error status = astcenc_decompress_image(astc.context, astc.src, astc.srcSize, astc.image, astc.swizzle, _index);
+
+		if (status != ASTCENC_SUCCESS)
+		{
+			BX_TRACE("astc error in decompress image %s", astcenc_get_error_string(status) );
+			bx::atomicFetchAndAdd<uint32_t>(&astc.numErrors, 1);
+		}
+	}
+
 	void imageDecodeToRgba8(bx::AllocatorI* _allocator, void* _dst, const void* _src, uint32_t _width, uint32_t _height, uint32_t _dstPitch, TextureFormat::Enum _srcFormat)
 	{
 		switch (_srcFormat)
@@ -5020,8 +5446,10 @@ namespace bimg
 						break;
 					}
 
+					const uint32_t numThreads = getConcurrency();
+
 					astcenc_context* context;
-					status = astcenc_context_alloc(&config, 1, &context);
+					status = astcenc_context_alloc(&config, numThreads, &context);
 
 					if (status != ASTCENC_SUCCESS)
 					{
@@ -5048,18 +5476,18 @@ namespace bimg
 						ASTCENC_SWZ_A,
 					};
 
-					status = astcenc_decompress_image(
-						  context
-						, (const uint8_t*)_src
-						, size
-						, &image
-						, &swizzle
-						, 0
-						);
+					DecodeAstc astc;
+					astc.context   = context;
+					astc.src       = (const uint8_t*)_src;
+					astc.srcSize   = size;
+					astc.image     = &image;
+					astc.swizzle   = &swizzle;
+					astc.numErrors = 0;
 
-					if (status != ASTCENC_SUCCESS)
+					parallelFor(decodeAstc, &astc, numThreads);
+
+					if (0 != astc.numErrors)
 					{
-						BX_TRACE("astc error in compress image %s", astcenc_get_error_string(status));
 						imageCheckerboard(_dst, _width, _height, 16, UINT32_C(0xff000000), UINT32_C(0xffffff00) );
 
 						astcenc_context_free(context);
@@ -5162,64 +5590,12 @@ namespace bimg
 			switch (_srcFormat)
 			{
 			case TextureFormat::BC5:
-				{
-					uint32_t width  = _width/4;
-					uint32_t height = _height/4;
-
-					const uint8_t* srcData = src;
-
-					for (uint32_t yy = 0; yy < height; ++yy)
-					{
-						for (uint32_t xx = 0; xx < width; ++xx)
-						{
-							uint8_t temp[16*4];
-
-							decodeBlockDxt45A(temp+2, srcData);
-							srcData += 8;
-							decodeBlockDxt45A(temp+1, srcData);
-							srcData += 8;
-
-							for (uint32_t ii = 0; ii < 16; ++ii)
-							{
-								float nx = temp[ii*4+2]*2.0f/255.0f - 1.0f;
-								float ny = temp[ii*4+1]*2.0f/255.0f - 1.0f;
-								float nz = bx::sqrt(1.0f - nx*nx - ny*ny);
-
-								const uint32_t offset = (yy*4 + ii/4)*_width*16 + (xx*4 + ii%4)*16;
-								float* block = (float*)&dst[offset];
-								block[0] = nx;
-								block[1] = ny;
-								block[2] = nz;
-								block[3] = 0.0f;
-							}
-						}
-					}
-				}
+				// BC5 rows are written with pitch of tightly packed RGBA32F image.
+				imageDecodeBlocks(decodeBlockRowRgba32f, dst, _width*16, src, _width, _height, _srcFormat);
 				break;
 
 			case TextureFormat::BC6H:
-				{
-					uint32_t width  = _width/4;
-					uint32_t height = _height/4;
-
-					const uint8_t* srcData = src;
-
-					for (uint32_t yy = 0; yy < height; ++yy)
-					{
-						for (uint32_t xx = 0; xx < width; ++xx)
-						{
-							float tmp[16*4];
-							decodeBlockBc6h(tmp, srcData);
-							srcData += 16;
-
-							uint8_t* block = (uint8_t*)&dst[yy*_dstPitch*4 + xx*64];
-							bx::memCopy(&block[0*_dstPitch], &tmp[ 0], 64);
-							bx::memCopy(&block[1*_dstPitch], &tmp[16], 64);
-							bx::memCopy(&block[2*_dstPitch], &tmp[32], 64);
-							bx::memCopy(&block[3*_dstPitch], &tmp[48], 64);
-						}
-					}
-				}
+				imageDecodeBlocks(decodeBlockRowRgba32f, dst, _dstPitch, src, _width, _height, _srcFormat);
 				break;
 
 			case TextureFormat::RGBA32F:
@@ -5244,9 +5620,11 @@ namespace bimg
 		}
 	}
 
-	bool imageGetRawData(const ImageContainer& _imageContainer, uint16_t _side, uint8_t _lod, const void* _data, uint32_t _size, ImageMip& _mip)
+	// Finds mip offset within image data. Image data is accessed only to validate KTX image sizes,
+	// and _data can be NULL when only offset is needed, in which case mip data pointer is NULL.
+	static bool imageGetRawDataOffset(const ImageContainer& _imageContainer, uint16_t _side, uint8_t _lod, const uint8_t* _data, uint32_t _size, uint32_t& _offset, ImageMip& _mip)
 	{
-		uint32_t offset = _imageContainer.m_offset;
+		uint32_t offset = _offset;
 		TextureFormat::Enum format = TextureFormat::Enum(_imageContainer.m_format);
 		bool hasAlpha = _imageContainer.m_hasAlpha;
 
@@ -5258,19 +5636,7 @@ namespace bimg
 		const uint32_t minBlockX   = blockInfo.minBlockX;
 		const uint32_t minBlockY   = blockInfo.minBlockY;
 
-		if (UINT32_MAX == _imageContainer.m_offset)
-		{
-			if (NULL == _imageContainer.m_data)
-			{
-				return false;
-			}
-
-			offset = 0;
-			_data = _imageContainer.m_data;
-			_size = _imageContainer.m_size;
-		}
-
-		const uint8_t* data = (const uint8_t*)_data;
+		const uint8_t* data = _data;
 		const uint16_t numSides = _imageContainer.m_numLayers * (_imageContainer.m_cubeMap ? 6 : 1);
 
 		if (_imageContainer.m_ktx || _imageContainer.m_pvr3)
@@ -5289,10 +5655,13 @@ namespace bimg
 
 				if (_imageContainer.m_ktx)
 				{
-					const uint32_t size = _imageContainer.m_numLayers == 1 && _imageContainer.m_cubeMap ? mipSize : mipSize * numSides;
-					uint32_t imageSize  = bx::toHostEndian(*(const uint32_t*)&data[offset], _imageContainer.m_ktxLE);
-					BX_ASSERT(size == imageSize, "KTX: Image size mismatch %d (expected %d).", size, imageSize);
-					BX_UNUSED(size, imageSize);
+					if (NULL != data)
+					{
+						const uint32_t size = _imageContainer.m_numLayers == 1 && _imageContainer.m_cubeMap ? mipSize : mipSize * numSides;
+						uint32_t imageSize  = bx::toHostEndian(*(const uint32_t*)&data[offset], _imageContainer.m_ktxLE);
+						BX_ASSERT(size == imageSize, "KTX: Image size mismatch %d (expected %d).", size, imageSize);
+						BX_UNUSED(size, imageSize);
+					}
 
 					offset += sizeof(uint32_t);
 				}
@@ -5309,10 +5678,12 @@ namespace bimg
 						_mip.m_depth     = depth;
 						_mip.m_blockSize = blockSize;
 						_mip.m_size      = mipSize;
-						_mip.m_data      = &data[offset];
+						_mip.m_data      = NULL == data ? NULL : &data[offset];
 						_mip.m_bpp       = bpp;
 						_mip.m_format    = format;
 						_mip.m_hasAlpha  = hasAlpha;
+
+						_offset = offset;
 						return true;
 					}
 
@@ -5352,10 +5723,12 @@ namespace bimg
 						_mip.m_depth     = depth;
 						_mip.m_blockSize = blockSize;
 						_mip.m_size      = mipSize;
-						_mip.m_data      = &data[offset];
+						_mip.m_data      = NULL == data ? NULL : &data[offset];
 						_mip.m_bpp       = bpp;
 						_mip.m_format    = format;
 						_mip.m_hasAlpha  = hasAlpha;
+
+						_offset = offset;
 						return true;
 					}
 
@@ -5373,6 +5746,62 @@ namespace bimg
 		return false;
 	}
 
+	bool imageGetRawData(const ImageContainer& _imageContainer, uint16_t _side, uint8_t _lod, const void* _data, uint32_t _size, ImageMip& _mip)
+	{
+		uint32_t offset = _imageContainer.m_offset;
+
+		if (UINT32_MAX == _imageContainer.m_offset)
+		{
+			if (NULL == _imageContainer.m_data)
+			{
+				return false;
+			}
+
+			offset = 0;
+			_data = _imageContainer.m_data;
+			_size = _imageContainer.m_size;
+		}
+
+		return imageGetRawDataOffset(_imageContainer, _side, _lod, (const uint8_t*)_data, _size, offset, _mip);
+	}
+
+	bool imageReadRawData(const ImageContainer& _imageContainer, uint16_t _side, uint8_t _lod, bx::ReaderSeekerI* _reader, void* _dst, uint32_t _dstSize, ImageMip& _mip, bx::Error* _err)
+	{
+		BX_ERROR_SCOPE(_err);
+
+		if (UINT32_MAX == _imageContainer.m_offset)
+		{
+			BX_ERROR_SET(_err, BIMG_ERROR, "Image container doesn't reference mip data in stream.");
+			return false;
+		}
+
+		uint32_t offset = _imageContainer.m_offset;
+
+		if (!imageGetRawDataOffset(_imageContainer, _side, _lod, NULL, UINT32_MAX, offset, _mip) )
+		{
+			BX_ERROR_SET(_err, BIMG_ERROR, "Invalid side or lod.");
+			return false;
+		}
+
+		if (_dstSize < _mip.m_size)
+		{
+			BX_ERROR_SET(_err, BIMG_ERROR, "Destination buffer is too small.");
+			return false;
+		}
+
+		bx::seek(_reader, offset, bx::Whence::Begin);
+		bx::read(_reader, _dst, int32_t(_mip.m_size), _err);
+
+		if (!_err->isOk() )
+		{
+			return false;
+		}
+
+		_mip.m_data = (const uint8_t*)_dst;
+
+		return true;
+	}
+
 	int32_t imageWriteTga(bx::WriterI* _writer, uint32_t _width, uint32_t _height, uint32_t _srcPitch, const void* _src, bool _grayscale, bool _yflip, bx::Error* _err)
 	{
 		BX_ERROR_SCOPE(_err);
@@ -1126,6 +1126,78 @@ namespace bimg
 		return _specularPower;
 	}
 
+	struct RadianceFilterLod
+	{
+		ImageContainer* nsa;
+		uint32_t firstRow;
+		uint32_t width;
+		float roughness;
+		float specularPower;
+		float cosAngle;
+		float texelSize;
+		float filterSize;
+	};
+
+	struct RadianceFilter
+	{
+		const ImageContainer* input;
+		const ImageContainer* output;
+		LightingModel::Enum lightingModel;
+		uint8_t numMips;
+		RadianceFilterLod lod[16];
+	};
+
+	// Filters one row of one side of one mip. Every output texel depends only on input, so rows
+	// can be filtered in any order, on any thread, and result is the same.
+	static void radianceFilterRow(void* _userData, uint32_t _index)
+	{
+		const RadianceFilter& filter = *(const RadianceFilter*)_userData;
+
+		uint8_t lod = 1;
+		while (lod+1 < filter.numMips
+		&&     _index >= filter.lod[lod+1].firstRow)
+		{
+			++lod;
+		}
+
+		const RadianceFilterLod& params = filter.lod[lod];
+		const uint32_t row  = _index - params.firstRow;
+		const uint8_t  side = uint8_t(row / params.width);
+		const uint32_t yy   = row % params.width;
+
+		ImageMip mip;
+		imageGetRawData(*filter.output, side, lod, filter.output->m_data, filter.output->m_size, mip);
+
+		const uint32_t dstWidth  = mip.m_width;
+		const uint32_t dstPitch  = dstWidth*16;
+		const float    texelSize = params.texelSize;
+
+		for (uint32_t xx = 0; xx < dstWidth; ++xx)
+		{
+			float* dstData = (float*)&mip.m_data[yy*dstPitch+xx*16];
+
+			const float uu = float(xx)*texelSize*2.0f - 1.0f;
+			const float vv = float(yy)*texelSize*2.0f - 1.0f;
+
+			bx::Vec3 dir = texelUvToDir(side, uu, vv);
+
+			if (LightingModel::Ggx == filter.lightingModel)
+			{
+				processFilterAreaGgx(dstData, *filter.input, lod, dir, params.roughness);
+			}
+			else
+			{
+				Aabb aabb[6];
+				calcFilterArea(aabb, dir, params.filterSize);
+
+				processFilterArea(dstData, *filter.input, *params.nsa, lod, aabb, dir, params.specularPower, params.cosAngle);
+			}
+
+			// Filters write only color, alpha of output allocation would be left uninitialized.
+			dstData[3] = 1.0f;
+		}
+	}
+
 	ImageContainer* imageCubemapRadianceFilter(bx::AllocatorI* _allocator, const ImageContainer& _image, LightingModel::Enum _lightingModel, bx::Error* _err)
 	{
 		if (!_image.m_cubeMap)
@@ -1161,67 +1233,64 @@ namespace bimg
 		const float glossScale = 10.0f;
 		const float glossBias  = 1.0f;
 
-		for (uint8_t lod = 1, numMips = input->m_numMips; lod < numMips; ++lod)
+		RadianceFilter filter;
+		filter.input         = input;
+		filter.output        = output;
+		filter.lightingModel = _lightingModel;
+		filter.numMips       = bx::min<uint8_t>(input->m_numMips, BX_COUNTOF(filter.lod) );
+
+		// Per mip parameters and normal solid angle tables are computed once upfront, and shared by
+		// all rows of all sides of that mip.
+		uint32_t numRows = 0;
+
+		for (uint8_t lod = 1, numMips = filter.numMips; lod < numMips; ++lod)
 		{
-			ImageContainer* nsa = NULL;
+			RadianceFilterLod& params = filter.lod[lod];
+
+			params.nsa = NULL;
 
 			if (LightingModel::Ggx != _lightingModel)
 			{
-				nsa = imageCubemapNormalSolidAngle(_allocator, bx::max<uint32_t>(_image.m_width>>lod, 1) );
+				params.nsa = imageCubemapNormalSolidAngle(_allocator, bx::max<uint32_t>(_image.m_width>>lod, 1) );
 			}
 
-			for (uint8_t side = 0; side < 6; ++side)
-			{
-				ImageMip mip;
-				imageGetRawData(*output, side, lod, output->m_data, output->m_size, mip);
-
-				const uint32_t dstWidth = mip.m_width;
-				const uint32_t dstPitch = dstWidth*16;
-
-				const float minAngle = bx::atan2(1.0f, float(dstWidth) );
-				const float maxAngle = bx::kPiHalf;
-				const float toFilterSize     = 1.0f/(minAngle*dstWidth*2.0f);
-				const float glossiness       = glossinessFor(lod, float(numMips) );
-				const float roughness        = 1.0f-glossiness;
-				const float specularPowerRef = bx::pow(2.0f, glossiness*glossScale + glossBias);
-				const float specularPower    = applyLightingModel(specularPowerRef, _lightingModel);
-				const float filterAngle      = bx::clamp(cosinePowerFilterAngle(specularPower), minAngle, maxAngle);
-				const float cosAngle   = bx::max(0.0f, bx::cos(filterAngle) );
-				const float texelSize  = 1.0f/float(dstWidth);
-				const float filterSize = bx::max(texelSize, filterAngle * toFilterSize);
-
-				for (uint32_t yy = 0; yy < dstWidth; ++yy)
-				{
-					for (uint32_t xx = 0; xx < dstWidth; ++xx)
-					{
-						float* dstData = (float*)&mip.m_data[yy*dstPitch+xx*16];
-
-						const float uu = float(xx)*texelSize*2.0f - 1.0f;
-						const float vv = float(yy)*texelSize*2.0f - 1.0f;
-
-						bx::Vec3 dir = texelUvToDir(side, uu, vv);
-
-						if (LightingModel::Ggx == _lightingModel)
-						{
-							processFilterAreaGgx(dstData, *input, lod, dir, roughness);
-						}
-						else
-						{
-							Aabb aabb[6];
-							calcFilterArea(aabb, dir, filterSize);
+			const uint32_t dstWidth = bx::max<uint32_t>(output->m_width>>lod, 1);
+
+			const float minAngle = bx::atan2(1.0f, float(dstWidth) );
+			const float maxAngle = bx::kPiHalf;
+			const float toFilterSize     = 1.0f/(minAngle*dstWidth*2.0f);
+			const float glossiness       = glossinessFor(lod, float(numMips) );
+			const float roughness        = 1.0f-glossiness;
+			const float specularPowerRef = bx::pow(2.0f, glossiness*glossScale + glossBias);
+			const float specularPower    = applyLightingModel(specularPowerRef, _lightingModel);
+			const float filterAngle      = bx::clamp(cosinePowerFilterAngle(specularPower), minAngle, maxAngle);
+			const float cosAngle   = bx::max(0.0f, bx::cos(filterAngle) );
+			const float texelSize  = 1.0f/float(dstWidth);
+			const float filterSize = bx::max(texelSize, filterAngle * toFilterSize);
+
+			params.firstRow      = numRows;
+			params.width         = dstWidth;
+			params.roughness     = roughness;
+			params.specularPower = specularPower;
+			params.cosAngle      = cosAngle;
+			params.texelSize     = texelSize;
+			params.filterSize    = filterSize;
+
+			numRows += 6*dstWidth;
+		}
 
-							processFilterArea(dstData, *input, *nsa, lod, aabb, dir, specularPower, cosAngle);
-						}
-					}
-				}
-			}
+		parallelFor(radianceFilterRow, &filter, numRows);
 
-			if (NULL != nsa)
+		for (uint8_t lod = 1, numMips = filter.numMips; lod < numMips; ++lod)
+		{
+			if (NULL != filter.lod[lod].nsa)
 			{
-				imageFree(nsa);
+				imageFree(filter.lod[lod].nsa);
 			}
 		}
 
+		imageFree(input);
+
 		return output;
 	}
 
@@ -6,6 +6,8 @@
 #include <bimg/encode.h>
 #include "bimg_p.h"
 
+#include <bx/cpu.h>
+
 #include <libsquish/squish.h>
 #include <etc1/etc1.h>
 #include <etc2/ProcessRGB.hpp>
@@ -54,6 +56,98 @@ namespace bimg
 	};
 	static_assert(Quality::Count == BX_COUNTOF(s_astcQuality) );
 
+	struct EncodeBlockRows
+	{
+		const uint8_t* src;
+		uint8_t* dst;
+		uint32_t width;
+		uint32_t height;
+		uint32_t srcPitch;
+		uint32_t dstPitch;
+		TextureFormat::Enum format;
+		Quality::Enum quality;
+	};
+
+	// Block rows are encoded independently, so splitting image into rows produces same output as
+	// encoding whole image at once.
+	static void encodeBlockRow(void* _userData, uint32_t _index)
+	{
+		const EncodeBlockRows& rows = *(const EncodeBlockRows*)_userData;
+
+		const uint32_t yy = _index*4;
+		const uint8_t* src = &rows.src[yy*rows.srcPitch];
+		uint8_t* dst = &rows.dst[_index*rows.dstPitch];
+
+		switch (rows.format)
+		{
+		case TextureFormat::BC1:
+		case TextureFormat::BC2:
+		case TextureFormat::BC3:
+		case TextureFormat::BC4:
+		case TextureFormat::BC5:
+			squish::CompressImage(src, rows.width, bx::min<uint32_t>(rows.height-yy, 4), dst
+				, s_squishQuality[rows.quality]
+				| (rows.format == TextureFormat::BC2 ? squish::kDxt3
+				:  rows.format == TextureFormat::BC3 ? squish::kDxt5
+				:  rows.format == TextureFormat::BC4 ? squish::kBc4
+				:  rows.format == TextureFormat::BC5 ? squish::kBc5
+				:                                      squish::kDxt1)
+				);
+			break;
+
+		case TextureFormat::ETC1:
+			etc1_encode_image(src, rows.width, bx::min<uint32_t>(rows.height-yy, 4), 4, rows.srcPitch, dst);
+			break;
+
+		case TextureFormat::ETC2:
+			{
+				const uint32_t blockWidth = (rows.width+3)/4;
+				uint64_t* dstBlock = (uint64_t*)dst;
+				for (uint32_t xx = 0; xx < blockWidth; ++xx)
+				{
+					uint8_t block[4*4*4];
+					const uint8_t* ptr = &src[xx*16];
+
+					for (uint32_t ii = 0; ii < 16; ++ii)
+					{ // BGRx
+						bx::memCopy(&block[ii*4], &ptr[(ii%4)*rows.srcPitch + (ii&~3)], 4);
+						bx::swap(block[ii*4+0], block[ii*4+2]);
+					}
+
+					*dstBlock++ = ProcessRGB_ETC2(block);
+				}
+			}
+			break;
+
+		default:
+			BX_ASSERT(false, "Format %s can't be encoded by block rows.", getName(rows.format) );
+			break;
+		}
+	}
+
+	struct EncodeAstc
+	{
+		astcenc_context* context;
+		astcenc_image* image;
+		const astcenc_swizzle* swizzle;
+		uint8_t* dst;
+		size_t dstSize;
+		volatile uint32_t numErrors;
+	};
+
+	static void encodeAstc(void* _userData, uint32_t _index)
+	{
+		EncodeAstc& astc = *(EncodeAstc*)_userData;
+
+		const astcenc_error status = astcenc_compress_image(astc.context, astc.image, astc.swizzle, astc.dst, astc.dstSize, _index);
+
+		if (status != ASTCENC_SUCCESS)
+		{
+			BX_TRACE("astc error in compress image %s", astcenc_get_error_string(status) );
+			bx::atomicFetchAndAdd<uint32_t>(&astc.numErrors, 1);
+		}
+	}
+
 	void imageEncodeFromRgba8(bx::AllocatorI* _allocator, void* _dst, const void* _src, uint32_t _width, uint32_t _height, uint32_t _depth, TextureFormat::Enum _format, Quality::Enum _quality, bx::Error* _err)
 	{
 		const uint8_t* src = (const uint8_t*)_src;
@@ -74,49 +168,31 @@ namespace bimg
 			case TextureFormat::BC3:
 			case TextureFormat::BC4:
 			case TextureFormat::BC5:
-				squish::CompressImage(src, _width, _height, dst
-					, s_squishQuality[_quality]
-					| (_format == TextureFormat::BC2 ? squish::kDxt3
-					:  _format == TextureFormat::BC3 ? squish::kDxt5
-					:  _format == TextureFormat::BC4 ? squish::kBc4
-					:  _format == TextureFormat::BC5 ? squish::kBc5
-					:                                  squish::kDxt1)
-					);
-				break;
-
-			case TextureFormat::BC6H:
-			case TextureFormat::BC7:
-				BX_ERROR_SET(_err, BIMG_ERROR, "Unable to convert between input/output formats!");
-				break;
-
 			case TextureFormat::ETC1:
-				etc1_encode_image(src, _width, _height, 4, _width*4, dst);
-				break;
-
 			case TextureFormat::ETC2:
 				{
 					const uint32_t blockWidth  = (_width +3)/4;
 					const uint32_t blockHeight = (_height+3)/4;
-					uint64_t* dstBlock = (uint64_t*)dst;
-					for (uint32_t yy = 0; yy < blockHeight; ++yy)
-					{
-						for (uint32_t xx = 0; xx < blockWidth; ++xx)
-						{
-							uint8_t block[4*4*4];
-							const uint8_t* ptr = &src[(yy*srcPitch+xx*4)*4];
 
-							for (uint32_t ii = 0; ii < 16; ++ii)
-							{ // BGRx
-								bx::memCopy(&block[ii*4], &ptr[(ii%4)*srcPitch + (ii&~3)], 4);
-								bx::swap(block[ii*4+0], block[ii*4+2]);
-							}
-
-							*dstBlock++ = ProcessRGB_ETC2(block);
-						}
-					}
+					EncodeBlockRows rows;
+					rows.src      = src;
+					rows.dst      = dst;
+					rows.width    = _width;
+					rows.height   = _height;
+					rows.srcPitch = srcPitch;
+					rows.dstPitch = blockWidth*getBlockInfo(_format).blockSize;
+					rows.format   = _format;
+					rows.quality  = _quality;
+
+					parallelFor(encodeBlockRow, &rows, blockHeight);
 				}
 				break;
 
+			case TextureFormat::BC6H:
+			case TextureFormat::BC7:
+				BX_ERROR_SET(_err, BIMG_ERROR, "Unable to convert between input/output formats!");
+				break;
+
 			case TextureFormat::PTC14:
 				{
 					using namespace Javelin;
@@ -184,8 +260,10 @@ namespace bimg
 						break;
 					}
 
+					const uint32_t numThreads = getConcurrency();
+
 					astcenc_context* context;
-					status = astcenc_context_alloc(&config, 1, &context);
+					status = astcenc_context_alloc(&config, numThreads, &context);
 
 					if (status != ASTCENC_SUCCESS)
 					{
@@ -205,34 +283,36 @@ namespace bimg
 					const size_t blockCountY = (_height + astcBlockInfo.blockHeight - 1) / astcBlockInfo.blockHeight;
 					const size_t compLen     = blockCountX * blockCountY * 16;
 
-					if (Quality::NormalMapDefault <= _quality)
-					{
-						static const astcenc_swizzle swizzle
-						{  //0001/rrrg swizzle corresponds to ASTC_ENC_NORMAL_RA
-							ASTCENC_SWZ_R,
-							ASTCENC_SWZ_R,
-							ASTCENC_SWZ_R,
-							ASTCENC_SWZ_G,
-						};
-
-						status = astcenc_compress_image(context, &image, &swizzle, dst, compLen, 0);
-					}
-					else
-					{
-						static const astcenc_swizzle swizzle
-						{  //0123/rgba swizzle corresponds to ASTC_RGBA
-							ASTCENC_SWZ_R,
-							ASTCENC_SWZ_G,
-							ASTCENC_SWZ_B,
-							ASTCENC_SWZ_A,
-						};
-
-						status = astcenc_compress_image(context, &image, &swizzle, dst, compLen, 0);
-					}
-
-					if (status != ASTCENC_SUCCESS)
+					static const astcenc_swizzle s_swizzleNormalMap
+					{  //0001/rrrg swizzle corresponds to ASTC_ENC_NORMAL_RA
+						ASTCENC_SWZ_R,
+						ASTCENC_SWZ_R,
+						ASTCENC_SWZ_R,
+						ASTCENC_SWZ_G,
+					};
+
+					static const astcenc_swizzle s_swizzleRgba
+					{  //0123/rgba swizzle corresponds to ASTC_RGBA
+						ASTCENC_SWZ_R,
+						ASTCENC_SWZ_G,
+						ASTCENC_SWZ_B,
+						ASTCENC_SWZ_A,
+					};
+
+					// Compressor schedules blocks between threads itself, each job is one compressor
+					// thread index.
+					EncodeAstc astc;
+					astc.context   = context;
+					astc.image     = &image;
+					astc.swizzle   = Quality::NormalMapDefault <= _quality ? &s_swizzleNormalMap : &s_swizzleRgba;
+					astc.dst       = dst;
+					astc.dstSize   = compLen;
+					astc.numErrors = 0;
+
+					parallelFor(encodeAstc, &astc, numThreads);
+
+					if (0 != astc.numErrors)
 					{
-						BX_TRACE("astc error in compress image %s", astcenc_get_error_string(status) );
 						BX_ERROR_SET(_err, BIMG_ERROR, "Unable to compress astc image!");
 						astcenc_context_free(context);
 						break;
@@ -0,0 +1,241 @@
+/*
+ * Copyright 2011-2026 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bimg/blob/master/LICENSE
+ */
+
+#include "bimg_p.h"
+
+#include <bx/cpu.h>
+#include <bx/mutex.h>
+#include <bx/semaphore.h>
+#include <bx/thread.h>
+
+namespace bimg
+{
+	JobSchedulerI::~JobSchedulerI()
+	{
+	}
+
+	static JobSchedulerI* s_jobScheduler = NULL;
+
+	void setJobScheduler(JobSchedulerI* _jobScheduler)
+	{
+		s_jobScheduler = _jobScheduler;
+	}
+
+	JobSchedulerI* getJobScheduler()
+	{
+		return s_jobScheduler;
+	}
+
+	uint32_t getConcurrency()
+	{
+		return NULL == s_jobScheduler
+			? 1
+			: bx::max<uint32_t>(s_jobScheduler->getConcurrency(), 1)
+			;
+	}
+
+	void parallelFor(JobFn _fn, void* _userData, uint32_t _num)
+	{
+		if (NULL == s_jobScheduler
+		||  1 >= _num)
+		{
+			for (uint32_t ii = 0; ii < _num; ++ii)
+			{
+				_fn(_userData, ii);
+			}
+
+			return;
+		}
+
+		s_jobScheduler->parallelFor(_fn, _userData, _num);
+	}
+
+#if BX_CONFIG_SUPPORTS_THREADING
+	class JobScheduler : public JobSchedulerI
+	{
+	public:
+		JobScheduler(bx::AllocatorI* _allocator, uint32_t _numThreads)
+			: m_allocator(_allocator)
+			, m_group(NULL)
+			, m_numThreads(bx::min<uint32_t>(_numThreads, kMaxThreads) )
+			, m_exit(false)
+		{
+			for (uint32_t ii = 0; ii < m_numThreads; ++ii)
+			{
+				m_thread[ii].init(threadFunc, this, 0, "bimg job");
+			}
+		}
+
+		virtual ~JobScheduler()
+		{
+			m_exit = true;
+			m_work.post(m_numThreads);
+
+			for (uint32_t ii = 0; ii < m_numThreads; ++ii)
+			{
+				m_thread[ii].shutdown();
+			}
+		}
+
+		virtual uint32_t getConcurrency() const override
+		{
+			return m_numThreads + 1;
+		}
+
+		virtual void parallelFor(JobFn _fn, void* _userData, uint32_t _num) override
+		{
+			if (0 == _num)
+			{
+				return;
+			}
+
+			JobGroup group;
+			group.fn         = _fn;
+			group.userData   = _userData;
+			group.num        = _num;
+			group.next       = 0;
+			group.numWorkers = 0;
+
+			{
+				bx::MutexScope scope(m_mutex);
+				group.link = m_group;
+				m_group    = &group;
+			}
+
+			m_work.post(bx::min(_num-1, m_numThreads) );
+
+			run(group);
+
+			// Unlinks group so no other worker can join it, then waits only for workers that already
+			// joined, since group lives on this stack.
+			uint32_t numWorkers;
+
+			{
+				bx::MutexScope scope(m_mutex);
+
+				JobGroup** link = &m_group;
+				while (*link != &group)
+				{
+					link = &(*link)->link;
+				}
+
+				*link      = group.link;
+				numWorkers = group.numWorkers;
+			}
+
+			for (uint32_t ii = 0; ii < numWorkers; ++ii)
+			{
+				group.done.wait();
+			}
+		}
+
+		bx::AllocatorI* m_allocator;
+
+	private:
+		struct JobGroup
+		{
+			JobFn     fn;
+			void*     userData;
+			uint32_t  num;
+			uint32_t  numWorkers;
+			JobGroup* link;
+
+			volatile uint32_t next;
+
+			bx::Semaphore done;
+		};
+
+		static int32_t threadFunc(bx::Thread* _self, void* _userData)
+		{
+			BX_UNUSED(_self);
+
+			JobScheduler* scheduler = (JobScheduler*)_userData;
+
+			for (;;)
+			{
+				scheduler->m_work.wait();
+
+				if (scheduler->m_exit)
+				{
+					break;
+				}
+
+				// Wake-up can outlive the group it was posted for, in which case there is nothing to
+				// join and worker goes back to waiting.
+				JobGroup* group = scheduler->join();
+
+				if (NULL != group)
+				{
+					run(*group);
+					group->done.post();
+				}
+			}
+
+			return bx::kExitSuccess;
+		}
+
+		JobGroup* join()
+		{
+			bx::MutexScope scope(m_mutex);
+
+			for (JobGroup* group = m_group; NULL != group; group = group->link)
+			{
+				if (group->next < group->num)
+				{
+					++group->numWorkers;
+					return group;
+				}
+			}
+
+			return NULL;
+		}
+
+		static void run(JobGroup& _group)
+		{
+			for (uint32_t index = bx::atomicFetchAndAdd<uint32_t>(&_group.next, 1); index < _group.num; index = bx::atomicFetchAndAdd<uint32_t>(&_group.next, 1) )
+			{
+				_group.fn(_group.userData, index);
+			}
+		}
+
+		static constexpr uint32_t kMaxThreads = 64;
+
+		bx::Thread    m_thread[kMaxThreads];
+		bx::Semaphore m_work;
+		bx::Mutex     m_mutex;
+
+		JobGroup* m_group;
+
+		uint32_t m_numThreads;
+		volatile bool m_exit;
+	};
+
+	JobSchedulerI* createJobScheduler(bx::AllocatorI* _allocator, uint32_t _numThreads)
+	{
+		return BX_NEW(_allocator, JobScheduler)(_allocator, _numThreads);
+	}
+
+	void destroyJobScheduler(JobSchedulerI* _jobScheduler)
+	{
+		if (NULL != _jobScheduler)
+		{
+			JobScheduler* jobScheduler = static_cast<JobScheduler*>(_jobScheduler);
+			bx::deleteObject(jobScheduler->m_allocator, jobScheduler);
+		}
+	}
+#else
+	JobSchedulerI* createJobScheduler(bx::AllocatorI* _allocator, uint32_t _numThreads)
+	{
+		BX_UNUSED(_allocator, _numThreads);
+		return NULL;
+	}
+
+	void destroyJobScheduler(JobSchedulerI* _jobScheduler)
+	{
+		BX_UNUSED(_jobScheduler);
+	}
+#endif // BX_CONFIG_SUPPORTS_THREADING
+
+} // namespace bimg
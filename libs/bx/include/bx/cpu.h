@@ -61,6 +61,12 @@ namespace bx
 	///
 	void* atomicExchangePtr(void** _ptr, void* _new);
 
+	/// Loads pointer with acquire semantics.
+	void* atomicLoadPtr(void* volatile* _ptr);
+
+	/// Stores pointer with release semantics.
+	void atomicStorePtr(void* volatile* _ptr, void* _new);
+
 } // namespace bx
 
 #include "inline/cpu.inl"
@@ -355,4 +355,33 @@ namespace bx
 #endif // BX_COMPILER_*
 	}
 
+	inline void* atomicLoadPtr(void* volatile* _ptr)
+	{
+#if BX_COMPILER_MSVC
+		void* result = *_ptr;
+#	if BX_CPU_X86
+		_ReadWriteBarrier();
+#	else
+		MemoryBarrier();
+#	endif // BX_CPU_X86
+		return result;
+#else
+		return __atomic_load_n(_ptr, __ATOMIC_ACQUIRE);
+#endif // BX_COMPILER_*
+	}
+
+	inline void atomicStorePtr(void* volatile* _ptr, void* _new)
+	{
+#if BX_COMPILER_MSVC
+#	if BX_CPU_X86
+		_ReadWriteBarrier();
+#	else
+		MemoryBarrier();
+#	endif // BX_CPU_X86
+		*_ptr = _new;
+#else
+		__atomic_store_n(_ptr, _new, __ATOMIC_RELEASE);
+#endif // BX_COMPILER_*
+	}
+
 } // namespace bx
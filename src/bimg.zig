@@ -0,0 +1,16 @@
+const std = @import("std");
+
+// Installs bimg job scheduler, so image decode and encode (ex. software decode of compressed
+// textures unsupported by device in `bgfx.createTexture`) run on `num_threads` workers plus calling
+// thread. Null is CPU count minus calling thread. Does nothing if scheduler is already installed.
+pub fn initJobScheduler(num_threads: ?u32) !void {
+    const n = num_threads orelse @as(u32, @intCast(@max(std.Thread.getCpuCount() catch 1, 2) - 1));
+    if (!zbgfx_bimgInitJobScheduler(n)) return error.JobSchedulerUnsupported;
+}
+extern fn zbgfx_bimgInitJobScheduler(_numThreads: u32) bool;
+
+// Call after `bgfx.shutdown`, bgfx decodes images on API and render thread.
+pub fn deinitJobScheduler() void {
+    zbgfx_bimgShutdownJobScheduler();
+}
+extern fn zbgfx_bimgShutdownJobScheduler() void;
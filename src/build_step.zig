@@ -27,6 +27,7 @@ pub const BuildShaderOptions = struct {
     platform: shader.Platform,
     profile: shader.Profile,
     optimize: ?shader.Optimize,
+    cache_dir: ?[]const u8 = null,
 };
 
 pub fn callShaderc(
@@ -52,6 +53,10 @@ pub fn callShaderc(
         shaderc_cmd.addDirectoryArg(include);
     }
 
+    if (options.cache_dir) |dir| {
+        shaderc_cmd.addArgs(&.{ "--cache", dir });
+    }
+
     shaderc_cmd.addArg("-f");
     shaderc_cmd.addFileArg(options.input);
     shaderc_cmd.addArg("-o");
@@ -102,6 +107,9 @@ pub const ShaderInput = struct {
         .{ .profile = .s_5_0, .platform = .windows, .optimize = .o3 },
         .{ .profile = .s_6_0, .platform = .windows, .optimize = .o3 },
     },
+    // Use shared shaderc cache (`shaderc.defaultCacheDir`). Opt-in, cache lives outside of build cache
+    // and is not cleaned by it.
+    cache: bool = false,
 };
 
 pub fn compileShaders(
@@ -262,6 +270,8 @@ pub fn compileShader(
 }
 
 const LazyPathList = std.ArrayList(std.Build.LazyPath);
+// Every variant is independent `shaderc` run step, so build runner compile them in parallel over its own
+// worker pool (bounded by `-j`). Runtime equivalent is `shaderc.compileShaderBatch`.
 pub fn compileShaderVariants(
     b: *std.Build,
     out_shaders: *LazyPathList,
@@ -270,6 +280,8 @@ pub fn compileShaderVariants(
     includes: []const std.Build.LazyPath,
     input: ShaderInput,
 ) !void {
+    const cache_dir = if (input.cache) shader.defaultCacheDir(b.allocator) catch null else null;
+
     for (input.parts) |part| {
         if (target.result.os.tag != .windows and part.profile == .s_5_0) continue;
         if (target.result.os.tag != .windows and part.profile == .s_6_0) continue;
@@ -285,6 +297,7 @@ pub fn compileShaderVariants(
                 .input = input.path,
                 .output = "shaders.zig",
                 .includes = includes,
+                .cache_dir = cache_dir,
             },
         );
         try out_shaders.append(b.allocator, shader_build.output);
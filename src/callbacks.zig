@@ -8,7 +8,6 @@ const Self = @This();
 
 //
 // Allocator
-// FIXME: Does not work because `panic: integer cast truncated bits` from true zig allocator.
 //
 
 pub const CAllocInterfaceT = extern struct { vtable: *const CAllocVtblT };
@@ -16,30 +15,153 @@ pub const CAllocVtblT = extern struct {
     realloc: *const fn (_this: *CAllocInterfaceT, _ptr: [*c]u8, _size: usize, _align: usize, _file: [*:0]const u8, _line: u32) callconv(.c) ?*anyopaque,
 };
 
-pub const ZigAllocatorVtbl = extern struct {
+// bgfx `realloc` doesn't pass size and alignment on free/realloc, but zig allocators need both. Every
+// block is prefixed with `Header` placed right before returned pointer. Raw block starts `offset`
+// bytes before returned pointer, where `offset` is header size rounded up to block alignment.
+pub const ZigAllocatorVtbl = struct {
+    const Header = extern struct {
+        size: usize,
+        alignment: usize,
+    };
+
+    // Same as malloc, bgfx passes 0 alignment when it doesn't care.
+    const natural_alignment = @max(2 * @alignOf(usize), @sizeOf(Header));
+
     fn realloc(_this: *CAllocInterfaceT, _ptr: [*c]u8, _size: usize, _align: usize, _file: [*:0]const u8, _line: u32) callconv(.c) ?*anyopaque {
-        var self: *ZigAllocator = @ptrCast(_this);
-        _ = _file; // autofix
-        _ = _line; // autofix
+        const self: *ZigAllocator = @fieldParentPtr("interface", _this);
+        _ = _file;
+        _ = _line;
+
+        self.mutex.lock();
+        defer self.mutex.unlock();
 
-        if (_size != 0) {
-            return self.allocator.rawAlloc(_size, @truncate(_align), 0);
+        if (_ptr == null) {
+            if (_size == 0) return null;
+            return self.alloc(_size, _align);
         }
-        self.allocator.free(_ptr[0.._size]);
-        return null;
+
+        if (_size == 0) {
+            self.free(_ptr);
+            return null;
+        }
+
+        return self.resize(_ptr, _size, _align);
     }
+
     pub fn toVtbl() Self.CAllocVtblT {
         return CAllocVtblT{ .realloc = @This().realloc };
     }
+
+    fn getAlignment(_align: usize) usize {
+        return @max(_align, natural_alignment);
+    }
+
+    fn getOffset(alignment: usize) usize {
+        return std.mem.alignForward(usize, @sizeOf(Header), alignment);
+    }
+
+    fn getHeader(ptr: [*]u8) *Header {
+        return @ptrCast(@alignCast(ptr - @sizeOf(Header)));
+    }
+
+    fn getRaw(ptr: [*]u8, header: *const Header) []u8 {
+        const offset = getOffset(header.alignment);
+        return (ptr - offset)[0 .. offset + header.size];
+    }
 };
 
-pub const ZigAllocator = extern struct {
+// Bridge for `bgfx.Init.allocator` (and `debugdraw.initWithAllocator`) backed by any zig allocator.
+// Calls are serialized by mutex, bgfx allocates from API, render and encoder threads. Keep it alive
+// until `bgfx.shutdown()`.
+//
+//   bgfx_alloc = zbgfx.callbacks.ZigAllocator.init(gpa_allocator);
+//   bgfx_init.allocator = bgfx_alloc.bgfxAllocator();
+pub const ZigAllocator = struct {
     const _alloc_vtable = ZigAllocatorVtbl.toVtbl();
-    vtable: ?*const CAllocVtblT = null,
-    allocator: *std.mem.Allocator,
 
-    pub fn init(alloc: *std.mem.Allocator) ZigAllocator {
-        return .{ .vtable = &_alloc_vtable, .allocator = alloc };
+    pub const Stats = struct {
+        // Bytes requested by bgfx and still allocated (without headers).
+        current_bytes: usize = 0,
+        peak_bytes: usize = 0,
+        // Number of live allocations, must be 0 after `bgfx.shutdown()`.
+        live_allocations: usize = 0,
+        total_allocations: usize = 0,
+        failed_allocations: usize = 0,
+    };
+
+    interface: CAllocInterfaceT = .{ .vtable = &_alloc_vtable },
+    allocator: std.mem.Allocator,
+    mutex: std.Thread.Mutex = .{},
+    stats: Stats = .{},
+
+    pub fn init(alloc: std.mem.Allocator) ZigAllocator {
+        return .{ .allocator = alloc };
+    }
+
+    pub fn bgfxAllocator(self: *ZigAllocator) *CAllocInterfaceT {
+        return &self.interface;
+    }
+
+    pub fn getStats(self: *ZigAllocator) Stats {
+        self.mutex.lock();
+        defer self.mutex.unlock();
+        return self.stats;
+    }
+
+    fn alloc(self: *ZigAllocator, size: usize, _align: usize) ?*anyopaque {
+        const alignment = ZigAllocatorVtbl.getAlignment(_align);
+        const offset = ZigAllocatorVtbl.getOffset(alignment);
+
+        const raw = self.allocator.rawAlloc(offset + size, .fromByteUnits(alignment), @returnAddress()) orelse {
+            self.stats.failed_allocations += 1;
+            return null;
+        };
+
+        const ptr = raw + offset;
+        ZigAllocatorVtbl.getHeader(ptr).* = .{ .size = size, .alignment = alignment };
+
+        self.stats.current_bytes += size;
+        self.stats.peak_bytes = @max(self.stats.peak_bytes, self.stats.current_bytes);
+        self.stats.live_allocations += 1;
+        self.stats.total_allocations += 1;
+        return ptr;
+    }
+
+    fn free(self: *ZigAllocator, ptr: [*]u8) void {
+        const header = ZigAllocatorVtbl.getHeader(ptr);
+        const size = header.size;
+        const alignment = header.alignment;
+
+        self.allocator.rawFree(ZigAllocatorVtbl.getRaw(ptr, header), .fromByteUnits(alignment), @returnAddress());
+
+        self.stats.current_bytes -= size;
+        self.stats.live_allocations -= 1;
+    }
+
+    fn resize(self: *ZigAllocator, ptr: [*]u8, size: usize, _align: usize) ?*anyopaque {
+        const header = ZigAllocatorVtbl.getHeader(ptr);
+        const old_size = header.size;
+        const alignment = header.alignment;
+
+        // Remap keeps offset between raw block and returned pointer, so only same alignment can use it.
+        if (ZigAllocatorVtbl.getAlignment(_align) == alignment) {
+            const offset = ZigAllocatorVtbl.getOffset(alignment);
+            const raw = ZigAllocatorVtbl.getRaw(ptr, header);
+
+            if (self.allocator.rawRemap(raw, .fromByteUnits(alignment), offset + size, @returnAddress())) |new_raw| {
+                const new_ptr = new_raw + offset;
+                ZigAllocatorVtbl.getHeader(new_ptr).size = size;
+
+                self.stats.current_bytes = self.stats.current_bytes - old_size + size;
+                self.stats.peak_bytes = @max(self.stats.peak_bytes, self.stats.current_bytes);
+                return new_ptr;
+            }
+        }
+
+        const new_ptr: [*]u8 = @ptrCast(self.alloc(size, _align) orelse return null);
+        @memcpy(new_ptr[0..@min(old_size, size)], ptr[0..@min(old_size, size)]);
+        self.free(ptr);
+        return new_ptr;
     }
 };
 
@@ -168,4 +290,651 @@ pub const DefaultZigCallbackVTable = struct {
     }
 };
 
+//
+// Disk cache
+//
+
+// Persistent cache for bgfx `cache_read_size`/`cache_read`/`cache_write` callbacks (program binaries,
+// pipeline caches). Every entry is one file named by its 64-bit id, written to temporary file and
+// renamed into place, so partially written entries are never visible. Entry header stores size and
+// CRC32 of payload, corrupted entries are dropped on read. Index with LRU stamps is kept in
+// `index.bin`, and rebuilt from entry headers when it's missing or invalid.
+//
+// `cache_write` is called on render thread, so entry files are written without holding lock and
+// without fsync. Entry torn by crash fails size or CRC check and is dropped like any other corrupted
+// entry. Only `flush` syncs index file.
+pub const DiskCache = struct {
+    pub const Options = struct {
+        // Total size of cached payloads, least recently used entries are evicted above it.
+        max_size: u64 = 256 * 1024 * 1024,
+    };
+
+    const entry_magic = [8]u8{ 'B', 'G', 'F', 'X', 'C', 'A', 'C', 'H' };
+    const index_magic = [8]u8{ 'B', 'G', 'F', 'X', 'C', 'I', 'D', 'X' };
+    const version: u32 = 1;
+    const index_file_name = "index.bin";
+
+    const EntryHeader = extern struct {
+        magic: [8]u8,
+        version: u32,
+        size: u32,
+        id: u64,
+        crc: u32,
+        reserved: u32 = 0,
+    };
+
+    const IndexHeader = extern struct {
+        magic: [8]u8,
+        version: u32,
+        count: u32,
+        tick: u64,
+    };
+
+    const IndexEntry = extern struct {
+        id: u64,
+        size: u32,
+        crc: u32,
+        stamp: u64,
+    };
+
+    const Entry = struct {
+        size: u32,
+        crc: u32,
+        stamp: u64,
+    };
+
+    const FileName = [20]u8;
+    const TmpFileName = [32]u8;
+
+    const LruEntry = struct {
+        id: u64,
+        stamp: u64,
+
+        fn lessThan(_: void, lhs: LruEntry, rhs: LruEntry) bool {
+            return lhs.stamp < rhs.stamp;
+        }
+    };
+
+    allocator: std.mem.Allocator,
+    dir: std.fs.Dir,
+    options: Options,
+    entries: std.AutoHashMapUnmanaged(u64, Entry) = .empty,
+    total_size: u64 = 0,
+    tick: u64 = 0,
+    dirty: bool = false,
+    tmp_seq: u32 = 0,
+    mutex: std.Thread.Mutex = .{},
+    flush_mutex: std.Thread.Mutex = .{},
+
+    pub fn init(allocator: std.mem.Allocator, path: []const u8, options: Options) !DiskCache {
+        var self = DiskCache{
+            .allocator = allocator,
+            .dir = try std.fs.cwd().makeOpenPath(path, .{ .iterate = true }),
+            .options = options,
+        };
+        errdefer self.dir.close();
+        errdefer self.entries.deinit(allocator);
+
+        // Index is written only on flush, entries written after it are found by scanning directory.
+        var index: std.AutoHashMapUnmanaged(u64, Entry) = .empty;
+        defer index.deinit(allocator);
+
+        self.loadIndex(&index) catch |err| {
+            log.warn("Disk cache index is not valid ({s}), rebuilding.", .{@errorName(err)});
+            index.clearRetainingCapacity();
+            self.tick = 0;
+        };
+
+        try self.rebuildIndex(&index);
+        try self.evict();
+        return self;
+    }
+
+    pub fn deinit(self: *DiskCache) void {
+        self.flush() catch |err| {
+            log.warn("Failed to write disk cache index ({s}).", .{@errorName(err)});
+        };
+        self.entries.deinit(self.allocator);
+        self.dir.close();
+    }
+
+    // Writes index, so that LRU order survives restart. Index is snapshotted under lock, and written
+    // and synced without holding it.
+    pub fn flush(self: *DiskCache) !void {
+        self.flush_mutex.lock();
+        defer self.flush_mutex.unlock();
+
+        const data = blk: {
+            self.mutex.lock();
+            defer self.mutex.unlock();
+
+            if (!self.dirty) return;
+
+            const count = self.entries.count();
+            const index = try self.allocator.alloc(u8, @sizeOf(IndexHeader) + count * @sizeOf(IndexEntry));
+
+            const header = IndexHeader{ .magic = index_magic, .version = version, .count = count, .tick = self.tick };
+            @memcpy(index[0..@sizeOf(IndexHeader)], std.mem.asBytes(&header));
+
+            var offset: usize = @sizeOf(IndexHeader);
+            var it = self.entries.iterator();
+            while (it.next()) |kv| {
+                const entry = IndexEntry{ .id = kv.key_ptr.*, .size = kv.value_ptr.size, .crc = kv.value_ptr.crc, .stamp = kv.value_ptr.stamp };
+                @memcpy(index[offset..][0..@sizeOf(IndexEntry)], std.mem.asBytes(&entry));
+                offset += @sizeOf(IndexEntry);
+            }
+
+            self.dirty = false;
+            break :blk index;
+        };
+        defer self.allocator.free(data);
+
+        self.writeIndex(data) catch |err| {
+            self.mutex.lock();
+            defer self.mutex.unlock();
+            self.dirty = true;
+            return err;
+        };
+    }
+
+    pub fn readSize(self: *DiskCache, id: u64) u32 {
+        self.mutex.lock();
+        defer self.mutex.unlock();
+
+        const entry = self.entries.get(id) orelse return 0;
+        return entry.size;
+    }
+
+    pub fn read(self: *DiskCache, id: u64, out: []u8) bool {
+        self.mutex.lock();
+        defer self.mutex.unlock();
+
+        const entry = self.entries.getPtr(id) orelse return false;
+        if (entry.size != out.len) return false;
+
+        self.readEntry(id, entry.*, out) catch |err| {
+            log.warn("Dropping disk cache entry {x:0>16} ({s}).", .{ id, @errorName(err) });
+            self.removeEntry(id);
+            return false;
+        };
+
+        self.tick += 1;
+        entry.stamp = self.tick;
+        self.dirty = true;
+        return true;
+    }
+
+    // Entry is written to unique temporary file first. Index and size are updated, and least
+    // recently used entries evicted, only after it's renamed into place, so failed write leaves
+    // cache as it was.
+    pub fn write(self: *DiskCache, id: u64, data: []const u8) !void {
+        if (data.len > self.options.max_size or data.len > std.math.maxInt(u32)) return error.EntryTooLarge;
+
+        const crc = std.hash.Crc32.hash(data);
+        const header = EntryHeader{ .magic = entry_magic, .version = version, .size = @intCast(data.len), .id = id, .crc = crc };
+
+        var tmp_name_buf: TmpFileName = undefined;
+        const seq = @atomicRmw(u32, &self.tmp_seq, .Add, 1, .monotonic);
+        const tmp_name = std.fmt.bufPrint(&tmp_name_buf, "{x:0>16}.{x:0>8}.tmp", .{ id, seq }) catch unreachable;
+
+        try self.writeFile(tmp_name, &.{ std.mem.asBytes(&header), data }, false);
+        errdefer self.dir.deleteFile(tmp_name) catch {};
+
+        self.mutex.lock();
+        defer self.mutex.unlock();
+
+        try self.entries.ensureUnusedCapacity(self.allocator, 1);
+
+        var name: FileName = undefined;
+        try self.dir.rename(tmp_name, entryFileName(&name, id));
+
+        if (self.entries.get(id)) |old| {
+            self.total_size -= old.size;
+        }
+
+        self.tick += 1;
+        self.entries.putAssumeCapacity(id, .{ .size = @intCast(data.len), .crc = crc, .stamp = self.tick });
+        self.total_size += data.len;
+        self.dirty = true;
+
+        self.evict() catch |err| {
+            log.warn("Failed to evict disk cache entries ({s}).", .{@errorName(err)});
+        };
+    }
+
+    pub fn getTotalSize(self: *DiskCache) u64 {
+        self.mutex.lock();
+        defer self.mutex.unlock();
+        return self.total_size;
+    }
+
+    fn entryFileName(out: *FileName, id: u64) []const u8 {
+        return std.fmt.bufPrint(out, "{x:0>16}.bin", .{id}) catch unreachable;
+    }
+
+    fn writeFile(self: *DiskCache, file_name: []const u8, parts: []const []const u8, sync: bool) !void {
+        const file = try self.dir.createFile(file_name, .{ .truncate = true });
+        errdefer self.dir.deleteFile(file_name) catch {};
+        defer file.close();
+
+        for (parts) |part| {
+            try file.writeAll(part);
+        }
+
+        if (sync) {
+            try file.sync();
+        }
+    }
+
+    fn writeIndex(self: *DiskCache, data: []const u8) !void {
+        const tmp_name = index_file_name ++ ".tmp";
+        try self.writeFile(tmp_name, &.{data}, true);
+        errdefer self.dir.deleteFile(tmp_name) catch {};
+
+        try self.dir.rename(tmp_name, index_file_name);
+    }
+
+    fn readEntry(self: *DiskCache, id: u64, entry: Entry, out: []u8) !void {
+        var name: FileName = undefined;
+        const file = try self.dir.openFile(entryFileName(&name, id), .{});
+        defer file.close();
+
+        const file_size = try file.getEndPos();
+        if (file_size != @sizeOf(EntryHeader) + @as(u64, entry.size)) return error.CorruptEntry;
+
+        if (builtin.os.tag == .windows) {
+            var header: EntryHeader = undefined;
+            if (try file.preadAll(std.mem.asBytes(&header), 0) != @sizeOf(EntryHeader)) return error.CorruptEntry;
+            if (try file.preadAll(out, @sizeOf(EntryHeader)) != out.len) return error.CorruptEntry;
+            try validateEntry(header, id, entry, out);
+        } else {
+            const mapped = try std.posix.mmap(null, @intCast(file_size), std.posix.PROT.READ, .{ .TYPE = .PRIVATE }, file.handle, 0);
+            defer std.posix.munmap(mapped);
+
+            const header = std.mem.bytesToValue(EntryHeader, mapped[0..@sizeOf(EntryHeader)]);
+            const payload = mapped[@sizeOf(EntryHeader)..];
+            try validateEntry(header, id, entry, payload);
+            @memcpy(out, payload);
+        }
+    }
+
+    fn validateEntry(header: EntryHeader, id: u64, entry: Entry, payload: []const u8) !void {
+        if (!std.mem.eql(u8, &header.magic, &entry_magic) or
+            header.version != version or
+            header.id != id or
+            header.size != entry.size or
+            header.crc != entry.crc or
+            std.hash.Crc32.hash(payload) != header.crc)
+        {
+            return error.CorruptEntry;
+        }
+    }
+
+    fn removeEntry(self: *DiskCache, id: u64) void {
+        if (self.entries.fetchRemove(id)) |kv| {
+            self.total_size -= kv.value.size;
+            self.dirty = true;
+        }
+
+        var name: FileName = undefined;
+        self.dir.deleteFile(entryFileName(&name, id)) catch {};
+    }
+
+    // Evicts least recently used entries until total size is under size cap. Entries are sorted by
+    // LRU stamp once per pass.
+    fn evict(self: *DiskCache) !void {
+        if (self.total_size <= self.options.max_size) return;
+
+        const lru = try self.allocator.alloc(LruEntry, self.entries.count());
+        defer self.allocator.free(lru);
+
+        var it = self.entries.iterator();
+        var ii: usize = 0;
+        while (it.next()) |kv| : (ii += 1) {
+            lru[ii] = .{ .id = kv.key_ptr.*, .stamp = kv.value_ptr.stamp };
+        }
+
+        std.mem.sortUnstable(LruEntry, lru, {}, LruEntry.lessThan);
+
+        for (lru) |entry| {
+            if (self.total_size <= self.options.max_size) break;
+            self.removeEntry(entry.id);
+        }
+    }
+
+    fn loadIndex(self: *DiskCache, index: *std.AutoHashMapUnmanaged(u64, Entry)) !void {
+        const file = try self.dir.openFile(index_file_name, .{});
+        defer file.close();
+
+        var header: IndexHeader = undefined;
+        if (try file.preadAll(std.mem.asBytes(&header), 0) != @sizeOf(IndexHeader)) return error.CorruptIndex;
+        if (!std.mem.eql(u8, &header.magic, &index_magic) or header.version != version) return error.CorruptIndex;
+
+        const size = @as(u64, header.count) * @sizeOf(IndexEntry);
+        if (try file.getEndPos() != @sizeOf(IndexHeader) + size) return error.CorruptIndex;
+
+        const entries = try self.allocator.alloc(IndexEntry, header.count);
+        defer self.allocator.free(entries);
+
+        if (try file.preadAll(std.mem.sliceAsBytes(entries), @sizeOf(IndexHeader)) != size) return error.CorruptIndex;
+
+        try index.ensureTotalCapacity(self.allocator, header.count);
+        for (entries) |entry| {
+            index.putAssumeCapacity(entry.id, .{ .size = entry.size, .crc = entry.crc, .stamp = entry.stamp });
+        }
+
+        self.tick = header.tick;
+    }
+
+    // Builds entries from entry files in cache directory. Entries keep LRU stamp from index when
+    // they match it. Entries missing from index were written after it was flushed, so they are
+    // treated as most recently used.
+    fn rebuildIndex(self: *DiskCache, index: *const std.AutoHashMapUnmanaged(u64, Entry)) !void {
+        var num_indexed: u32 = 0;
+
+        var it = self.dir.iterate();
+        while (try it.next()) |dir_entry| {
+            if (dir_entry.kind != .file) continue;
+
+            const name = dir_entry.name;
+            if (name.len != 20 or !std.mem.endsWith(u8, name, ".bin")) {
+                // Leftovers of interrupted writes.
+                if (std.mem.endsWith(u8, name, ".tmp")) self.dir.deleteFile(name) catch {};
+                continue;
+            }
+
+            const id = std.fmt.parseInt(u64, name[0..16], 16) catch continue;
+
+            const file = self.dir.openFile(name, .{}) catch continue;
+            defer file.close();
+
+            var header: EntryHeader = undefined;
+            const valid = blk: {
+                const len = file.preadAll(std.mem.asBytes(&header), 0) catch break :blk false;
+                const file_size = file.getEndPos() catch break :blk false;
+                break :blk len == @sizeOf(EntryHeader) and
+                    std.mem.eql(u8, &header.magic, &entry_magic) and
+                    header.version == version and
+                    header.id == id and
+                    file_size == @sizeOf(EntryHeader) + @as(u64, header.size);
+            };
+
+            if (!valid) {
+                self.dir.deleteFile(name) catch {};
+                continue;
+            }
+
+            const entry: Entry = blk: {
+                if (index.get(id)) |indexed| {
+                    if (indexed.size == header.size and indexed.crc == header.crc) {
+                        num_indexed += 1;
+                        break :blk indexed;
+                    }
+                }
+
+                self.tick += 1;
+                break :blk .{ .size = header.size, .crc = header.crc, .stamp = self.tick };
+            };
+
+            try self.entries.put(self.allocator, id, entry);
+            self.total_size += header.size;
+        }
+
+        self.dirty = num_indexed != index.count() or num_indexed != self.entries.count();
+    }
+};
+
+pub const DiskCacheCallbackVTable = struct {
+    pub fn cache_read_size(_this: *CCallbackInterfaceT, _id: u64) callconv(.c) u32 {
+        const self: *DiskCacheCallback = @ptrCast(_this);
+        return self.cache.readSize(_id);
+    }
+    pub fn cache_read(_this: *CCallbackInterfaceT, _id: u64, _data: [*c]u8, _size: u32) callconv(.c) bool {
+        const self: *DiskCacheCallback = @ptrCast(_this);
+        return self.cache.read(_id, _data[0.._size]);
+    }
+    pub fn cache_write(_this: *CCallbackInterfaceT, _id: u64, _data: [*c]u8, _size: u32) callconv(.c) void {
+        const self: *DiskCacheCallback = @ptrCast(_this);
+        self.cache.write(_id, _data[0.._size]) catch |err| {
+            log.warn("Failed to write disk cache entry {x:0>16} ({s}).", .{ _id, @errorName(err) });
+        };
+    }
+
+    pub fn toVtbl() Self.CCallbackVtblT {
+        var vtbl = DefaultZigCallbackVTable.toVtbl();
+        vtbl.cache_read_size = @This().cache_read_size;
+        vtbl.cache_read = @This().cache_read;
+        vtbl.cache_write = @This().cache_write;
+        return vtbl;
+    }
+};
+
+// Default callbacks with cache backed by `DiskCache`. Pass `&callback` as `bgfx.Init.callback`.
+pub const DiskCacheCallback = extern struct {
+    const _vtable = DiskCacheCallbackVTable.toVtbl();
+    vtable: *const CCallbackVtblT = &_vtable,
+    cache: *DiskCache,
+
+    pub fn init(cache: *DiskCache) DiskCacheCallback {
+        return .{ .vtable = &_vtable, .cache = cache };
+    }
+};
+
 extern fn formatTrace(buff: [*]const u8, buff_size: u32, _format: [*:0]const u8, _argList: VaList) i32;
+
+//
+// Tests
+//
+
+test "ZigAllocator has no leaks after Noop renderer init, frames and shutdown" {
+    var gpa = std.heap.GeneralPurposeAllocator(.{}){};
+
+    {
+        var bgfx_alloc = ZigAllocator.init(gpa.allocator());
+
+        var bgfx_init: bgfx.Init = undefined;
+        bgfx.initCtor(&bgfx_init);
+        bgfx_init.type = .Noop;
+        bgfx_init.resolution.width = 64;
+        bgfx_init.resolution.height = 64;
+        bgfx_init.allocator = bgfx_alloc.bgfxAllocator();
+
+        try std.testing.expect(bgfx.init(&bgfx_init));
+
+        for (0..4) |_| {
+            bgfx.touch(0);
+            _ = bgfx.frame(0);
+        }
+
+        bgfx.shutdown();
+
+        const stats = bgfx_alloc.getStats();
+        try std.testing.expectEqual(@as(usize, 0), stats.live_allocations);
+        try std.testing.expectEqual(@as(usize, 0), stats.current_bytes);
+        try std.testing.expectEqual(@as(usize, 0), stats.failed_allocations);
+        try std.testing.expect(stats.total_allocations > 0);
+
+        // Default limits peak at ~45MB, mostly frame render item pages, matrix caches and transient
+        // buffers.
+        try std.testing.expect(stats.peak_bytes > 0);
+        try std.testing.expect(stats.peak_bytes < 64 * 1024 * 1024);
+    }
+
+    try std.testing.expect(gpa.deinit() == .ok);
+}
+
+test "DiskCache drops corrupted entries and rebuilds invalid index" {
+    const allocator = std.testing.allocator;
+
+    var tmp = std.testing.tmpDir(.{});
+    defer tmp.cleanup();
+
+    const path = try tmp.dir.realpathAlloc(allocator, ".");
+    defer allocator.free(path);
+
+    {
+        var cache = try DiskCache.init(allocator, path, .{});
+        defer cache.deinit();
+
+        try cache.write(1, "first entry");
+        try cache.write(2, "second entry");
+    }
+
+    // Flip one payload byte, index still lists entry but CRC check must reject it.
+    {
+        const file = try tmp.dir.openFile("0000000000000001.bin", .{ .mode = .read_write });
+        defer file.close();
+
+        var byte: [1]u8 = undefined;
+        _ = try file.preadAll(&byte, @sizeOf(DiskCache.EntryHeader));
+        byte[0] ^= 0xff;
+        try file.pwriteAll(&byte, @sizeOf(DiskCache.EntryHeader));
+    }
+
+    {
+        var cache = try DiskCache.init(allocator, path, .{});
+        defer cache.deinit();
+
+        var out: [12]u8 = undefined;
+        try std.testing.expectEqual(@as(u32, 11), cache.readSize(1));
+        try std.testing.expect(!cache.read(1, out[0..11]));
+        try std.testing.expectEqual(@as(u32, 0), cache.readSize(1));
+        try std.testing.expectError(error.FileNotFound, tmp.dir.access("0000000000000001.bin", .{}));
+
+        try std.testing.expect(cache.read(2, &out));
+        try std.testing.expectEqualStrings("second entry", &out);
+    }
+
+    // Invalid index is rebuilt from entry headers.
+    try tmp.dir.writeFile(.{ .sub_path = "index.bin", .data = "not an index" });
+
+    {
+        var cache = try DiskCache.init(allocator, path, .{});
+        defer cache.deinit();
+
+        var out: [12]u8 = undefined;
+        try std.testing.expectEqual(@as(u64, 12), cache.getTotalSize());
+        try std.testing.expect(cache.read(2, &out));
+        try std.testing.expectEqualStrings("second entry", &out);
+    }
+}
+
+test "DiskCache evicts least recently used entries" {
+    const allocator = std.testing.allocator;
+
+    var tmp = std.testing.tmpDir(.{});
+    defer tmp.cleanup();
+
+    const path = try tmp.dir.realpathAlloc(allocator, ".");
+    defer allocator.free(path);
+
+    const payload = "0123456789";
+
+    {
+        var cache = try DiskCache.init(allocator, path, .{ .max_size = 30 });
+        defer cache.deinit();
+
+        try cache.write(1, payload);
+        try cache.write(2, payload);
+        try cache.write(3, payload);
+
+        var out: [10]u8 = undefined;
+        try std.testing.expect(cache.read(1, &out));
+
+        // Entry 2 is least recently used.
+        try cache.write(4, payload);
+        try std.testing.expectEqual(@as(u32, 0), cache.readSize(2));
+        try std.testing.expectError(error.FileNotFound, tmp.dir.access("0000000000000002.bin", .{}));
+        for ([_]u64{ 1, 3, 4 }) |id| {
+            try std.testing.expectEqual(@as(u32, 10), cache.readSize(id));
+        }
+        try std.testing.expectEqual(@as(u64, 30), cache.getTotalSize());
+
+        // Rewritten entry replaces old size instead of adding to it.
+        try cache.write(3, payload[0..5]);
+        try std.testing.expectEqual(@as(u64, 25), cache.getTotalSize());
+        try std.testing.expectEqual(@as(u32, 5), cache.readSize(3));
+    }
+
+    // LRU order survives restart, entry 1 was used before 4 and 3.
+    {
+        var cache = try DiskCache.init(allocator, path, .{ .max_size = 30 });
+        defer cache.deinit();
+
+        try cache.write(5, payload);
+        try std.testing.expectEqual(@as(u32, 0), cache.readSize(1));
+        try std.testing.expectEqual(@as(u32, 5), cache.readSize(3));
+        try std.testing.expectEqual(@as(u32, 10), cache.readSize(4));
+        try std.testing.expectEqual(@as(u32, 10), cache.readSize(5));
+        try std.testing.expectEqual(@as(u64, 25), cache.getTotalSize());
+    }
+}
+
+test "DiskCache finds entries written after index was last flushed" {
+    const allocator = std.testing.allocator;
+
+    var tmp = std.testing.tmpDir(.{});
+    defer tmp.cleanup();
+
+    const path = try tmp.dir.realpathAlloc(allocator, ".");
+    defer allocator.free(path);
+
+    const payload = "0123456789";
+
+    {
+        var cache = try DiskCache.init(allocator, path, .{ .max_size = 30 });
+
+        try cache.write(1, payload);
+        try cache.flush();
+        try cache.write(2, payload);
+        try cache.write(3, payload);
+
+        // Simulate crash, index is not written again.
+        cache.entries.deinit(allocator);
+        cache.dir.close();
+    }
+
+    {
+        var cache = try DiskCache.init(allocator, path, .{ .max_size = 30 });
+        defer cache.deinit();
+
+        for ([_]u64{ 1, 2, 3 }) |id| {
+            try std.testing.expectEqual(@as(u32, 10), cache.readSize(id));
+        }
+        try std.testing.expectEqual(@as(u64, 30), cache.getTotalSize());
+
+        // Entries missing from index are more recent than indexed ones, and are evicted too.
+        try cache.write(4, payload);
+        try std.testing.expectEqual(@as(u32, 0), cache.readSize(1));
+        try std.testing.expectError(error.FileNotFound, tmp.dir.access("0000000000000001.bin", .{}));
+        try std.testing.expectEqual(@as(u64, 30), cache.getTotalSize());
+    }
+}
+
+test "DiskCacheCallback serves bgfx cache callbacks" {
+    const allocator = std.testing.allocator;
+
+    var tmp = std.testing.tmpDir(.{});
+    defer tmp.cleanup();
+
+    const path = try tmp.dir.realpathAlloc(allocator, ".");
+    defer allocator.free(path);
+
+    var cache = try DiskCache.init(allocator, path, .{});
+    defer cache.deinit();
+
+    var callback = DiskCacheCallback.init(&cache);
+    const interface: *CCallbackInterfaceT = @ptrCast(&callback);
+
+    const id: u64 = 0x0123456789abcdef;
+    var data = [_]u8{ 1, 2, 3, 4, 5 };
+
+    try std.testing.expectEqual(@as(u32, 0), callback.vtable.cache_read_size(interface, id));
+
+    callback.vtable.cache_write(interface, id, &data, data.len);
+    try std.testing.expectEqual(@as(u32, data.len), callback.vtable.cache_read_size(interface, id));
+
+    var out: [5]u8 = undefined;
+    try std.testing.expect(callback.vtable.cache_read(interface, id, &out, out.len));
+    try std.testing.expectEqualSlices(u8, &data, &out);
+}
@@ -1,5 +1,6 @@
 const std = @import("std");
 const bgfx = @import("bgfx");
+const callbacks = @import("callbacks.zig");
 
 pub const Axis = enum(c_int) {
     X,
@@ -35,6 +36,13 @@ pub fn init() void {
 }
 extern fn zbgfx_ddInit() void;
 
+// Same as `init`, but debug draw allocations go through `allocator` (ex. `callbacks.ZigAllocator`).
+// Allocator must stay alive until `deinit`.
+pub fn initWithAllocator(allocator: *callbacks.CAllocInterfaceT) void {
+    zbgfx_ddInitAllocator(allocator);
+}
+extern fn zbgfx_ddInitAllocator(allocator: *callbacks.CAllocInterfaceT) void;
+
 pub fn deinit() void {
     zbgfx_ddShutdown();
 }
@@ -240,10 +240,48 @@ pub const ShadercOptions = struct {
     includeDirs: ?[]const []const u8 = null,
     defines: ?[]const []const u8 = null,
 
-    optimizationLevel: Optimize = .o3,
+    // `null` compiles without `-O`, compilers run with their defaults.
+    optimizationLevel: ?Optimize = .o3,
     keepcomments: bool = false,
+
+    // Content-addressed cache of compiled shaders (see `defaultCacheDir`). Key is hash of preprocessed source, options and
+    // command line comment.
+    cacheDir: ?[]const u8 = null,
+    cacheMaxSize: u64 = 256 * 1024 * 1024,
+};
+
+pub const CacheStats = extern struct {
+    hits: u32,
+    misses: u32,
+    stores: u32,
+    evictions: u32,
 };
 
+// Shared cache dir for runtime and build step. Caller is owner of memory.
+pub fn defaultCacheDir(allocator: std.mem.Allocator) ![]u8 {
+    const base = userCacheDir(allocator) catch try getSysTmpDir(allocator);
+    defer allocator.free(base);
+
+    return std.fs.path.join(allocator, &.{ base, "zbgfx", "shaderc" });
+}
+
+// Fails when environment variables are not set, so that caller can fall back to temp dir.
+fn userCacheDir(allocator: std.mem.Allocator) ![]u8 {
+    return switch (builtin.os.tag) {
+        .windows => std.process.getEnvVarOwned(allocator, "LOCALAPPDATA"),
+        .macos => blk: {
+            const home = try std.process.getEnvVarOwned(allocator, "HOME");
+            defer allocator.free(home);
+            break :blk std.fs.path.join(allocator, &.{ home, "Library", "Caches" });
+        },
+        else => std.process.getEnvVarOwned(allocator, "XDG_CACHE_HOME") catch blk: {
+            const home = try std.process.getEnvVarOwned(allocator, "HOME");
+            defer allocator.free(home);
+            break :blk std.fs.path.join(allocator, &.{ home, ".cache" });
+        },
+    };
+}
+
 pub fn shadercFromExePath(allocator: std.mem.Allocator) ![]u8 {
     const exe_dir = try std.fs.selfExeDirPathAlloc(allocator);
     defer allocator.free(exe_dir);
@@ -275,27 +313,19 @@ pub fn compileShader(
         if (err != error.PathAlreadyExists) return err;
     };
 
-    // Write source
-    var in_random_path: [RANDOM_PATH_LEN]u8 = undefined;
-    generateRandomFileName(&in_random_path);
+    // Cache key includes shaderc command line. With cache, inputs are named by content, so that same
+    // shader gets same command line, and are not deleted as other compile can be reading them.
+    const content_names = options.cacheDir != null;
 
-    const source_file_path = try std.fs.path.join(allocator, &.{ tmp_dir_path, &in_random_path });
+    // Write source
+    const source_file_path = try writeInputFile(allocator, tmp_dir_path, shader, content_names);
     defer allocator.free(source_file_path);
-    const in_f = try std.fs.createFileAbsolute(source_file_path, .{});
-    try in_f.writeAll(shader);
-    in_f.close();
-    defer std.fs.deleteFileAbsolute(source_file_path) catch undefined;
+    defer if (!content_names) std.fs.deleteFileAbsolute(source_file_path) catch undefined;
 
     // Write varying
-    var varying_random_path: [RANDOM_PATH_LEN]u8 = undefined;
-    generateRandomFileName(&varying_random_path);
-
-    const varying_file_path = try std.fs.path.join(allocator, &.{ tmp_dir_path, &varying_random_path });
+    const varying_file_path = try writeInputFile(allocator, tmp_dir_path, varying, content_names);
     defer allocator.free(varying_file_path);
-    const varying_f = try std.fs.createFileAbsolute(varying_file_path, .{});
-    try varying_f.writeAll(varying);
-    varying_f.close();
-    defer std.fs.deleteFileAbsolute(varying_file_path) catch undefined;
+    defer if (!content_names) std.fs.deleteFileAbsolute(varying_file_path) catch undefined;
 
     const use_file_output = builtin.os.tag == .windows; // FIXME: Problem only on windows. Load shader in bgfx failed.
 
@@ -357,20 +387,234 @@ pub fn compileShader(
     }
 }
 
+//
+// In-process compile via `zbgfx_shaderc` library artifact.
+// No temp files and no child process. Link `zbgfx_shaderc` artifact to your exe to use this.
+//
+
+const ShadercLibOptions = extern struct {
+    shaderType: u8,
+    platform: [*:0]const u8,
+    profile: [*:0]const u8,
+    inputFilePath: ?[*:0]const u8,
+
+    includeDirs: [*]const [*:0]const u8,
+    numIncludeDirs: u32,
+    defines: [*]const [*:0]const u8,
+    numDefines: u32,
+
+    optimizationLevel: u32,
+    optimize: bool,
+    keepComments: bool,
+    debugInformation: bool,
+    warningsAreErrors: bool,
+
+    cacheDir: ?[*:0]const u8,
+    cacheMaxSize: u64,
+};
+
+const ShadercLibResult = extern struct {
+    data: ?[*]u8,
+    size: u32,
+    messages: ?[*:0]u8,
+    messagesSize: u32,
+};
+
+extern fn zbgfx_shadercCompile(options: *const ShadercLibOptions, varying: [*]const u8, varying_len: u32, source: [*]const u8, source_len: u32, result: *ShadercLibResult) bool;
+extern fn zbgfx_shadercFree(result: *ShadercLibResult) void;
+extern fn zbgfx_shadercGetCacheStats(stats: *CacheStats) void;
+
+// Cache stats of in-process compile.
+pub fn getCacheStats() CacheStats {
+    var stats: CacheStats = undefined;
+    zbgfx_shadercGetCacheStats(&stats);
+    return stats;
+}
+
+// Caller is owner of memory.
+pub fn compileShaderInProcess(
+    allocator: std.mem.Allocator,
+    varying: []const u8,
+    shader: []const u8,
+    options: ShadercOptions,
+) ![]u8 {
+    var arena_state = std.heap.ArenaAllocator.init(allocator);
+    defer arena_state.deinit();
+    const arena = arena_state.allocator();
+
+    const include_dirs = try toCStrings(arena, options.includeDirs);
+    const defines = try toCStrings(arena, options.defines);
+
+    const lib_options = ShadercLibOptions{
+        .shaderType = options.shaderType.toChar(),
+        .platform = options.platform.toStr().ptr,
+        .profile = options.profile.toStr().ptr,
+        .inputFilePath = if (options.inputFilePath) |path| (try arena.dupeZ(u8, path)).ptr else null,
+        .includeDirs = include_dirs.ptr,
+        .numIncludeDirs = @intCast(include_dirs.len),
+        .defines = defines.ptr,
+        .numDefines = @intCast(defines.len),
+        .optimizationLevel = if (options.optimizationLevel) |level| @intFromEnum(level) else 0,
+        .optimize = options.optimizationLevel != null,
+        .keepComments = options.keepcomments,
+        .debugInformation = false,
+        .warningsAreErrors = false,
+        .cacheDir = if (options.cacheDir) |dir| (try arena.dupeZ(u8, dir)).ptr else null,
+        .cacheMaxSize = options.cacheMaxSize,
+    };
+
+    var result: ShadercLibResult = undefined;
+    const compiled = zbgfx_shadercCompile(
+        &lib_options,
+        varying.ptr,
+        @intCast(varying.len),
+        shader.ptr,
+        @intCast(shader.len),
+        &result,
+    );
+    defer zbgfx_shadercFree(&result);
+
+    const messages = if (result.messages) |m| m[0..result.messagesSize] else "";
+
+    if (!compiled) {
+        std.log.err("Shaderc error:\n{s}", .{messages});
+        return error.ShaderCompileError;
+    }
+
+    if (messages.len != 0) {
+        std.log.warn("Shaderc:\n{s}", .{messages});
+    }
+
+    const data = result.data orelse return error.ShaderCompileError;
+    return try allocator.dupe(u8, data[0..result.size]);
+}
+
+fn toCStrings(arena: std.mem.Allocator, strings: ?[]const []const u8) ![]const [*:0]const u8 {
+    const in = strings orelse return &.{};
+
+    const out = try arena.alloc([*:0]const u8, in.len);
+    for (in, 0..) |str, idx| {
+        out[idx] = (try arena.dupeZ(u8, str)).ptr;
+    }
+    return out;
+}
+
+//
+// Batch compile
+//
+
+pub const CompileJob = struct {
+    varying: []const u8,
+    shader: []const u8,
+    options: ShadercOptions,
+};
+
+pub const CompileResult = struct {
+    // Compiled shader, caller is owner of memory.
+    data: ?[]u8 = null,
+    err: ?anyerror = null,
+};
+
+pub const BatchMode = enum {
+    // Spawn `shaderc` process per job.
+    process,
+    // Use `zbgfx_shaderc` library. GLSL/ESSL/HLSL/DXIL jobs are serialized inside library.
+    in_process,
+    // Use `ShadercServerPool`, each server compiles one job at time.
+    server,
+};
+
+pub const BatchOptions = struct {
+    mode: BatchMode = .process,
+    // Path to `shaderc` for `.process` mode.
+    executable_path: ?[]const u8 = null,
+    // Servers for `.server` mode.
+    server_pool: ?*ShadercServerPool = null,
+    // Max parallel compiles, null is CPU count.
+    thread_count: ?usize = null,
+
+    // Called as soon as job is done. Calls are serialized but come from worker threads.
+    on_complete: ?*const fn (context: ?*anyopaque, job_index: usize, result: *const CompileResult) void = null,
+    context: ?*anyopaque = null,
+};
+
+// Compile all jobs in parallel over worker pool. Result is per job in same order.
+// Allocator must be thread-safe. Caller is owner of memory (use `freeBatchResults`).
+pub fn compileShaderBatch(
+    allocator: std.mem.Allocator,
+    jobs: []const CompileJob,
+    options: BatchOptions,
+) ![]CompileResult {
+    if (options.mode == .process and options.executable_path == null) return error.MissingExecutablePath;
+    if (options.mode == .server and options.server_pool == null) return error.MissingServerPool;
+
+    const results = try allocator.alloc(CompileResult, jobs.len);
+    errdefer allocator.free(results);
+    @memset(results, .{});
+
+    var batch = Batch{
+        .allocator = allocator,
+        .jobs = jobs,
+        .results = results,
+        .options = options,
+    };
+
+    var pool: std.Thread.Pool = undefined;
+    try pool.init(.{ .allocator = allocator, .n_jobs = options.thread_count });
+    defer pool.deinit();
+
+    var wg: std.Thread.WaitGroup = .{};
+    for (0..jobs.len) |idx| {
+        pool.spawnWg(&wg, Batch.run, .{ &batch, idx });
+    }
+    pool.waitAndWork(&wg);
+
+    return results;
+}
+
+pub fn freeBatchResults(allocator: std.mem.Allocator, results: []CompileResult) void {
+    for (results) |result| {
+        if (result.data) |data| allocator.free(data);
+    }
+    allocator.free(results);
+}
+
+const Batch = struct {
+    allocator: std.mem.Allocator,
+    jobs: []const CompileJob,
+    results: []CompileResult,
+    options: BatchOptions,
+    complete_mutex: std.Thread.Mutex = .{},
+
+    fn run(batch: *Batch, idx: usize) void {
+        const job = batch.jobs[idx];
+        const result = &batch.results[idx];
+
+        const data = switch (batch.options.mode) {
+            .process => compileShader(batch.allocator, batch.options.executable_path.?, job.varying, job.shader, job.options),
+            .in_process => compileShaderInProcess(batch.allocator, job.varying, job.shader, job.options),
+            .server => batch.options.server_pool.?.compile(batch.allocator, job.varying, job.shader, job.options),
+        };
+
+        if (data) |d| {
+            result.data = d;
+        } else |err| {
+            result.err = err;
+        }
+
+        if (batch.options.on_complete) |on_complete| {
+            batch.complete_mutex.lock();
+            defer batch.complete_mutex.unlock();
+            on_complete(batch.options.context, idx, result);
+        }
+    }
+};
+
 pub fn shadercProcess(allocator: std.mem.Allocator, executablePath: []const u8, options: ShadercOptions) !std.process.Child {
     var args = ArgsList{};
     defer args.deinit(allocator);
     try args.append(allocator, executablePath);
 
-    try options.shaderType.appendArg(allocator, &args);
-    try options.platform.appendArg(allocator, &args);
-    try options.profile.appendArg(allocator, &args);
-    try options.optimizationLevel.appendArg(allocator, &args);
-
-    if (options.inputFilePath) |path| {
-        try args.appendSlice(allocator, &.{ "-f", path });
-    }
-
     if (options.outputFilePath) |path| {
         try args.appendSlice(allocator, &.{ "-o", path });
     } else {
@@ -381,19 +625,52 @@ pub fn shadercProcess(allocator: std.mem.Allocator, executablePath: []const u8,
         try args.appendSlice(allocator, &.{ "--varyingdef", path });
     }
 
+    var cache_max_size_buf: [20]u8 = undefined;
+    var all_defines = std.ArrayList(u8){};
+    defer all_defines.deinit(allocator);
+
+    try appendCompileArgs(allocator, &args, options, &cache_max_size_buf, &all_defines);
+
+    var process = std.process.Child.init(args.items, allocator);
+    process.stdout_behavior = .Pipe;
+    try process.spawn();
+    return process;
+}
+
+// Args shared by command line and server request. Strings are not copied, `cache_max_size_buf` and `all_defines` must outlive `args`.
+fn appendCompileArgs(
+    allocator: std.mem.Allocator,
+    args: *ArgsList,
+    options: ShadercOptions,
+    cache_max_size_buf: *[20]u8,
+    all_defines: *std.ArrayList(u8),
+) !void {
+    try options.shaderType.appendArg(allocator, args);
+    try options.platform.appendArg(allocator, args);
+    try options.profile.appendArg(allocator, args);
+    if (options.optimizationLevel) |level| {
+        try level.appendArg(allocator, args);
+    }
+
+    if (options.inputFilePath) |path| {
+        try args.appendSlice(allocator, &.{ "-f", path });
+    }
+
     if (options.keepcomments) {
         try args.appendSlice(allocator, &.{"--keepcomments"});
     }
 
+    if (options.cacheDir) |dir| {
+        const cache_max_size = try std.fmt.bufPrint(cache_max_size_buf, "{d}", .{options.cacheMaxSize >> 20});
+        try args.appendSlice(allocator, &.{ "--cache", dir, "--cache-max-size", cache_max_size });
+    }
+
     if (options.includeDirs) |includes| {
         for (includes) |include| {
             try args.appendSlice(allocator, &.{ "-i", include });
         }
     }
 
-    var all_defines = std.ArrayList(u8){};
-    defer all_defines.deinit(allocator);
-
     if (options.defines) |defines| {
         const last_idx = defines.len - 1;
 
@@ -406,16 +683,255 @@ pub fn shadercProcess(allocator: std.mem.Allocator, executablePath: []const u8,
 
         try args.appendSlice(allocator, &.{ "--define", all_defines.items });
     }
-
-    var process = std.process.Child.init(args.items, allocator);
-    process.stdout_behavior = .Pipe;
-    try process.spawn();
-    return process;
 }
 
+//
+// Compile server
+// Long running `shaderc --server` process. Requests and responses are framed over stdin/stdout, so there is no process
+// spawn and no temp files per shader.
+//
+
+const SERVER_REQUEST_MAGIC: u32 = 0x51434853; // 'SHCQ'
+const SERVER_RESPONSE_MAGIC: u32 = 0x41434853; // 'SHCA'
+
+pub const ShadercServer = struct {
+    allocator: std.mem.Allocator,
+    executable_path: []u8,
+    process: std.process.Child,
+    next_id: u32 = 0,
+    // Set after protocol error, pipe state is unknown so process is restarted before next request.
+    broken: bool = false,
+    // One request in flight per server.
+    mutex: std.Thread.Mutex = .{},
+
+    const Response = struct {
+        compiled: bool,
+        data: []u8,
+        messages: []u8,
+    };
+
+    pub fn init(allocator: std.mem.Allocator, executable_path: []const u8) !ShadercServer {
+        const path = try allocator.dupe(u8, executable_path);
+        errdefer allocator.free(path);
+
+        return .{
+            .allocator = allocator,
+            .executable_path = path,
+            .process = try spawnServer(allocator, path),
+        };
+    }
+
+    pub fn deinit(self: *ShadercServer) void {
+        // Server exits on EOF of stdin.
+        if (self.process.stdin) |stdin| {
+            stdin.close();
+            self.process.stdin = null;
+        }
+        _ = self.process.wait() catch undefined;
+        self.allocator.free(self.executable_path);
+    }
+
+    // Caller is owner of memory. Thread-safe, requests to same server are serialized.
+    pub fn compile(
+        self: *ShadercServer,
+        allocator: std.mem.Allocator,
+        varying: []const u8,
+        shader: []const u8,
+        options: ShadercOptions,
+    ) ![]u8 {
+        var args = ArgsList{};
+        defer args.deinit(allocator);
+
+        var cache_max_size_buf: [20]u8 = undefined;
+        var all_defines = std.ArrayList(u8){};
+        defer all_defines.deinit(allocator);
+
+        try appendCompileArgs(allocator, &args, options, &cache_max_size_buf, &all_defines);
+
+        var args_data = std.ArrayList(u8){};
+        defer args_data.deinit(allocator);
+        for (args.items) |arg| {
+            try args_data.appendSlice(allocator, arg);
+            try args_data.append(allocator, 0);
+        }
+
+        self.mutex.lock();
+        defer self.mutex.unlock();
+
+        // Server died or response was not fully read, restart it and retry once.
+        const response = self.request(allocator, args_data.items, varying, shader) catch retry: {
+            try self.restart();
+            break :retry try self.request(allocator, args_data.items, varying, shader);
+        };
+        defer allocator.free(response.messages);
+
+        if (!response.compiled) {
+            allocator.free(response.data);
+            std.log.err("Shaderc error:\n{s}", .{response.messages});
+            return error.ShaderCompileError;
+        }
+
+        if (response.messages.len != 0) {
+            std.log.warn("Shaderc:\n{s}", .{response.messages});
+        }
+
+        return response.data;
+    }
+
+    fn request(
+        self: *ShadercServer,
+        allocator: std.mem.Allocator,
+        args_data: []const u8,
+        varying: []const u8,
+        shader: []const u8,
+    ) !Response {
+        if (self.broken) try self.restart();
+        errdefer self.broken = true;
+
+        const id = self.next_id;
+        self.next_id +%= 1;
+
+        const stdin = self.process.stdin orelse return error.ServerClosed;
+        const stdout = self.process.stdout orelse return error.ServerClosed;
+
+        var header: [5 * @sizeOf(u32)]u8 = undefined;
+        std.mem.writeInt(u32, header[0..4], SERVER_REQUEST_MAGIC, .little);
+        std.mem.writeInt(u32, header[4..8], id, .little);
+        std.mem.writeInt(u32, header[8..12], @intCast(args_data.len), .little);
+        std.mem.writeInt(u32, header[12..16], @intCast(varying.len), .little);
+        std.mem.writeInt(u32, header[16..20], @intCast(shader.len), .little);
+
+        try stdin.writeAll(&header);
+        try stdin.writeAll(args_data);
+        try stdin.writeAll(varying);
+        try stdin.writeAll(shader);
+
+        var response: [5 * @sizeOf(u32)]u8 = undefined;
+        try readExact(stdout, &response);
+
+        if (std.mem.readInt(u32, response[0..4], .little) != SERVER_RESPONSE_MAGIC or
+            std.mem.readInt(u32, response[4..8], .little) != id)
+        {
+            return error.InvalidServerResponse;
+        }
+
+        const compiled = std.mem.readInt(u32, response[8..12], .little) != 0;
+        const shader_size = std.mem.readInt(u32, response[12..16], .little);
+        const messages_size = std.mem.readInt(u32, response[16..20], .little);
+
+        const data = try allocator.alloc(u8, shader_size);
+        errdefer allocator.free(data);
+        try readExact(stdout, data);
+
+        const messages = try allocator.alloc(u8, messages_size);
+        errdefer allocator.free(messages);
+        try readExact(stdout, messages);
+
+        return .{ .compiled = compiled, .data = data, .messages = messages };
+    }
+
+    fn restart(self: *ShadercServer) !void {
+        _ = self.process.kill() catch {
+            _ = self.process.wait() catch undefined;
+        };
+
+        self.process = try spawnServer(self.allocator, self.executable_path);
+        self.broken = false;
+    }
+
+    fn spawnServer(allocator: std.mem.Allocator, executable_path: []const u8) !std.process.Child {
+        var process = std.process.Child.init(&.{ executable_path, "--server" }, allocator);
+        process.stdin_behavior = .Pipe;
+        process.stdout_behavior = .Pipe;
+        try process.spawn();
+
+        return process;
+    }
+
+    fn readExact(file: std.fs.File, out: []u8) !void {
+        if (try file.readAll(out) != out.len) return error.ServerClosed;
+    }
+};
+
+// Multiple servers for parallel compile. Requests are spread round robin, dead server is restarted on its next request.
+pub const ShadercServerPool = struct {
+    allocator: std.mem.Allocator,
+    servers: []ShadercServer,
+    next: std.atomic.Value(usize) = .init(0),
+
+    // Count null is CPU count.
+    pub fn init(allocator: std.mem.Allocator, executable_path: []const u8, count: ?usize) !ShadercServerPool {
+        const n = count orelse (std.Thread.getCpuCount() catch 1);
+
+        const servers = try allocator.alloc(ShadercServer, @max(n, 1));
+        errdefer allocator.free(servers);
+
+        var started: usize = 0;
+        errdefer for (servers[0..started]) |*server| server.deinit();
+
+        for (servers) |*server| {
+            server.* = try ShadercServer.init(allocator, executable_path);
+            started += 1;
+        }
+
+        return .{ .allocator = allocator, .servers = servers };
+    }
+
+    pub fn deinit(self: *ShadercServerPool) void {
+        for (self.servers) |*server| server.deinit();
+        self.allocator.free(self.servers);
+    }
+
+    // Caller is owner of memory.
+    pub fn compile(
+        self: *ShadercServerPool,
+        allocator: std.mem.Allocator,
+        varying: []const u8,
+        shader: []const u8,
+        options: ShadercOptions,
+    ) ![]u8 {
+        const idx = self.next.fetchAdd(1, .monotonic) % self.servers.len;
+        return self.servers[idx].compile(allocator, varying, shader, options);
+    }
+};
+
 const RANDOM_BYTES_COUNT = 12;
 const RANDOM_PATH_LEN = std.fs.base64_encoder.calcSize(RANDOM_BYTES_COUNT);
 
+// Caller is owner of memory.
+fn writeInputFile(allocator: std.mem.Allocator, dir_path: []const u8, data: []const u8, content_name: bool) ![]u8 {
+    var random_name: [RANDOM_PATH_LEN]u8 = undefined;
+    generateRandomFileName(&random_name);
+
+    const random_path = try std.fs.path.join(allocator, &.{ dir_path, &random_name });
+
+    {
+        errdefer allocator.free(random_path);
+        const f = try std.fs.createFileAbsolute(random_path, .{});
+        errdefer std.fs.deleteFileAbsolute(random_path) catch undefined;
+        defer f.close();
+        try f.writeAll(data);
+    }
+
+    if (!content_name) return random_path;
+    defer allocator.free(random_path);
+
+    var name_buf: [20]u8 = undefined;
+    const name = std.fmt.bufPrint(&name_buf, "{x:0>16}.sc", .{std.hash.Wyhash.hash(0, data)}) catch unreachable;
+
+    const path = try std.fs.path.join(allocator, &.{ dir_path, name });
+    errdefer allocator.free(path);
+
+    // File is written under random name and renamed, so that compile of same shader in other process
+    // never reads partially written file.
+    std.fs.renameAbsolute(random_path, path) catch |err| {
+        std.fs.deleteFileAbsolute(random_path) catch undefined;
+        std.fs.accessAbsolute(path, .{}) catch return err;
+    };
+
+    return path;
+}
+
 fn generateRandomFileName(out: []u8) void {
     var in_random_bytes: [RANDOM_BYTES_COUNT]u8 = undefined;
     std.crypto.random.bytes(&in_random_bytes);
@@ -469,3 +985,41 @@ fn getSysTmpDir(a: std.mem.Allocator) ![]const u8 {
 
     return Impl.get(a);
 }
+
+//
+// Tests
+// Needs `zbgfx_shaderc` library, see `shaderc_tests` in build.zig.
+//
+
+const test_varying = "vec3 a_position : POSITION;\n";
+const test_shader = "$input a_position\nvoid main() { gl_Position = vec4(a_position, 1.0); }\n";
+
+test "compileShaderInProcess compiles vertex shader" {
+    const allocator = std.testing.allocator;
+
+    const data = try compileShaderInProcess(allocator, test_varying, test_shader, createDefaultOptionsForRenderer(.Vulkan));
+    defer allocator.free(data);
+
+    try std.testing.expect(std.mem.startsWith(u8, data, "VSH"));
+}
+
+test "compileShaderBatch in-process compiles concurrently" {
+    const allocator = std.testing.allocator;
+
+    var jobs: [8]CompileJob = undefined;
+    for (&jobs, 0..) |*job, idx| {
+        job.* = .{
+            .varying = test_varying,
+            .shader = test_shader,
+            .options = createDefaultOptionsForRenderer(if (idx % 2 == 0) .Vulkan else .OpenGL),
+        };
+    }
+
+    const results = try compileShaderBatch(allocator, &jobs, .{ .mode = .in_process, .thread_count = 4 });
+    defer freeBatchResults(allocator, results);
+
+    for (results) |result| {
+        try std.testing.expect(result.err == null);
+        try std.testing.expect(std.mem.startsWith(u8, result.data.?, "VSH"));
+    }
+}
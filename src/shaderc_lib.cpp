@@ -0,0 +1,202 @@
+#include <bx/bx.h>
+#include <bx/mutex.h>
+#include <bx/string.h>
+
+#include "shaderc.h"
+
+#if SHADERC_CONFIG_HAS_GLSLANG
+#include <ShaderLang.h>
+#endif
+
+#if BX_PLATFORM_WINDOWS
+#define ZBGFX_SHADERC_API __declspec(dllexport)
+#else
+#define ZBGFX_SHADERC_API __attribute__((visibility("default")))
+#endif
+
+namespace
+{
+    struct VectorWriter : public bx::WriterI
+    {
+        virtual int32_t write(const void *_data, int32_t _size, bx::Error *) override
+        {
+            const uint8_t *data = (const uint8_t *)_data;
+            m_data.insert(m_data.end(), data, data + _size);
+            return _size;
+        }
+
+        std::vector<uint8_t> m_data;
+    };
+
+    void initProcess()
+    {
+#if SHADERC_CONFIG_HAS_GLSLANG
+        // glslang process init is ref counted. Keep one reference for library lifetime so every compile does not
+        // init/finalize global glslang state again.
+        static const bool s_glslangInit = glslang::InitializeProcess();
+        BX_UNUSED(s_glslangInit);
+#endif
+    }
+
+    // glsl-optimizer (GLSL/ESSL) and d3dcompiler/dxc loaders (HLSL/DXIL) keep global state, so compiles for these
+    // profiles are serialized. glslang based backends (SPIR-V, Metal, WGSL) can run concurrently.
+    bx::Mutex s_serialMutex;
+
+    bool isConcurrentProfile(const bx::StringView &_profile)
+    {
+        return 0 == bx::strCmp(_profile, "spirv", 5) || 0 == bx::strCmp(_profile, "metal", 5) || 0 == bx::strCmp(_profile, "wgsl");
+    }
+
+    template <typename Ty>
+    Ty *copyOut(const std::vector<uint8_t> &_data, uint32_t _extra)
+    {
+        if (_data.empty() && 0 == _extra)
+        {
+            return NULL;
+        }
+
+        uint8_t *out = new uint8_t[_data.size() + _extra];
+        bx::memCopy(out, _data.data(), uint32_t(_data.size()));
+        bx::memSet(&out[_data.size()], 0, _extra);
+        return (Ty *)out;
+    }
+}
+
+extern "C"
+{
+    struct zbgfx_ShadercOptions
+    {
+        char shaderType;
+        const char *platform;
+        const char *profile;
+        const char *inputFilePath;
+
+        const char *const *includeDirs;
+        uint32_t numIncludeDirs;
+        const char *const *defines;
+        uint32_t numDefines;
+
+        uint32_t optimizationLevel;
+        bool optimize;
+        bool keepComments;
+        bool debugInformation;
+        bool warningsAreErrors;
+
+        const char *cacheDir;
+        uint64_t cacheMaxSize;
+    };
+
+    struct zbgfx_ShadercCacheStats
+    {
+        uint32_t hits;
+        uint32_t misses;
+        uint32_t stores;
+        uint32_t evictions;
+    };
+
+    struct zbgfx_ShadercResult
+    {
+        uint8_t *data;
+        uint32_t size;
+        char *messages;
+        uint32_t messagesSize;
+    };
+
+    ZBGFX_SHADERC_API bool zbgfx_shadercCompile(const zbgfx_ShadercOptions *_options, const char *_varying, uint32_t _varyingLen, const char *_source, uint32_t _sourceLen, zbgfx_ShadercResult *_result)
+    {
+        bx::memSet(_result, 0, sizeof(zbgfx_ShadercResult));
+
+        initProcess();
+
+        bgfx::Options options;
+        options.shaderType = bx::toLower(_options->shaderType);
+        options.platform = NULL != _options->platform ? _options->platform : "";
+        options.profile = NULL != _options->profile ? _options->profile : "";
+        options.inputFilePath = NULL != _options->inputFilePath ? _options->inputFilePath : "memory.sc";
+
+        for (uint32_t ii = 0; ii < _options->numIncludeDirs; ++ii)
+        {
+            options.includeDirs.push_back(_options->includeDirs[ii]);
+        }
+
+        for (uint32_t ii = 0; ii < _options->numDefines; ++ii)
+        {
+            options.defines.push_back(_options->defines[ii]);
+        }
+
+        // Same as `-O <level>` on command line, without it D3D compilers skip optimization.
+        options.optimize = _options->optimize;
+        options.optimizationLevel = _options->optimizationLevel;
+        options.keepComments = _options->keepComments;
+        options.debugInformation = _options->debugInformation;
+        options.warningsAreErrors = _options->warningsAreErrors;
+
+        if (NULL != _options->cacheDir)
+        {
+            options.cacheDir = _options->cacheDir;
+            options.cacheMaxSize = _options->cacheMaxSize;
+        }
+
+        // compileShader take ownership of source buffer.
+        uint32_t size = _sourceLen;
+        char *source = bgfx::allocShaderSource(_source, size);
+
+        std::string varying;
+        if ('c' != options.shaderType && NULL != _varying)
+        {
+            varying.assign(_varying, _varyingLen);
+        }
+
+        VectorWriter shaderWriter;
+        VectorWriter messageWriter;
+
+        const bool concurrent = isConcurrentProfile(options.profile.c_str());
+        if (!concurrent)
+        {
+            s_serialMutex.lock();
+        }
+
+        const bool compiled = bgfx::compileShaderCached(
+            varying.empty() ? NULL : varying.c_str(),
+            "",
+            source,
+            size,
+            options,
+            &shaderWriter,
+            &messageWriter);
+
+        if (!concurrent)
+        {
+            s_serialMutex.unlock();
+        }
+
+        if (compiled)
+        {
+            _result->data = copyOut<uint8_t>(shaderWriter.m_data, 0);
+            _result->size = uint32_t(shaderWriter.m_data.size());
+        }
+
+        _result->messages = copyOut<char>(messageWriter.m_data, 1);
+        _result->messagesSize = uint32_t(messageWriter.m_data.size());
+
+        return compiled;
+    }
+
+    ZBGFX_SHADERC_API void zbgfx_shadercGetCacheStats(zbgfx_ShadercCacheStats *_stats)
+    {
+        bgfx::ShaderCacheStats stats;
+        bgfx::getShaderCacheStats(stats);
+
+        _stats->hits = stats.hits;
+        _stats->misses = stats.misses;
+        _stats->stores = stats.stores;
+        _stats->evictions = stats.evictions;
+    }
+
+    ZBGFX_SHADERC_API void zbgfx_shadercFree(zbgfx_ShadercResult *_result)
+    {
+        delete[] _result->data;
+        delete[] (uint8_t *)_result->messages;
+        bx::memSet(_result, 0, sizeof(zbgfx_ShadercResult));
+    }
+}
@@ -1,8 +1,49 @@
 #include <bx/bx.h>
+#include <bx/allocator.h>
 #include <bx/string.h>
 
+#include <bimg/bimg.h>
+
 #include "../libs/bgfx/examples/common/debugdraw/debugdraw.h"
 
+namespace
+{
+    // Same layout as `bgfx_allocator_interface_t` from bgfx/c99/bgfx.h, which can't be included next to
+    // C++ bgfx.h (both define BGFX_INVALID_HANDLE).
+    struct AllocatorInterfaceC;
+
+    struct AllocatorVtblC
+    {
+        void *(*realloc)(AllocatorInterfaceC *_this, void *_ptr, size_t _size, size_t _align, const char *_file, uint32_t _line);
+    };
+
+    struct AllocatorInterfaceC
+    {
+        const AllocatorVtblC *vtbl;
+    };
+
+    // Wraps C allocator interface (callbacks.ZigAllocator) for C++ APIs that take bx::AllocatorI.
+    class AllocatorC : public bx::AllocatorI
+    {
+    public:
+        virtual ~AllocatorC()
+        {
+        }
+
+        virtual void *realloc(void *_ptr, size_t _size, size_t _align, const char *_file, uint32_t _line) override
+        {
+            return m_interface->vtbl->realloc(m_interface, _ptr, _size, _align, _file, _line);
+        }
+
+        AllocatorInterfaceC *m_interface;
+    };
+
+    AllocatorC s_ddAllocator;
+
+    bx::DefaultAllocator s_jobAllocator;
+    bimg::JobSchedulerI *s_jobScheduler = NULL;
+}
+
 extern "C"
 {
     int32_t formatTrace(char *buff, uint32_t buff_size, const char *_format, va_list _argList)
@@ -13,6 +54,27 @@ extern "C"
         return total;
     }
 
+    //
+    // Image
+    //
+    bool zbgfx_bimgInitJobScheduler(uint32_t _numThreads)
+    {
+        if (NULL == s_jobScheduler)
+        {
+            s_jobScheduler = bimg::createJobScheduler(&s_jobAllocator, _numThreads);
+            bimg::setJobScheduler(s_jobScheduler);
+        }
+
+        return NULL != s_jobScheduler;
+    }
+
+    void zbgfx_bimgShutdownJobScheduler()
+    {
+        bimg::setJobScheduler(NULL);
+        bimg::destroyJobScheduler(s_jobScheduler);
+        s_jobScheduler = NULL;
+    }
+
     //
     // Debug draw
     //
@@ -21,6 +83,12 @@ extern "C"
         ddInit();
     }
 
+    void zbgfx_ddInitAllocator(AllocatorInterfaceC *_allocator)
+    {
+        s_ddAllocator.m_interface = _allocator;
+        ddInit(&s_ddAllocator);
+    }
+
     void zbgfx_ddShutdown()
     {
         ddShutdown();
@@ -4,6 +4,11 @@ pub const bgfx = @import("bgfx");
 pub const build = @import("build_step.zig");
 pub const callbacks = @import("callbacks.zig");
 pub const shaderc = @import("shaderc.zig");
+pub const bimg = @import("bimg.zig");
 
 pub const debugdraw = @import("debugdraw.zig");
 pub const imgui_backend = @import("backend_bgfx.zig");
+
+test {
+    _ = callbacks;
+}
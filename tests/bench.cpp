@@ -0,0 +1,54 @@
+#include "bench.h"
+
+#include <bx/string.h>
+#include <bx/timer.h>
+
+#include <stdarg.h>
+#include <stdio.h>
+
+namespace bench
+{
+    static Benchmark *s_benchmarks = NULL;
+
+    Benchmark::Benchmark(const char *_name, BenchmarkFn _fn)
+        : name(_name)
+        , fn(_fn)
+        , next(s_benchmarks)
+    {
+        s_benchmarks = this;
+    }
+
+    void report(const char *_name, double _nsPerOp, const char *_format, ...)
+    {
+        char extra[256];
+
+        va_list argList;
+        va_start(argList, _format);
+        bx::vsnprintf(extra, sizeof(extra), _format, argList);
+        va_end(argList);
+
+        printf("%-48s %12.1f ns/op  %s\n", _name, _nsPerOp, extra);
+    }
+
+    double elapsedNs(int64_t _start)
+    {
+        return double(bx::getHPCounter() - _start) * 1e9 / double(bx::getHPFrequency());
+    }
+
+} // namespace bench
+
+int main(int _argc, const char *_argv[])
+{
+    const bx::StringView filter = 1 < _argc ? bx::StringView(_argv[1]) : bx::StringView();
+
+    for (bench::Benchmark *benchmark = bench::s_benchmarks; NULL != benchmark; benchmark = benchmark->next)
+    {
+        if (filter.isEmpty()
+        ||  0 == bx::strCmp(benchmark->name, filter, filter.getLength()))
+        {
+            benchmark->fn();
+        }
+    }
+
+    return bx::kExitSuccess;
+}
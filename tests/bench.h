@@ -0,0 +1,34 @@
+#pragma once
+
+#include <bx/bx.h>
+#include <bx/macros.h>
+
+// Minimal harness for benchmarks run by `zig build bench`. Benchmarks register themselves at static
+// initialization and print their own results. Pass benchmark name prefix to run only some of them.
+namespace bench
+{
+    typedef void (*BenchmarkFn)();
+
+    struct Benchmark
+    {
+        Benchmark(const char *_name, BenchmarkFn _fn);
+
+        const char *name;
+        BenchmarkFn fn;
+        Benchmark *next;
+    };
+
+    /// Prints one result line, _nsPerOp is average time of single operation in nanoseconds.
+    void report(const char *_name, double _nsPerOp, const char *_format = "", ...);
+
+    /// Returns elapsed time in nanoseconds since _start counter value.
+    double elapsedNs(int64_t _start);
+
+} // namespace bench
+
+#define BENCHMARK_IMPL(_fn, _name)                                \
+    static void _fn();                                            \
+    static bench::Benchmark BX_CONCATENATE(_fn, Bench)(_name, _fn); \
+    static void _fn()
+
+#define BENCHMARK(_name) BENCHMARK_IMPL(BX_CONCATENATE(benchmark, __LINE__), _name)
@@ -0,0 +1,162 @@
+#include "bench.h"
+
+#include <bgfx/bgfx.h>
+#include <bx/math.h>
+#include <bx/timer.h>
+
+#include "debugdraw/debugdraw.h"
+
+namespace
+{
+    struct Shape
+    {
+        enum Enum
+        {
+            Sphere,
+            Cylinder,
+            Cone,
+            Aabb,
+            WireframeAabb,
+
+            Count,
+            Mixed = Count,
+        };
+    };
+
+    void drawShape(DebugDrawEncoder &_dde, Shape::Enum _shape, uint32_t _index)
+    {
+        const float x = float(_index % 100);
+        const float z = float(_index / 100);
+
+        switch (_shape)
+        {
+        case Shape::Sphere:
+        {
+            const bx::Sphere sphere = {{x, 0.0f, z}, 0.4f};
+            _dde.draw(sphere);
+        }
+        break;
+
+        case Shape::Cylinder:
+        {
+            const bx::Cylinder cylinder = {{x, 0.0f, z}, {x, 1.0f, z}, 0.3f};
+            _dde.draw(cylinder);
+        }
+        break;
+
+        case Shape::Cone:
+            _dde.drawCone(bx::Vec3{x, 0.0f, z}, bx::Vec3{x, 1.0f, z}, 0.3f);
+            break;
+
+        case Shape::Aabb:
+        {
+            const bx::Aabb aabb = {{x, 0.0f, z}, {x + 0.5f, 0.5f, z + 0.5f}};
+            _dde.draw(aabb);
+        }
+        break;
+
+        default:
+        {
+            // Transform changes used to break batch of lines.
+            float mtx[16];
+            bx::mtxTranslate(mtx, x, 0.0f, z);
+
+            _dde.pushTransform(mtx);
+            _dde.setWireframe(true);
+            const bx::Aabb aabb = {{0.0f, 0.0f, 0.0f}, {0.5f, 0.5f, 0.5f}};
+            _dde.draw(aabb);
+            _dde.setWireframe(false);
+            _dde.popTransform();
+        }
+        break;
+        }
+    }
+
+    // Draws 10K debug shapes per frame, the way physics visualization does, and reports CPU time
+    // spent in debugdraw per shape and number of draw calls it submits per frame. Noop renderer counts
+    // draw calls only when built with `-Dnoop_walk_frame=true`.
+    void debugDrawShapes(const char *_name, Shape::Enum _shape)
+    {
+        bgfx::Init init;
+        init.type = bgfx::RendererType::Noop;
+        init.resolution.width = 64;
+        init.resolution.height = 64;
+        init.limits.maxTransientVbSize = 32 << 20;
+
+        if (!bgfx::init(init))
+        {
+            return;
+        }
+
+        ddInit();
+
+        const uint32_t numFrames = 40;
+        const uint32_t numWarmupFrames = 10;
+        const uint32_t numShapes = 10000;
+
+        uint32_t numOps = 0;
+        uint32_t numDraws = 0;
+        double ns = 0.0;
+
+        for (uint32_t frame = 0; frame < numFrames; ++frame)
+        {
+            const int64_t start = bx::getHPCounter();
+
+            DebugDrawEncoder dde;
+            dde.begin(0);
+            dde.setLod(2);
+
+            for (uint32_t ii = 0; ii < numShapes; ++ii)
+            {
+                drawShape(dde, Shape::Mixed == _shape ? Shape::Enum(ii % Shape::Count) : _shape, ii);
+            }
+
+            dde.end();
+
+            if (numWarmupFrames <= frame)
+            {
+                ns += bench::elapsedNs(start);
+                numOps += numShapes;
+            }
+
+            bgfx::frame();
+
+            numDraws = bgfx::getStats()->numDraw;
+        }
+
+        bench::report(_name, ns / numOps, "%u draws per %u shapes", numDraws, numShapes);
+
+        ddShutdown();
+        bgfx::shutdown();
+    }
+} // namespace
+
+BENCHMARK("debugdraw 10K shapes, mixed")
+{
+    debugDrawShapes("debugdraw 10K shapes, mixed", Shape::Mixed);
+}
+
+BENCHMARK("debugdraw 10K shapes, sphere")
+{
+    debugDrawShapes("debugdraw 10K shapes, sphere", Shape::Sphere);
+}
+
+BENCHMARK("debugdraw 10K shapes, cylinder")
+{
+    debugDrawShapes("debugdraw 10K shapes, cylinder", Shape::Cylinder);
+}
+
+BENCHMARK("debugdraw 10K shapes, cone")
+{
+    debugDrawShapes("debugdraw 10K shapes, cone", Shape::Cone);
+}
+
+BENCHMARK("debugdraw 10K shapes, aabb")
+{
+    debugDrawShapes("debugdraw 10K shapes, aabb", Shape::Aabb);
+}
+
+BENCHMARK("debugdraw 10K shapes, wireframe aabb with transform")
+{
+    debugDrawShapes("debugdraw 10K shapes, wireframe aabb with transform", Shape::WireframeAabb);
+}
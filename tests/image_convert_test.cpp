@@ -0,0 +1,168 @@
+#include <bimg/bimg.h>
+#include <bx/allocator.h>
+#include <bx/math.h>
+#include <bx/rng.h>
+
+#include "test.h"
+
+namespace
+{
+    const uint32_t kMaxWidth = 16384;
+
+    struct ConvertPair
+    {
+        bimg::TextureFormat::Enum dstFormat;
+        bimg::TextureFormat::Enum srcFormat;
+    };
+
+    // Pairs with fast path in imageConvert.
+    const ConvertPair s_convertPairs[] =
+    {
+        { bimg::TextureFormat::BGRA8,   bimg::TextureFormat::RGBA8   },
+        { bimg::TextureFormat::RGBA8,   bimg::TextureFormat::BGRA8   },
+        { bimg::TextureFormat::RGBA8,   bimg::TextureFormat::R8      },
+        { bimg::TextureFormat::R8,      bimg::TextureFormat::RGBA8   },
+        { bimg::TextureFormat::RGBA32F, bimg::TextureFormat::RGBA8   },
+        { bimg::TextureFormat::RGBA8,   bimg::TextureFormat::RGBA32F },
+        { bimg::TextureFormat::BGRA8,   bimg::TextureFormat::RGBA32F },
+        { bimg::TextureFormat::RGBA16F, bimg::TextureFormat::RGBA8   },
+        { bimg::TextureFormat::RGBA8,   bimg::TextureFormat::RGBA16F },
+        { bimg::TextureFormat::RGBA32F, bimg::TextureFormat::RGBA16F },
+        { bimg::TextureFormat::RGBA16F, bimg::TextureFormat::RGBA32F },
+        { bimg::TextureFormat::RGB10A2, bimg::TextureFormat::RGBA8   },
+        { bimg::TextureFormat::RGBA8,   bimg::TextureFormat::RGB10A2 },
+        { bimg::TextureFormat::RGB10A2, bimg::TextureFormat::RGBA32F },
+        { bimg::TextureFormat::RGBA32F, bimg::TextureFormat::RGB10A2 },
+    };
+
+    // Fills source row with every value of each channel, and for float source with values around
+    // rounding boundaries of every 8 and 10 bit step. Returns row width in pixels.
+    uint32_t fillSource(void *_src, bimg::TextureFormat::Enum _format)
+    {
+        switch (_format)
+        {
+        case bimg::TextureFormat::R8:
+        {
+            uint8_t *src = (uint8_t *)_src;
+            for (uint32_t ii = 0; ii < 256; ++ii)
+            {
+                src[ii] = uint8_t(ii);
+            }
+
+            return 256;
+        }
+
+        case bimg::TextureFormat::RGBA8:
+        case bimg::TextureFormat::BGRA8:
+        {
+            uint8_t *src = (uint8_t *)_src;
+            for (uint32_t ii = 0; ii < 256; ++ii)
+            {
+                src[ii * 4 + 0] = uint8_t(ii);
+                src[ii * 4 + 1] = uint8_t(255 - ii);
+                src[ii * 4 + 2] = uint8_t(ii * 7);
+                src[ii * 4 + 3] = uint8_t(ii * 13);
+            }
+
+            return 256;
+        }
+
+        case bimg::TextureFormat::RGBA16F:
+        {
+            // Every half value including denormals and infinities. Library is built with fast
+            // math, so NaNs don't convert to unorm consistently even in generic path.
+            uint16_t *src = (uint16_t *)_src;
+            for (uint32_t ii = 0; ii < 65536; ++ii)
+            {
+                const bool nan = 0x7c00 == (ii & 0x7c00) && 0 != (ii & 0x3ff);
+                src[ii] = nan ? 0 : uint16_t(ii);
+            }
+
+            return 65536 / 4;
+        }
+
+        case bimg::TextureFormat::RGB10A2:
+        {
+            uint32_t *src = (uint32_t *)_src;
+            for (uint32_t ii = 0; ii < 1024; ++ii)
+            {
+                src[ii] = ii | ((1023 - ii) << 10) | (((ii * 7) & 1023) << 20) | (ii << 30);
+            }
+
+            return 1024;
+        }
+
+        case bimg::TextureFormat::RGBA32F:
+        {
+            // NaNs and infinities are left out, see above.
+            const float edges[] = {-1e30f, -2.0f, -1.0f, -1e-30f, -0.0f, 0.0f, 1e-30f, 0.25f, 0.5f, 1.0f, 1.5f, 2.0f, 1e30f};
+
+            float *src = (float *)_src;
+            uint32_t num = 0;
+
+            for (uint32_t ii = 0; ii < BX_COUNTOF(edges); ++ii)
+            {
+                src[num++] = edges[ii];
+            }
+
+            const float scales[] = {3.0f, 255.0f, 1023.0f};
+            for (uint32_t ii = 0; ii < BX_COUNTOF(scales); ++ii)
+            {
+                for (uint32_t step = 0; step <= uint32_t(scales[ii]); ++step)
+                {
+                    const float value = float(step) / scales[ii];
+                    const float half = (float(step) + 0.5f) / scales[ii];
+
+                    src[num++] = value;
+                    src[num++] = half;
+                    src[num++] = bx::bitsToFloat(bx::floatToBits(half) - 1);
+                    src[num++] = bx::bitsToFloat(bx::floatToBits(half) + 1);
+                }
+            }
+
+            bx::RngMwc rng;
+            while (0 != num % 4 || num < 4 * 4096)
+            {
+                src[num++] = bx::frnd(&rng) * 1.2f - 0.1f;
+            }
+
+            return num / 4;
+        }
+
+        default:
+            break;
+        }
+
+        return 0;
+    }
+} // namespace
+
+TEST_CASE("Image convert fast paths match generic unpack/pack path")
+{
+    bx::DefaultAllocator allocator;
+
+    static uint8_t s_src[kMaxWidth * 16];
+    static uint8_t s_fast[kMaxWidth * 16];
+    static uint8_t s_generic[kMaxWidth * 16];
+
+    for (uint32_t ii = 0; ii < BX_COUNTOF(s_convertPairs); ++ii)
+    {
+        const ConvertPair &pair = s_convertPairs[ii];
+
+        const uint32_t width = fillSource(s_src, pair.srcFormat);
+        REQUIRE(0 < width && width <= kMaxWidth);
+
+        const uint32_t srcBpp = bimg::getBitsPerPixel(pair.srcFormat);
+        const uint32_t dstBpp = bimg::getBitsPerPixel(pair.dstFormat);
+        const uint32_t dstSize = width * dstBpp / 8;
+
+        bx::memSet(s_fast, 0xcd, dstSize);
+        bx::memSet(s_generic, 0xcd, dstSize);
+
+        REQUIRE(bimg::imageConvert(&allocator, s_fast, pair.dstFormat, s_src, pair.srcFormat, width, 1, 1));
+
+        bimg::imageConvert(s_generic, dstBpp, bimg::getPack(pair.dstFormat), s_src, srcBpp, bimg::getUnpack(pair.srcFormat), width, 1, 1, width * srcBpp / 8, dstSize);
+
+        REQUIRE(0 == bx::memCmp(s_fast, s_generic, dstSize));
+    }
+}
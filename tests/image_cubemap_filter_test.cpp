@@ -0,0 +1,64 @@
+#include <bimg/bimg.h>
+#include <bimg/encode.h>
+#include <bx/allocator.h>
+#include <bx/rng.h>
+
+#include "test.h"
+
+namespace
+{
+    bimg::ImageContainer *createCubemap(bx::AllocatorI *_allocator, uint16_t _size)
+    {
+        bimg::ImageContainer *image = bimg::imageAlloc(_allocator, bimg::TextureFormat::RGBA8, _size, _size, 1, 1, true, false);
+
+        bx::RngMwc rng;
+        uint8_t *data = (uint8_t *)image->m_data;
+        for (uint32_t ii = 0; ii < image->m_size; ++ii)
+        {
+            data[ii] = uint8_t(rng.gen() >> 8);
+        }
+
+        return image;
+    }
+} // namespace
+
+TEST_CASE("Cubemap radiance filter on job scheduler matches filter on calling thread")
+{
+    bx::DefaultAllocator allocator;
+
+    bimg::ImageContainer *input = createCubemap(&allocator, 16);
+
+    bimg::JobSchedulerI *jobScheduler = bimg::createJobScheduler(&allocator, 4);
+    REQUIRE(NULL != jobScheduler);
+
+    const bimg::LightingModel::Enum lightingModels[] =
+    {
+        bimg::LightingModel::Phong,
+        bimg::LightingModel::Ggx,
+    };
+
+    bool same = true;
+
+    for (uint32_t ii = 0; ii < BX_COUNTOF(lightingModels); ++ii)
+    {
+        bimg::setJobScheduler(NULL);
+        bimg::ImageContainer *serial = bimg::imageCubemapRadianceFilter(&allocator, *input, lightingModels[ii], NULL);
+
+        bimg::setJobScheduler(jobScheduler);
+        bimg::ImageContainer *threaded = bimg::imageCubemapRadianceFilter(&allocator, *input, lightingModels[ii], NULL);
+
+        same = same
+            && serial->m_size == threaded->m_size
+            && 1 < serial->m_numMips
+            && 0 == bx::memCmp(serial->m_data, threaded->m_data, serial->m_size);
+
+        bimg::imageFree(serial);
+        bimg::imageFree(threaded);
+    }
+
+    bimg::setJobScheduler(NULL);
+    bimg::destroyJobScheduler(jobScheduler);
+    bimg::imageFree(input);
+
+    REQUIRE(same);
+}
@@ -0,0 +1,314 @@
+#include <bimg/bimg.h>
+#include <bx/allocator.h>
+#include <bx/math.h>
+#include <bx/rng.h>
+
+#include "test.h"
+
+namespace
+{
+    const uint32_t kWidth = 64;
+    const uint32_t kHeight = 64;
+
+    // Reference block decoders, as they were before BC1, BC3, BC4 and BC5 got direct BGRA8 decoders.
+    uint8_t bitRangeConvert(uint32_t _in, uint32_t _from, uint32_t _to)
+    {
+        const uint32_t tmp0 = 1 << _to;
+        const uint32_t tmp1 = 1 << _from;
+        const uint32_t tmp5 = (tmp1 - 1) + _in * (tmp0 - 1);
+        return uint8_t((tmp5 + (tmp5 >> _from)) >> _from);
+    }
+
+    void refDecodeBlockDxt(uint8_t _dst[16 * 4], const uint8_t _src[8])
+    {
+        uint8_t colors[4 * 3];
+
+        const uint32_t c0 = _src[0] | (_src[1] << 8);
+        colors[0] = bitRangeConvert((c0 >> 0) & 0x1f, 5, 8);
+        colors[1] = bitRangeConvert((c0 >> 5) & 0x3f, 6, 8);
+        colors[2] = bitRangeConvert((c0 >> 11) & 0x1f, 5, 8);
+
+        const uint32_t c1 = _src[2] | (_src[3] << 8);
+        colors[3] = bitRangeConvert((c1 >> 0) & 0x1f, 5, 8);
+        colors[4] = bitRangeConvert((c1 >> 5) & 0x3f, 6, 8);
+        colors[5] = bitRangeConvert((c1 >> 11) & 0x1f, 5, 8);
+
+        colors[6] = (2 * colors[0] + colors[3]) / 3;
+        colors[7] = (2 * colors[1] + colors[4]) / 3;
+        colors[8] = (2 * colors[2] + colors[5]) / 3;
+
+        colors[9] = (colors[0] + 2 * colors[3]) / 3;
+        colors[10] = (colors[1] + 2 * colors[4]) / 3;
+        colors[11] = (colors[2] + 2 * colors[5]) / 3;
+
+        for (uint32_t ii = 0, next = 8 * 4; ii < 16 * 4; ii += 4, next += 2)
+        {
+            const int idx = ((_src[next >> 3] >> (next & 7)) & 3) * 3;
+            _dst[ii + 0] = colors[idx + 0];
+            _dst[ii + 1] = colors[idx + 1];
+            _dst[ii + 2] = colors[idx + 2];
+        }
+    }
+
+    void refDecodeBlockDxt1(uint8_t _dst[16 * 4], const uint8_t _src[8])
+    {
+        uint8_t colors[4 * 4];
+
+        const uint32_t c0 = _src[0] | (_src[1] << 8);
+        colors[0] = bitRangeConvert((c0 >> 0) & 0x1f, 5, 8);
+        colors[1] = bitRangeConvert((c0 >> 5) & 0x3f, 6, 8);
+        colors[2] = bitRangeConvert((c0 >> 11) & 0x1f, 5, 8);
+        colors[3] = 255;
+
+        const uint32_t c1 = _src[2] | (_src[3] << 8);
+        colors[4] = bitRangeConvert((c1 >> 0) & 0x1f, 5, 8);
+        colors[5] = bitRangeConvert((c1 >> 5) & 0x3f, 6, 8);
+        colors[6] = bitRangeConvert((c1 >> 11) & 0x1f, 5, 8);
+        colors[7] = 255;
+
+        if (c0 > c1)
+        {
+            colors[8] = (2 * colors[0] + colors[4]) / 3;
+            colors[9] = (2 * colors[1] + colors[5]) / 3;
+            colors[10] = (2 * colors[2] + colors[6]) / 3;
+            colors[11] = 255;
+
+            colors[12] = (colors[0] + 2 * colors[4]) / 3;
+            colors[13] = (colors[1] + 2 * colors[5]) / 3;
+            colors[14] = (colors[2] + 2 * colors[6]) / 3;
+            colors[15] = 255;
+        }
+        else
+        {
+            colors[8] = (colors[0] + colors[4]) / 2;
+            colors[9] = (colors[1] + colors[5]) / 2;
+            colors[10] = (colors[2] + colors[6]) / 2;
+            colors[11] = 255;
+
+            colors[12] = 0;
+            colors[13] = 0;
+            colors[14] = 0;
+            colors[15] = 0;
+        }
+
+        for (uint32_t ii = 0, next = 8 * 4; ii < 16 * 4; ii += 4, next += 2)
+        {
+            const int idx = ((_src[next >> 3] >> (next & 7)) & 3) * 4;
+            _dst[ii + 0] = colors[idx + 0];
+            _dst[ii + 1] = colors[idx + 1];
+            _dst[ii + 2] = colors[idx + 2];
+            _dst[ii + 3] = colors[idx + 3];
+        }
+    }
+
+    void refDecodeBlockDxt45A(uint8_t _dst[16 * 4], const uint8_t _src[8])
+    {
+        uint8_t alpha[8];
+        alpha[0] = _src[0];
+        alpha[1] = _src[1];
+
+        if (alpha[0] > alpha[1])
+        {
+            alpha[2] = (6 * alpha[0] + 1 * alpha[1]) / 7;
+            alpha[3] = (5 * alpha[0] + 2 * alpha[1]) / 7;
+            alpha[4] = (4 * alpha[0] + 3 * alpha[1]) / 7;
+            alpha[5] = (3 * alpha[0] + 4 * alpha[1]) / 7;
+            alpha[6] = (2 * alpha[0] + 5 * alpha[1]) / 7;
+            alpha[7] = (1 * alpha[0] + 6 * alpha[1]) / 7;
+        }
+        else
+        {
+            alpha[2] = (4 * alpha[0] + 1 * alpha[1]) / 5;
+            alpha[3] = (3 * alpha[0] + 2 * alpha[1]) / 5;
+            alpha[4] = (2 * alpha[0] + 3 * alpha[1]) / 5;
+            alpha[5] = (1 * alpha[0] + 4 * alpha[1]) / 5;
+            alpha[6] = 0;
+            alpha[7] = 255;
+        }
+
+        uint32_t idx0 = _src[2];
+        uint32_t idx1 = _src[5];
+        idx0 |= uint32_t(_src[3]) << 8;
+        idx1 |= uint32_t(_src[6]) << 8;
+        idx0 |= uint32_t(_src[4]) << 16;
+        idx1 |= uint32_t(_src[7]) << 16;
+        for (uint32_t ii = 0; ii < 8 * 4; ii += 4)
+        {
+            _dst[ii] = alpha[idx0 & 7];
+            _dst[ii + 32] = alpha[idx1 & 7];
+            idx0 >>= 3;
+            idx1 >>= 3;
+        }
+    }
+
+    // Decodes one block into BGRA8 the way previous decoder did, and returns mask of channels that
+    // must match. Channels previous decoder left uninitialized, or that changed on purpose, are
+    // excluded from mask. Those are:
+    // - BC4 green, red and alpha, which are now 0, 0 and 255.
+    // - BC5 blue outside of unit circle, which was NaN converted to integer and is now 0.
+    void refDecodeBlock(uint8_t _dst[16 * 4], uint8_t _mask[16 * 4], const uint8_t *_src, bimg::TextureFormat::Enum _format)
+    {
+        bx::memSet(_dst, 0, 16 * 4);
+        bx::memSet(_mask, 0xff, 16 * 4);
+
+        switch (_format)
+        {
+        case bimg::TextureFormat::BC1:
+            refDecodeBlockDxt1(_dst, _src);
+            break;
+
+        case bimg::TextureFormat::BC3:
+            refDecodeBlockDxt45A(_dst + 3, _src);
+            refDecodeBlockDxt(_dst, _src + 8);
+            break;
+
+        case bimg::TextureFormat::BC4:
+            refDecodeBlockDxt45A(_dst, _src);
+
+            for (uint32_t ii = 0; ii < 16; ++ii)
+            {
+                bx::memSet(&_mask[ii * 4 + 1], 0, 3);
+            }
+            break;
+
+        case bimg::TextureFormat::BC5:
+            refDecodeBlockDxt45A(_dst + 2, _src);
+            refDecodeBlockDxt45A(_dst + 1, _src + 8);
+
+            for (uint32_t ii = 0; ii < 16; ++ii)
+            {
+                const float nx = _dst[ii * 4 + 2] * 2.0f / 255.0f - 1.0f;
+                const float ny = _dst[ii * 4 + 1] * 2.0f / 255.0f - 1.0f;
+                const float nzz = 1.0f - nx * nx - ny * ny;
+
+                if (0.0f <= nzz)
+                {
+                    _dst[ii * 4 + 0] = uint8_t((bx::sqrt(nzz) + 1.0f) * 255.0f / 2.0f);
+                }
+                else
+                {
+                    _mask[ii * 4 + 0] = 0;
+                }
+
+                _dst[ii * 4 + 3] = 0;
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    // Random blocks cover both palette modes of color and alpha blocks, since each block picks
+    // its mode by comparing its endpoints.
+    void fillBlocks(uint8_t *_dst, uint32_t _size)
+    {
+        bx::RngMwc rng;
+
+        for (uint32_t ii = 0; ii < _size; ++ii)
+        {
+            _dst[ii] = uint8_t(rng.gen() >> 8);
+        }
+    }
+
+    const bimg::TextureFormat::Enum s_formats[] =
+    {
+        bimg::TextureFormat::BC1,
+        bimg::TextureFormat::BC3,
+        bimg::TextureFormat::BC4,
+        bimg::TextureFormat::BC5,
+    };
+} // namespace
+
+TEST_CASE("Image decode of BC1, BC3, BC4 and BC5 matches previous decoder")
+{
+    bx::DefaultAllocator allocator;
+
+    static uint8_t s_src[kWidth * kHeight];
+    static uint8_t s_dst[kWidth * kHeight * 4];
+
+    for (uint32_t ii = 0; ii < BX_COUNTOF(s_formats); ++ii)
+    {
+        const bimg::TextureFormat::Enum format = s_formats[ii];
+        const uint32_t blockSize = bimg::getBlockInfo(format).blockSize;
+
+        fillBlocks(s_src, kWidth * kHeight * blockSize / 16);
+        bimg::imageDecodeToBgra8(&allocator, s_dst, s_src, kWidth, kHeight, kWidth * 4, format);
+
+        const uint8_t *src = s_src;
+        for (uint32_t blockY = 0; blockY < kHeight / 4; ++blockY)
+        {
+            for (uint32_t blockX = 0; blockX < kWidth / 4; ++blockX, src += blockSize)
+            {
+                uint8_t expected[16 * 4];
+                uint8_t mask[16 * 4];
+                refDecodeBlock(expected, mask, src, format);
+
+                for (uint32_t yy = 0; yy < 4; ++yy)
+                {
+                    const uint8_t *dst = &s_dst[(blockY * 4 + yy) * kWidth * 4 + blockX * 16];
+
+                    for (uint32_t jj = 0; jj < 16; ++jj)
+                    {
+                        REQUIRE((expected[yy * 16 + jj] & mask[yy * 16 + jj]) == (dst[jj] & mask[yy * 16 + jj]));
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Image decode on job scheduler matches decode on calling thread")
+{
+    bx::DefaultAllocator allocator;
+
+    const uint32_t width = 256;
+    const uint32_t height = 256;
+
+    static uint8_t s_src[width * height];
+    static uint8_t s_serial[width * height * 4];
+    static uint8_t s_threaded[width * height * 4];
+
+    bimg::JobSchedulerI *jobScheduler = bimg::createJobScheduler(&allocator, 4);
+    REQUIRE(NULL != jobScheduler);
+
+    bool same = true;
+
+    for (uint32_t ii = 0; ii < BX_COUNTOF(s_formats); ++ii)
+    {
+        const bimg::TextureFormat::Enum format = s_formats[ii];
+        const uint32_t blockSize = bimg::getBlockInfo(format).blockSize;
+
+        fillBlocks(s_src, width * height * blockSize / 16);
+
+        bimg::setJobScheduler(NULL);
+        bimg::imageDecodeToBgra8(&allocator, s_serial, s_src, width, height, width * 4, format);
+
+        bimg::setJobScheduler(jobScheduler);
+        bimg::imageDecodeToBgra8(&allocator, s_threaded, s_src, width, height, width * 4, format);
+
+        same = same && 0 == bx::memCmp(s_serial, s_threaded, sizeof(s_serial));
+    }
+
+    bimg::setJobScheduler(NULL);
+    bimg::destroyJobScheduler(jobScheduler);
+
+    REQUIRE(same);
+}
+
+TEST_CASE("Image decode of BC5 to RGBA32F clamps normal z outside of unit circle")
+{
+    bx::DefaultAllocator allocator;
+
+    static uint8_t s_src[kWidth * kHeight];
+    static float s_dst[kWidth * kHeight * 4];
+
+    fillBlocks(s_src, sizeof(s_src));
+    bimg::imageDecodeToRgba32f(&allocator, s_dst, s_src, kWidth, kHeight, 1, kWidth * 16, bimg::TextureFormat::BC5);
+
+    // Compares bits, since library is built with fast math and NaN checks can be optimized out.
+    for (uint32_t ii = 0; ii < kWidth * kHeight; ++ii)
+    {
+        REQUIRE(bx::floatToBits(s_dst[ii * 4 + 2]) <= bx::floatToBits(1.0f));
+    }
+}
@@ -0,0 +1,75 @@
+#include "bench.h"
+
+#include <bgfx/bgfx.h>
+#include <bx/timer.h>
+
+// Allocates memory blocks on API thread and releases them on render thread, the way texture and
+// dynamic buffer updates do. Build with `-Dmemory_pool=false` to compare with plain heap path.
+static void memoryPoolChurn(const char *_name, uint32_t _maxSize)
+{
+    bgfx::Init init;
+    init.type = bgfx::RendererType::Noop;
+    init.resolution.width = 64;
+    init.resolution.height = 64;
+
+    if (!bgfx::init(init))
+    {
+        return;
+    }
+
+    bgfx::DynamicIndexBufferHandle handle = bgfx::createDynamicIndexBuffer(1 << 16);
+
+    static uint8_t s_data[64];
+
+    const uint32_t numFrames = 200;
+    const uint32_t numWarmupFrames = 20;
+    const uint32_t numUpdates = 4000;
+
+    uint32_t numOps = 0;
+    double ns = 0.0;
+
+    for (uint32_t frame = 0; frame < numFrames; ++frame)
+    {
+        const int64_t start = bx::getHPCounter();
+
+        for (uint32_t ii = 0; ii < numUpdates; ++ii)
+        {
+            // Mostly small updates, with occasional large one.
+            const uint32_t range = 0 == ii % 50 ? _maxSize : bx::min<uint32_t>(_maxSize, 2000);
+            const uint32_t size = (16 + ((ii * 2654435761u) >> 7) % range) & ~1u;
+
+            const bgfx::Memory *mem = bgfx::alloc(size);
+            mem->data[0] = 1;
+            bgfx::update(handle, 0, mem);
+
+            if (0 == ii % 3)
+            {
+                bgfx::update(handle, 0, bgfx::makeRef(s_data, sizeof(s_data)));
+            }
+        }
+
+        if (numWarmupFrames <= frame)
+        {
+            ns += bench::elapsedNs(start);
+            numOps += numUpdates + (numUpdates + 2) / 3;
+        }
+
+        bgfx::frame();
+    }
+
+    const bgfx::Stats *stats = bgfx::getStats();
+    bench::report(_name, ns / numOps, "heap allocs %u, cached %u KiB", stats->memoryPoolHeapAllocs, stats->memoryPoolCached / 1024);
+
+    bgfx::destroy(handle);
+    bgfx::shutdown();
+}
+
+BENCHMARK("memory pool churn, alloc+update up to 2 KiB")
+{
+    memoryPoolChurn("memory pool churn, alloc+update up to 2 KiB", 2000);
+}
+
+BENCHMARK("memory pool churn, alloc+update up to 64 KiB")
+{
+    memoryPoolChurn("memory pool churn, alloc+update up to 64 KiB", 60000);
+}
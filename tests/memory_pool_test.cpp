@@ -0,0 +1,159 @@
+#include "bgfx_p.h"
+
+#include <bx/thread.h>
+
+#include "test.h"
+
+TEST_CASE("Memory pool size class fits size and wastes at most quarter of it")
+{
+    for (uint32_t size = 1; size <= BGFX_CONFIG_MEMORY_POOL_MAX_BLOCK_SIZE; ++size)
+    {
+        const uint32_t sizeClass = bgfx::memoryPoolSizeClass(size);
+        const uint32_t classSize = bgfx::memoryPoolClassSize(sizeClass);
+
+        REQUIRE(size <= classSize);
+        REQUIRE(classSize <= bx::max<uint32_t>(64, size + size / 4));
+        REQUIRE(0 == sizeClass || size > bgfx::memoryPoolClassSize(sizeClass - 1));
+    }
+}
+
+TEST_CASE("Memory pool size class round trips through class size")
+{
+    const uint32_t numClasses = bgfx::memoryPoolSizeClass(BGFX_CONFIG_MEMORY_POOL_MAX_BLOCK_SIZE) + 1;
+
+    for (uint32_t sizeClass = 0; sizeClass < numClasses; ++sizeClass)
+    {
+        REQUIRE(sizeClass == bgfx::memoryPoolSizeClass(bgfx::memoryPoolClassSize(sizeClass)));
+        REQUIRE(0 == bgfx::memoryPoolClassSize(sizeClass) % 16);
+    }
+}
+
+#if BGFX_CONFIG_MEMORY_POOL
+namespace
+{
+    bool initNoop()
+    {
+        bgfx::Init init;
+        init.type = bgfx::RendererType::Noop;
+        init.resolution.width = 64;
+        init.resolution.height = 64;
+        return bgfx::init(init);
+    }
+
+    // Memory blocks are released on render thread once frame that references them is consumed.
+    void submit(bgfx::DynamicIndexBufferHandle _handle, const bgfx::Memory *_mem)
+    {
+        bgfx::update(_handle, 0, _mem);
+    }
+
+#if BGFX_CONFIG_MULTITHREADED
+    struct WorkerAlloc
+    {
+        const bgfx::Memory *mem;
+        uint32_t size;
+    };
+
+    int32_t workerAlloc(bx::Thread *_self, void *_userData)
+    {
+        BX_UNUSED(_self);
+        WorkerAlloc *work = (WorkerAlloc *)_userData;
+        work->mem = bgfx::alloc(work->size);
+        return bx::kExitSuccess;
+    }
+#endif // BGFX_CONFIG_MULTITHREADED
+} // namespace
+
+TEST_CASE("Memory pool reuses blocks released by render thread")
+{
+    REQUIRE(initNoop());
+
+    bgfx::DynamicIndexBufferHandle handle = bgfx::createDynamicIndexBuffer(1 << 16);
+
+    uint32_t heapAllocs = 0;
+
+    for (uint32_t frame = 0; frame < 32; ++frame)
+    {
+        for (uint32_t ii = 0; ii < 1024; ++ii)
+        {
+            submit(handle, bgfx::alloc(16 + (ii * 97) % 4000));
+        }
+
+        bgfx::frame();
+
+        if (3 == frame)
+        {
+            heapAllocs = bgfx::getStats()->memoryPoolHeapAllocs;
+        }
+    }
+
+    bgfx::frame();
+
+    const bgfx::Stats *stats = bgfx::getStats();
+    const uint32_t heapAllocsAfter = stats->memoryPoolHeapAllocs;
+    const uint32_t cached = stats->memoryPoolCached;
+
+    bgfx::destroy(handle);
+    bgfx::shutdown();
+
+    // API thread can start next frame before render thread returns its cache to shared pool, so pool
+    // settles at up to two frames worth of blocks. Without pool, every allocation would be from heap.
+    REQUIRE(heapAllocsAfter - heapAllocs <= 2 * 1024);
+    REQUIRE(0 < cached);
+    REQUIRE(cached <= BGFX_CONFIG_MEMORY_POOL_SIZE + (1 << 20));
+}
+
+#if BGFX_CONFIG_MULTITHREADED
+TEST_CASE("Memory pool returns cache of exited thread to shared pool")
+{
+    REQUIRE(initNoop());
+
+    bgfx::DynamicIndexBufferHandle handle = bgfx::createDynamicIndexBuffer(1 << 16);
+
+    const uint32_t size = 1000;
+
+    for (uint32_t frame = 0; frame < 4; ++frame)
+    {
+        for (uint32_t ii = 0; ii < 256; ++ii)
+        {
+            submit(handle, bgfx::alloc(size));
+        }
+
+        bgfx::frame();
+    }
+
+    bgfx::frame();
+    bgfx::frame();
+
+    // Every thread takes batch of blocks into its cache on first allocation. Without returning
+    // cache on exit, these blocks would be stranded and burst that follows would come from heap.
+    const uint32_t heapAllocs = bgfx::getStats()->memoryPoolHeapAllocs;
+
+    for (uint32_t ii = 0; ii < 32; ++ii)
+    {
+        WorkerAlloc work = { NULL, size };
+
+        bx::Thread thread;
+        thread.init(workerAlloc, &work);
+        thread.shutdown();
+
+        submit(handle, work.mem);
+        bgfx::frame();
+    }
+
+    bgfx::frame();
+    bgfx::frame();
+
+    for (uint32_t ii = 0; ii < 192; ++ii)
+    {
+        submit(handle, bgfx::alloc(size));
+    }
+
+    const uint32_t heapAllocsAfter = bgfx::getStats()->memoryPoolHeapAllocs;
+
+    bgfx::destroy(handle);
+    bgfx::shutdown();
+
+    REQUIRE(heapAllocs == heapAllocsAfter);
+}
+#endif // BGFX_CONFIG_MULTITHREADED
+#endif // BGFX_CONFIG_MEMORY_POOL
@@ -0,0 +1,90 @@
+#include "bgfx_p.h"
+
+#include "bench.h"
+
+#include <bx/rng.h>
+#include <bx/timer.h>
+
+// Frees and allocates random blocks of up to 4 KiB in 1 MiB slabs, the way dynamic index and
+// vertex buffers are sub-allocated. With more live blocks free space gets more fragmented.
+static void nonLocalAllocatorChurn(const char *_name, uint32_t _maxLive)
+{
+    const uint32_t numOps = 1000000;
+    const uint32_t slabSize = 1 << 20;
+
+    static uint64_t s_live[64 << 10];
+    BX_ASSERT(_maxLive <= BX_COUNTOF(s_live), "");
+
+    uint64_t *live = s_live;
+    uint32_t nextSlab = 1;
+    uint32_t numSlabs = 0;
+    uint32_t maxSlabs = 0;
+    uint32_t maxFreeBlocks = 0;
+
+    // Allocator keeps its bookkeeping in containers that allocate from bgfx allocator.
+    bgfx::Init init;
+    init.type = bgfx::RendererType::Noop;
+    init.resolution.width = 64;
+    init.resolution.height = 64;
+
+    if (!bgfx::init(init))
+    {
+        return;
+    }
+
+    bgfx::NonLocalAllocator *allocator = BX_NEW(bgfx::g_allocator, bgfx::NonLocalAllocator);
+    bx::RngMwc rng;
+
+    const auto alloc = [&](uint32_t _size) -> uint64_t
+    {
+        uint64_t ptr = allocator->alloc(_size);
+        if (bgfx::NonLocalAllocator::kInvalidBlock == ptr)
+        {
+            allocator->add(uint64_t(nextSlab++) << 32, slabSize);
+            ++numSlabs;
+            ptr = allocator->alloc(_size);
+        }
+
+        return ptr;
+    };
+
+    for (uint32_t ii = 0; ii < _maxLive; ++ii)
+    {
+        live[ii] = alloc(16 + rng.gen() % 4096);
+    }
+
+    const int64_t start = bx::getHPCounter();
+
+    // Steady state, every free is followed by alloc of different size.
+    for (uint32_t ii = 0; ii < numOps; ++ii)
+    {
+        const uint32_t idx = rng.gen() % _maxLive;
+
+        allocator->free(live[idx]);
+
+        while (0 != allocator->removeOrphaned())
+        {
+            --numSlabs;
+        }
+
+        live[idx] = alloc(16 + rng.gen() % 4096);
+
+        maxSlabs = bx::max(maxSlabs, numSlabs);
+        maxFreeBlocks = bx::max(maxFreeBlocks, allocator->getNumFreeBlocks());
+    }
+
+    bench::report(_name, bench::elapsedNs(start) / numOps, "max %u slabs, max %u free blocks", maxSlabs, maxFreeBlocks);
+
+    bx::deleteObject(bgfx::g_allocator, allocator);
+    bgfx::shutdown();
+}
+
+BENCHMARK("NonLocalAllocator churn, 1K live blocks")
+{
+    nonLocalAllocatorChurn("NonLocalAllocator churn, 1K live blocks", 1 << 10);
+}
+
+BENCHMARK("NonLocalAllocator churn, 64K live blocks")
+{
+    nonLocalAllocatorChurn("NonLocalAllocator churn, 64K live blocks", 64 << 10);
+}
@@ -0,0 +1,241 @@
+#include "bgfx_p.h"
+
+#include <bx/rng.h>
+
+#include "test.h"
+
+namespace
+{
+    const uint32_t kSlabSize = 64 << 10;
+    const uint32_t kMaxSlabs = 8;
+    const uint32_t kMaxLive = 128;
+
+    // Allocator keeps its bookkeeping in containers that allocate from bgfx allocator, which is set
+    // up by bgfx::init.
+    struct NoopRenderer
+    {
+        NoopRenderer()
+        {
+            bgfx::Init init;
+            init.type = bgfx::RendererType::Noop;
+            init.resolution.width = 64;
+            init.resolution.height = 64;
+            valid = bgfx::init(init);
+        }
+
+        ~NoopRenderer()
+        {
+            if (valid)
+            {
+                bgfx::shutdown();
+            }
+        }
+
+        bool valid;
+    };
+
+    struct Block
+    {
+        uint64_t ptr;
+        uint32_t size;
+    };
+
+    // Slab index lives in upper 32 bits of block address, so zero is never valid address.
+    uint64_t slabAddress(uint32_t _slab)
+    {
+        return uint64_t(_slab + 1) << 32;
+    }
+
+    uint32_t slabIndex(uint64_t _ptr)
+    {
+        return uint32_t(_ptr >> 32) - 1;
+    }
+
+    // Random alloc/free sequence checked against shadow map of bytes owned by live blocks. Request
+    // sizes are multiples of _granularity, and so must be block offsets within slab.
+    void churn(uint32_t _granularity)
+    {
+        NoopRenderer noop;
+        REQUIRE(noop.valid);
+
+        static uint8_t s_owned[kMaxSlabs][kSlabSize];
+        bx::memSet(s_owned, 0, sizeof(s_owned));
+
+        bool slabUsed[kMaxSlabs] = {};
+        Block live[kMaxLive];
+        uint32_t numLive = 0;
+        uint32_t totalUsed = 0;
+
+        bgfx::NonLocalAllocator allocator;
+        bx::RngMwc rng;
+
+        for (uint32_t ii = 0; ii < 20000; ++ii)
+        {
+            const uint32_t rnd = rng.gen();
+
+            if (0 == numLive || (numLive < kMaxLive && 0 == (rnd & 1)))
+            {
+                const uint32_t size = _granularity * (1 + (rnd >> 1) % (4096 / _granularity));
+
+                uint64_t ptr = allocator.alloc(size);
+                if (bgfx::NonLocalAllocator::kInvalidBlock == ptr)
+                {
+                    uint32_t slab = 0;
+                    while (slab < kMaxSlabs && slabUsed[slab])
+                    {
+                        ++slab;
+                    }
+
+                    REQUIRE(slab < kMaxSlabs);
+
+                    slabUsed[slab] = true;
+                    allocator.add(slabAddress(slab), kSlabSize);
+
+                    ptr = allocator.alloc(size);
+                    REQUIRE(bgfx::NonLocalAllocator::kInvalidBlock != ptr);
+                }
+
+                const uint32_t slab = slabIndex(ptr);
+                const uint32_t offset = uint32_t(ptr);
+                REQUIRE(slab < kMaxSlabs);
+                REQUIRE(slabUsed[slab]);
+                REQUIRE(offset + size <= kSlabSize);
+                REQUIRE(0 == offset % _granularity);
+
+                for (uint32_t jj = 0; jj < size; ++jj)
+                {
+                    REQUIRE(0 == s_owned[slab][offset + jj]);
+                    s_owned[slab][offset + jj] = 1;
+                }
+
+                live[numLive].ptr = ptr;
+                live[numLive].size = size;
+                ++numLive;
+                totalUsed += bx::max<uint32_t>(size, 16);
+            }
+            else
+            {
+                const uint32_t idx = (rnd >> 1) % numLive;
+                const Block block = live[idx];
+                live[idx] = live[--numLive];
+
+                allocator.free(block.ptr);
+                bx::memSet(&s_owned[slabIndex(block.ptr)][uint32_t(block.ptr)], 0, block.size);
+                totalUsed -= bx::max<uint32_t>(block.size, 16);
+
+                // Only slab without live blocks can be reclaimed.
+                for (uint64_t ptr = allocator.removeOrphaned(); 0 != ptr; ptr = allocator.removeOrphaned())
+                {
+                    const uint32_t slab = slabIndex(ptr);
+                    REQUIRE(slab < kMaxSlabs);
+                    REQUIRE(slabUsed[slab]);
+                    REQUIRE(0 == uint32_t(ptr));
+
+                    for (uint32_t jj = 0; jj < numLive; ++jj)
+                    {
+                        REQUIRE(slab != slabIndex(live[jj].ptr));
+                    }
+
+                    slabUsed[slab] = false;
+                }
+            }
+
+            REQUIRE(totalUsed == allocator.getTotalUsed());
+            REQUIRE(allocator.getTotalAvailable() - totalUsed == allocator.getTotalFree());
+            REQUIRE(allocator.getLargestFree() <= allocator.getTotalFree());
+        }
+
+        for (uint32_t ii = 0; ii < numLive; ++ii)
+        {
+            allocator.free(live[ii].ptr);
+        }
+
+        while (0 != allocator.removeOrphaned())
+        {
+        }
+
+        REQUIRE(0 == allocator.getTotalUsed());
+        REQUIRE(0 == allocator.getTotalAvailable());
+        REQUIRE(0 == allocator.getNumFreeBlocks());
+    }
+} // namespace
+
+TEST_CASE("NonLocalAllocator blocks don't overlap and fit requested size")
+{
+    churn(1);
+}
+
+TEST_CASE("NonLocalAllocator keeps block offsets aligned to request granularity")
+{
+    churn(16);
+}
+
+TEST_CASE("NonLocalAllocator coalesces freed blocks back into whole slab")
+{
+    NoopRenderer noop;
+    REQUIRE(noop.valid);
+
+    bgfx::NonLocalAllocator allocator;
+
+    const uint64_t base = slabAddress(0);
+    allocator.add(base, kSlabSize);
+
+    uint64_t ptrs[1024];
+    uint32_t num = 0;
+
+    for (uint64_t ptr = allocator.alloc(48); bgfx::NonLocalAllocator::kInvalidBlock != ptr; ptr = allocator.alloc(16 + num % 7 * 48))
+    {
+        REQUIRE(num < BX_COUNTOF(ptrs));
+        ptrs[num++] = ptr;
+    }
+
+    REQUIRE(0 == allocator.removeOrphaned());
+
+    // Free every other block first, so rest of frees merge with both neighbours.
+    for (uint32_t ii = 0; ii < num; ii += 2)
+    {
+        allocator.free(ptrs[ii]);
+    }
+
+    for (uint32_t ii = 1; ii < num; ii += 2)
+    {
+        allocator.free(ptrs[ii]);
+    }
+
+    REQUIRE(0 == allocator.getTotalUsed());
+    REQUIRE(1 == allocator.getNumFreeBlocks());
+    REQUIRE(kSlabSize == allocator.getLargestFree());
+
+    const uint64_t ptr = allocator.alloc(kSlabSize);
+    REQUIRE(base == ptr);
+    allocator.free(ptr);
+
+    REQUIRE(base == allocator.removeOrphaned());
+    REQUIRE(0 == allocator.removeOrphaned());
+    REQUIRE(0 == allocator.getTotalAvailable());
+    REQUIRE(0 == allocator.getNumFreeBlocks());
+}
+
+TEST_CASE("NonLocalAllocator fails request larger than largest free block")
+{
+    NoopRenderer noop;
+    REQUIRE(noop.valid);
+
+    bgfx::NonLocalAllocator allocator;
+    allocator.add(slabAddress(0), 4096);
+    allocator.add(slabAddress(1), 4096);
+
+    REQUIRE(bgfx::NonLocalAllocator::kInvalidBlock == allocator.alloc(4097));
+
+    const uint64_t ptr0 = allocator.alloc(4096);
+    const uint64_t ptr1 = allocator.alloc(4096);
+    REQUIRE(bgfx::NonLocalAllocator::kInvalidBlock != ptr0);
+    REQUIRE(bgfx::NonLocalAllocator::kInvalidBlock != ptr1);
+    REQUIRE(ptr0 != ptr1);
+    REQUIRE(bgfx::NonLocalAllocator::kInvalidBlock == allocator.alloc(1));
+
+    allocator.free(ptr0);
+    allocator.free(ptr1);
+    REQUIRE(2 == allocator.getNumFreeBlocks());
+    REQUIRE(0 == allocator.getTotalUsed());
+}
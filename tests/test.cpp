@@ -0,0 +1,49 @@
+#include "test.h"
+
+#include <stdio.h>
+
+namespace test
+{
+    static TestCase *s_testCases = NULL;
+    static uint32_t s_numFailed = 0;
+
+    TestCase::TestCase(const char *_name, TestFn _fn)
+        : name(_name)
+        , fn(_fn)
+        , next(s_testCases)
+    {
+        s_testCases = this;
+    }
+
+    void fail(const char *_filePath, uint32_t _line, const char *_expr)
+    {
+        printf("%s(%d): REQUIRE(%s) failed.\n", _filePath, _line, _expr);
+        ++s_numFailed;
+    }
+
+} // namespace test
+
+int main(int _argc, const char *_argv[])
+{
+    BX_UNUSED(_argc, _argv);
+
+    uint32_t numTests = 0;
+    uint32_t numFailedTests = 0;
+
+    for (test::TestCase *testCase = test::s_testCases; NULL != testCase; testCase = testCase->next)
+    {
+        const uint32_t numFailed = test::s_numFailed;
+        testCase->fn();
+
+        ++numTests;
+        if (numFailed != test::s_numFailed)
+        {
+            printf("FAILED: %s\n", testCase->name);
+            ++numFailedTests;
+        }
+    }
+
+    printf("%d of %d tests passed.\n", numTests - numFailedTests, numTests);
+
+    return 0 == numFailedTests ? bx::kExitSuccess : bx::kExitFailure;
+}
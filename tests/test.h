@@ -0,0 +1,39 @@
+#pragma once
+
+#include <bx/bx.h>
+#include <bx/macros.h>
+
+// Minimal test harness for C++ tests of bgfx and bimg internals that Zig tests can't reach. Test
+// cases register themselves at static initialization, `zig build test` runs all of them.
+namespace test
+{
+    typedef void (*TestFn)();
+
+    struct TestCase
+    {
+        TestCase(const char *_name, TestFn _fn);
+
+        const char *name;
+        TestFn fn;
+        TestCase *next;
+    };
+
+    void fail(const char *_filePath, uint32_t _line, const char *_expr);
+
+} // namespace test
+
+#define TEST_CASE_IMPL(_fn, _name)                               \
+    static void _fn();                                           \
+    static test::TestCase BX_CONCATENATE(_fn, Case)(_name, _fn); \
+    static void _fn()
+
+#define TEST_CASE(_name) TEST_CASE_IMPL(BX_CONCATENATE(testCase, __LINE__), _name)
+
+#define REQUIRE(_expr)                                  \
+    BX_MACRO_BLOCK_BEGIN                                \
+        if (!(_expr))                                   \
+        {                                               \
+            test::fail(__FILE__, __LINE__, #_expr);     \
+            return;                                     \
+        }                                               \
+    BX_MACRO_BLOCK_END
@@ -0,0 +1,104 @@
+#include "bgfx_p.h"
+
+#include <bx/semaphore.h>
+#include <bx/thread.h>
+
+#include "test.h"
+
+#if BGFX_CONFIG_MULTITHREADED
+namespace
+{
+    struct Worker
+    {
+        bgfx::Encoder *encoder;
+        bx::Semaphore begun;
+        bx::Semaphore resume;
+        bx::Semaphore done;
+        uint32_t offset;
+    };
+
+    uint32_t allocTransient()
+    {
+        bgfx::VertexLayout layout;
+        layout.begin().add(bgfx::Attrib::Position, 4, bgfx::AttribType::Float).end();
+
+        bgfx::TransientVertexBuffer tvb;
+        bgfx::allocTransientVertexBuffer(&tvb, 64, layout);
+
+        return tvb.startVertex * layout.getStride();
+    }
+
+    // Begins encoder and lets other thread end it, then allocates transient buffer.
+    int32_t workerEndedElsewhere(bx::Thread *_self, void *_userData)
+    {
+        BX_UNUSED(_self);
+        Worker *worker = (Worker *)_userData;
+
+        worker->encoder = bgfx::begin();
+        worker->begun.post();
+
+        worker->resume.wait();
+        worker->offset = allocTransient();
+
+        return bx::kExitSuccess;
+    }
+
+    // Begins encoder and allocates transient buffer from its chunk, keeps encoder until resumed.
+    int32_t workerEncoder(bx::Thread *_self, void *_userData)
+    {
+        BX_UNUSED(_self);
+        Worker *worker = (Worker *)_userData;
+
+        worker->encoder = bgfx::begin();
+        worker->offset = allocTransient();
+        worker->begun.post();
+
+        worker->resume.wait();
+        bgfx::end(worker->encoder);
+
+        return bx::kExitSuccess;
+    }
+} // namespace
+
+TEST_CASE("Transient buffer chunk isn't shared with thread whose encoder was ended elsewhere")
+{
+    bgfx::Init init;
+    init.type = bgfx::RendererType::Noop;
+    init.resolution.width = 64;
+    init.resolution.height = 64;
+    REQUIRE(bgfx::init(init));
+
+    Worker stale;
+    stale.encoder = NULL;
+
+    bx::Thread staleThread;
+    staleThread.init(workerEndedElsewhere, &stale);
+    stale.begun.wait();
+    bgfx::end(stale.encoder);
+
+    bgfx::frame();
+
+    // Encoder slot is reused by other thread, which sub-allocates from encoder's chunk.
+    Worker owner;
+    owner.encoder = NULL;
+
+    bx::Thread ownerThread;
+    ownerThread.init(workerEncoder, &owner);
+    owner.begun.wait();
+
+    stale.resume.post();
+    staleThread.shutdown();
+
+    owner.resume.post();
+    ownerThread.shutdown();
+
+    bgfx::frame();
+    bgfx::shutdown();
+
+    REQUIRE(NULL != stale.encoder);
+    REQUIRE(stale.encoder == owner.encoder);
+
+    const uint32_t chunkEnd = owner.offset + bgfx::TransientChunk::kVertexBufferSize;
+    REQUIRE(stale.offset < owner.offset || chunkEnd <= stale.offset);
+}
+#endif // BGFX_CONFIG_MULTITHREADED